@@ -0,0 +1,199 @@
+/*
+file name: BatchIngester.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the BatchIngester class. A BatchIngester builds one concordance from many documents, read on several threads. The documents are numbered from 1 in the order they are listed, and every context carries the number of its document. Each document is read into the word stream as a text of its own, set off by empty words, so no context reaches across the end of a document. The list of documents is split into groups of consecutive documents with about the same number of bytes, and each group is read into its own HashConcordance. The partial concordances are then merged into the target concordance in document order, their word streams appended to the target's one after the other, so each keyword's contexts are in document order, then in the order they appear in the document.
+*/
+
+#include "BatchIngester.h"
+
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <system_error>
+#include "CorpusReader.h"
+#include "TaskRunner.h"
+
+/** Constructor for the BatchIngester class.
+@param threads The number of threads to read the documents on.
+@pre threads must be at least 1. */
+BatchIngester::BatchIngester(int threads) : numThreads(threads)
+{
+}
+
+/**Lists the documents named by files and directories.
+@param paths The names of the files and directories.
+@param documents The vector to store the names of the documents in.
+@param unreadable Set to the name of the first directory that could not be read.
+@return True if every directory could be read, false otherwise.
+@pre none
+@post documents will hold the paths in the order given, with each directory replaced by every regular file below it, in alphabetical order of their names. A path that is not a directory is listed as it is, even if it does not exist. */
+bool BatchIngester::listDocuments(const vector<string>& paths, vector<string>& documents, string& unreadable)
+{
+   documents.clear();
+   for (size_t p = 0; p < paths.size(); p++)
+   {
+      //a file that cannot be opened is reported when it is read
+      error_code error;
+      if ( !filesystem::is_directory(paths[p], error) )
+      {
+         documents.push_back(paths[p]);
+         continue;
+      }
+   
+      //the order the file system lists a directory in varies, so the documents are numbered in name order
+      vector<string> files;
+      filesystem::recursive_directory_iterator entry(paths[p], error);
+      for ( ; !error && entry != filesystem::recursive_directory_iterator(); entry.increment(error) )
+      {
+         if ( entry->is_regular_file(error) )
+            files.push_back(entry->path().string());
+      }
+      if ( error )
+      {
+         unreadable = paths[p];
+         return false;
+      }
+      sort(files.begin(), files.end());
+      documents.insert(documents.end(), files.begin(), files.end());
+   }
+   return true;
+}
+
+/**Adds every word of a list of documents, with its context, to a concordance.
+@param documents The names of the document files.
+@param target The concordance the words are added to.
+@param unreadable Set to the name of the first document that could not be opened.
+@return True if every document was read, false if one could not be opened.
+@pre target must be empty if there is more than one thread, with its stop words already set.
+@post target will contain the same keywords, contexts, and maximum lengths as if each document had been added to it on a single thread, in order, each document a text of its own. Each context will carry the number of its document, counting from 1. */
+template <int BEFORE, int AFTER>
+bool BatchIngester::ingest(const vector<string>& documents, WindowedConcordance<BEFORE, AFTER>& target, string& unreadable) const
+{
+   //one thread reads the documents straight into the target
+   if ( numThreads <= 1 || documents.size() <= 1 )
+   {
+      size_t failed = readDocuments(documents, 0, documents.size(), target);
+      if ( failed == documents.size() )
+         return true;
+      unreadable = documents[failed];
+      return false;
+   }
+   
+   //a few groups per thread, but none smaller than MIN_GROUP_BYTES
+   vector<uint64_t> sizes(documents.size(), 0);
+   uint64_t totalBytes = 0;
+   for (size_t d = 0; d < documents.size(); d++)
+   {
+      //the size only balances the groups, a missing file is reported when it is read
+      error_code error;
+      uintmax_t bytes = filesystem::file_size(documents[d], error);
+      sizes[d] = error ? 0 : (uint64_t)bytes;
+      totalBytes += sizes[d];
+   }
+   size_t numGroups = min((size_t)numThreads * GROUPS_PER_THREAD, (size_t)(totalBytes / MIN_GROUP_BYTES + 1));
+   vector<size_t> groupStarts;
+   splitGroups(sizes, numGroups, groupStarts);
+   
+   //read each group into its own concordance, in parallel
+   deque<HashConcordance<BEFORE, AFTER>> partials(numGroups);
+   vector<size_t> failed(numGroups);
+   TaskRunner::run(numThreads, numGroups, [&](size_t g)
+   {
+      failed[g] = readDocuments(documents, groupStarts[g], groupStarts[g + 1], partials[g]);
+   });
+   
+   //the first document that could not be opened is the one reported
+   for (size_t g = 0; g < numGroups; g++)
+   {
+      if ( failed[g] != groupStarts[g + 1] )
+      {
+         unreadable = documents[failed[g]];
+         return false;
+      }
+   }
+   
+   //give every word a single ID in the target's Vocabulary, the Vocabulary is not thread safe
+   vector<vector<Vocabulary::wordId>> newIds(partials.size());
+   for (size_t g = 0; g < partials.size(); g++)
+      newIds[g] = target.mapVocabulary(partials[g].getVocabulary());
+   
+   //make room for each partial's whole word stream at the end of the target's, in document order,
+   //the empty words around the documents come along
+   uint64_t numWords = 0;
+   for (size_t g = 0; g < partials.size(); g++)
+      numWords += partials[g].getWords().getEnd() - partials[g].getWords().getFirst();
+   target.reserveWords(numWords);
+   vector<int64_t> shifts(partials.size());
+   for (size_t g = 0; g < partials.size(); g++)
+      shifts[g] = target.placeWords(partials[g], partials[g].getWords().getFirst(), partials[g].getWords().getEnd());
+   
+   //the groups fill rooms of their own, so their words are put in the target's IDs in parallel
+   TaskRunner::run(numThreads, partials.size(), [&](size_t g)
+   {
+      const WordStream& groupWords = partials[g].getWords();
+      target.remapWords(partials[g], groupWords.getFirst(), groupWords.getEnd(), shifts[g], newIds[g]);
+   });
+   
+   //move the context lists after the words, in document order, which keeps each keyword's contexts in order
+   for (size_t g = 0; g < partials.size(); g++)
+      partials[g].moveContextsInto(target, shifts[g]);
+   return true;
+}
+
+/**Splits a list of documents into groups of consecutive documents with about the same number of bytes.
+@param sizes The size of each document in bytes.
+@param numGroups The number of groups to split the documents into.
+@param groupStarts The vector to store the index of the first document of each group in, followed by the number of documents.
+@pre numGroups must be at least 1.
+@post Group g will be the documents from groupStarts[g] up to groupStarts[g + 1]. The groups cover the documents in order with no gaps, and some may be empty if a few documents are very large. */
+void BatchIngester::splitGroups(const vector<uint64_t>& sizes, size_t numGroups, vector<size_t>& groupStarts)
+{
+   uint64_t totalBytes = 0;
+   for (size_t d = 0; d < sizes.size(); d++)
+      totalBytes += sizes[d];
+   
+   groupStarts.assign(1, 0);
+   uint64_t bytesTaken = 0;
+   size_t d = 0;
+   for (size_t g = 1; g < numGroups; g++)
+   {
+      //take documents until the groups so far hold their share of the bytes
+      uint64_t share = totalBytes / numGroups * g;
+      while ( d < sizes.size() && bytesTaken < share )
+         bytesTaken += sizes[d++];
+      groupStarts.push_back(d);
+   }
+   groupStarts.push_back(sizes.size());
+}
+
+/**Reads a run of documents into a concordance, one after the other.
+@param documents The names of the document files.
+@param first The index of the first document to read.
+@param last One past the index of the last document to read.
+@param concordance The concordance to add the words to.
+@return The index of the first document that could not be opened, or last if every document was read.
+@pre first must not be greater than last.
+@post The words of each document read will be in the concordance with their contexts and the number of the document, index + 1. */
+template <int BEFORE, int AFTER>
+size_t BatchIngester::readDocuments(const vector<string>& documents, size_t first, size_t last, WindowedConcordance<BEFORE, AFTER>& concordance)
+{
+   CorpusReader reader;
+   for (size_t d = first; d < last; d++)
+   {
+      if ( !reader.open(documents[d]) )
+         return d;
+   
+      //each document is read as a text of its own, so no context reaches into the next one
+      concordance.setDocument((uint32_t)(d + 1));
+      concordance.addCorpus(reader, 1);
+      reader.close();
+   }
+   return last;
+}
+
+//compile the ingestion of every window
+#define INSTANTIATE(BEFORE, AFTER) \
+   template bool BatchIngester::ingest<BEFORE, AFTER>(const vector<string>&, WindowedConcordance<BEFORE, AFTER>&, string&) const;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
@@ -0,0 +1,73 @@
+/*
+file name: BatchIngester.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the BatchIngester class. A BatchIngester builds one concordance from many documents, read on several threads. The documents are numbered from 1 in the order they are listed, and every context carries the number of its document. Each document is read into the word stream as a text of its own, set off by empty words, so no context reaches across the end of a document. The list of documents is split into groups of consecutive documents with about the same number of bytes, and each group is read into its own HashConcordance. The partial concordances are then merged into the target concordance in document order, their word streams appended to the target's one after the other, so each keyword's contexts are in document order, then in the order they appear in the document.
+*/
+
+#ifndef BATCHINGESTER_H
+#define BATCHINGESTER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "HashConcordance.h"
+
+using namespace std;
+
+class BatchIngester
+{
+public:
+   
+   static constexpr uint64_t MIN_GROUP_BYTES = 1 << 20; //groups are at least this large, so a few small documents are not split between threads
+   static constexpr int GROUPS_PER_THREAD = 4; //more groups than threads, so a thread with a slow group does not hold up the rest
+   
+   /** Constructor for the BatchIngester class.
+   @param threads The number of threads to read the documents on.
+   @pre threads must be at least 1. */
+   BatchIngester(int threads);
+   
+   /**Lists the documents named by files and directories.
+   @param paths The names of the files and directories.
+   @param documents The vector to store the names of the documents in.
+   @param unreadable Set to the name of the first directory that could not be read.
+   @return True if every directory could be read, false otherwise.
+   @pre none
+   @post documents will hold the paths in the order given, with each directory replaced by every regular file below it, in alphabetical order of their names. A path that is not a directory is listed as it is, even if it does not exist. */
+   bool static listDocuments(const vector<string>& paths, vector<string>& documents, string& unreadable);
+   
+   /**Adds every word of a list of documents, with its context, to a concordance.
+   @param documents The names of the document files.
+   @param target The concordance the words are added to.
+   @param unreadable Set to the name of the first document that could not be opened.
+   @return True if every document was read, false if one could not be opened.
+   @pre target must be empty if there is more than one thread, with its stop words already set.
+   @post target will contain the same keywords, contexts, and maximum lengths as if each document had been added to it on a single thread, in order, each document a text of its own. Each context will carry the number of its document, counting from 1. */
+   template <int BEFORE, int AFTER>
+   bool ingest(const vector<string>& documents, WindowedConcordance<BEFORE, AFTER>& target, string& unreadable) const;
+   
+private:
+   
+   /**Splits a list of documents into groups of consecutive documents with about the same number of bytes.
+   @param sizes The size of each document in bytes.
+   @param numGroups The number of groups to split the documents into.
+   @param groupStarts The vector to store the index of the first document of each group in, followed by the number of documents.
+   @pre numGroups must be at least 1.
+   @post Group g will be the documents from groupStarts[g] up to groupStarts[g + 1]. The groups cover the documents in order with no gaps, and some may be empty if a few documents are very large. */
+   void static splitGroups(const vector<uint64_t>& sizes, size_t numGroups, vector<size_t>& groupStarts);
+   
+   /**Reads a run of documents into a concordance, one after the other.
+   @param documents The names of the document files.
+   @param first The index of the first document to read.
+   @param last One past the index of the last document to read.
+   @param concordance The concordance to add the words to.
+   @return The index of the first document that could not be opened, or last if every document was read.
+   @pre first must not be greater than last.
+   @post The words of each document read will be in the concordance with their contexts and the number of the document, index + 1. */
+   template <int BEFORE, int AFTER>
+   size_t static readDocuments(const vector<string>& documents, size_t first, size_t last, WindowedConcordance<BEFORE, AFTER>& concordance);
+   
+   int numThreads; //number of threads to read the documents on
+};
+
+#endif
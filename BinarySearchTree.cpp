@@ -2,7 +2,7 @@
 file name: Node.h
 author: Hall, Ashley
 date: 2019-Nov-23
-description: The implementation file for the BinarySearchTree class. The BinarySearchTree class represents a concordance. The tree is composed of TreeNodes representing each word and its list of contexts in the corpus and is indexed alphabetically by the words in the corpus. 
+description: The implementation file for the BinarySearchTree class. The BinarySearchTree class is a Concordance engine that keeps the keywords in alphabetical order as they are added. The tree is composed of TreeNodes representing each word and its list of contexts in the corpus and is indexed alphabetically by the words in the corpus. The tree is kept height-balanced (AVL) so insertion costs O(log n) and the recursion depth stays bounded no matter what order the words arrive in. It is a template over the window of its contexts.
 */
 
 #include "BinarySearchTree.h"
@@ -11,74 +11,106 @@ using namespace std;
 
 /** The default constructor for the BinarySearchTree class.
 Constructs an empty BinarySearchTree object.
-The root is initialized to nullptr, maxPreKeyLen, maxKeyLen, maxPostKeyLen are initialized to 0, and stopWords is initialized to false. */
-BinarySearchTree::BinarySearchTree() : root(nullptr), maxPreKeyLen(0), maxKeyLen(0), maxPostKeyLen(0), stopWords(false)
+The root is initialized to nullptr. */
+template <int BEFORE, int AFTER>
+BinarySearchTree<BEFORE, AFTER>::BinarySearchTree() : WindowedConcordance<BEFORE, AFTER>(), root(nullptr), numKeys(0), numInserts(0), numComparisons(0)
 {
 }
 
 /**The copy constructor for the BinarySearchTree class.
 Makes a deep copy of the binary search tree supplied as the argument.
 @param tree The tree to be copied. */
-BinarySearchTree::BinarySearchTree(const BinarySearchTree& tree)
+template <int BEFORE, int AFTER>
+BinarySearchTree<BEFORE, AFTER>::BinarySearchTree(const BinarySearchTree& tree)
+   : WindowedConcordance<BEFORE, AFTER>(tree), numKeys(tree.numKeys), numInserts(tree.numInserts), numComparisons(tree.numComparisons)
 {
    //calls private method on root pointer of tree to deep copy all nodes
    root = copyTree(tree.root);
-   //set other data members
-   maxPreKeyLen = tree.maxPreKeyLen;
-   maxKeyLen = tree.maxKeyLen;
-   maxPostKeyLen = tree.maxPostKeyLen;
-   stopWords = tree.stopWords;
-   stopWordVector = tree.stopWordVector;
 }
 
 /** The destructor for the BinarySearchTree class.
-Destroys the BinarySearchTree object, freeing the memory allocated for the TreeNodes in the tree when its lifetime ends.*/
-BinarySearchTree::~BinarySearchTree()
+Destroys the BinarySearchTree object when its lifetime ends. The TreeNodes own nothing outside the NodeArena they were created in, so they are not visited: the arena releases them in bulk.*/
+template <int BEFORE, int AFTER>
+BinarySearchTree<BEFORE, AFTER>::~BinarySearchTree()
 {
-   //calls private method on root pointer to recursively delete nodes
-   destroyTree(root);
 }
 
 /** Overloaded assignment operator for the BinarySearchTree class.
  @pre Objects on the left and right side of the operator must BinarySearchTree objects.
  @post The tree on the left side of the operator will be a deep copy of the tree on the right.
  @param rhs The tree on the right side of the assignment operator. */
-BinarySearchTree& BinarySearchTree::operator=(const BinarySearchTree& rhs)
+template <int BEFORE, int AFTER>
+BinarySearchTree<BEFORE, AFTER>& BinarySearchTree<BEFORE, AFTER>::operator=(const BinarySearchTree& rhs)
 {
    //make sure objects aren't the same by comparing addresses
    if ( this != &rhs )
    {
-      //deallocate memory assigned to left hand tree
-      destroyTree(root);
+      //release the left hand tree's nodes in bulk
+      nodeArena.release();
       
       //copy nodes from right hand tree to left hand tree
       root = copyTree(rhs.root);
       
       //copy the rest of the data members
-      maxPreKeyLen = rhs.maxPreKeyLen;
-      maxKeyLen = rhs.maxKeyLen;
-      maxPostKeyLen = rhs.maxPostKeyLen;
-      stopWords = rhs.stopWords;
-      stopWordVector = rhs.stopWordVector;
+      WindowedConcordance<BEFORE, AFTER>::operator=(rhs);
+      numKeys = rhs.numKeys;
+      numInserts = rhs.numInserts;
+      numComparisons = rhs.numComparisons;
    }
    
    //return copy of the right hand side tree
    return *this;
 }
 
+/**The move constructor for the BinarySearchTree class.
+Takes the nodes of the tree supplied as the argument without copying them.
+@param tree The tree to be moved. It may only be destroyed or assigned to afterwards. */
+template <int BEFORE, int AFTER>
+BinarySearchTree<BEFORE, AFTER>::BinarySearchTree(BinarySearchTree&& tree)
+   : WindowedConcordance<BEFORE, AFTER>(move(tree)), root(tree.root), numKeys(tree.numKeys), numInserts(tree.numInserts), numComparisons(tree.numComparisons)
+{
+   tree.root = nullptr;
+}
+
+/** Overloaded move assignment operator for the BinarySearchTree class.
+ @pre Objects on the left and right side of the operator must BinarySearchTree objects.
+ @post The tree on the left side of the operator will hold the nodes of the tree on the right, which may only be destroyed or assigned to afterwards. The nodes that were in the left tree are destroyed.
+ @param rhs The tree on the right side of the assignment operator. */
+template <int BEFORE, int AFTER>
+BinarySearchTree<BEFORE, AFTER>& BinarySearchTree<BEFORE, AFTER>::operator=(BinarySearchTree&& rhs)
+{
+   if ( this != &rhs )
+   {
+      //release the left hand tree's nodes in bulk
+      nodeArena.release();
+      
+      //take the right hand tree's nodes along with the arena blocks they live in
+      WindowedConcordance<BEFORE, AFTER>::operator=(move(rhs));
+      root = rhs.root;
+      rhs.root = nullptr;
+      numKeys = rhs.numKeys;
+      numInserts = rhs.numInserts;
+      numComparisons = rhs.numComparisons;
+   }
+   return *this;
+}
+
 /** Creates a deep copy for each node in a binary search tree using a recursive preorder traversal.
  @param origTreePtr The TreeNode pointer to the root of the original tree.
  @return The TreeNode pointer to the root of the copied tree.
  @pre origTreePtr must be a pointer to a TreeNode
  @post All nodes in the original tree will be deep copied and the pointer to the root node of the copied tree will be returned.*/
-TreeNode* BinarySearchTree::copyTree(const TreeNode* origTreePtr) const
+template <int BEFORE, int AFTER>
+TreeNode* BinarySearchTree<BEFORE, AFTER>::copyTree(const TreeNode* origTreePtr)
 {
    //original tree is empty, return nullptr
    TreeNode* copiedTreePtr = nullptr;
    if ( origTreePtr != nullptr )
    {
-      //create a copy of the parent node in the original tree
-      copiedTreePtr = new TreeNode(origTreePtr->getKey(), origTreePtr->getContextList());
+      //create a copy of the parent node in the original tree, with its keyword and contexts copied into this tree's arena
+      copiedTreePtr = nodeArena.template create<TreeNode>(origTreePtr->getKey(), nodeArena);
+      copiedTreePtr->getContextList().addAll(origTreePtr->getContextList());
+      copiedTreePtr->setHeight(origTreePtr->getHeight());
       //recursively traverse the left subtree
       copiedTreePtr->setLeftChild(copyTree(origTreePtr->getLeftChild()));
       //recursively traverse the right subtree
@@ -88,308 +120,292 @@ TreeNode* BinarySearchTree::copyTree(const TreeNode* origTreePtr) const
    return copiedTreePtr;
 }
 
-/** Deletes each node in the tree using a recursive postorder traversal.
- @param treePtr The pointer to the root of the tree or subtree.
- @pre treePtr must be a pointer to a TreeNode object.
- @post Each node in the tree or subtree will be deleted. */
-void BinarySearchTree::destroyTree(TreeNode* treePtr)
+/**Finds the context list of a keyword, adding a new TreeNode with an empty context list for the keyword first if it is not in the tree yet.
+@param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+@return The keyword's context list.
+@pre The keyword must not be a stop word.
+@post The keyword will be in the tree. The tree will remain balanced. */
+template <int BEFORE, int AFTER>
+ContextList& BinarySearchTree<BEFORE, AFTER>::findOrInsert(const string& keyWord)
 {
-   //tree contains nodes to be deleted
-   if ( treePtr != nullptr )
-   {
-      //recursively traverse and delete nodes the left subtree
-      destroyTree(treePtr->getLeftChild());
-      //recursively traverse and delete nodes the right subtree
-      destroyTree(treePtr->getRightChild());
-      //delete the parent node
-      delete treePtr;
-      //set pointer to nullptr
-      treePtr = nullptr;
-   }
-}
-
-/**Sets the boolean value stopWords and fills the stopword vector with stopwords.
- @param stopWordFile The file to read the stop words from.
- @return True if the file exists, was read from, and populated the stopword vector with at least 1 string. False otherwise.
- @pre The stopWordFile must be of type string.
- @post If a stopword file exists, could be read from, and contains at least 1 string. The size of the stopword vector will be greater than 0, the vector will be filled with the string(s) in the stop word file, the boolean value stopWords will be set to true, and true will be returned. If the file does not exist, could not be read from, or does not contain at least 1 string, the stopword vector will have size 0, stopWords will be set to false, and false will be returned. */
-bool BinarySearchTree::excludeStopWords(const string& stopWordFile)
-{
-   //if stopwords file doesn't exist, couldn't be read from, or does not
-   //contain strings, set boolean value stopWords to false
-   stopWords = buildStopWordVector(stopWordFile);
-   return stopWords;
-}
-
-/**Adds a new TreeNode containing the keyword and the context, or updates the context list with the new context if the TreeNode containing the keyword already exists.
- @param keyWord A keyword from the corpus.
- @param newContext New context to be added.
- @return True if the new TreeNode could be added to the binary search tree or the TreeNode containing the keyword already exists and the context list was updated. False otherwise
- @pre The keyword must be of type string and the context to be added must be of type ListNode::contextArr.
- @post If the addition was successful, a new TreeNode containing the keyword and the context given will be added to the tree. Or if a TreeNode containing the keyword already exists the context list will be updated with the new context. If the new context contains the longest pre-key context, post-key context, and/or keyword, the maximum lengths for these values will be updated.*/
-bool BinarySearchTree::add(string& keyWord, const ListNode::contextArr& newContext)
-{
-   //before adding keyword to tree, strip it of punctuation and make lowercase
-   removePunctAndLower(keyWord);
-   
-   //if no stop words are excluded, insert TreeNode into binary tree
-   if ( !stopWords )
-      root = insert(root, keyWord, newContext);
-   
-   //stop words are excluded so check if keyword is a stop word
-   //if not a stopward, insert TreeNode into binary tree
-   else if ( stopWords && !isStopWord(keyWord) )
-      root = insert(root, keyWord, newContext);
-   
-   //updates max lengths for the pre-key context, key, and post-key context
-   setMaxLengths(newContext);
-   
-   //TreeNode was successfully added or updated with new context
-   return true;
+   TreeNode* keyNode = nullptr;
+   numInserts++;
+   root = insert(root, keyWord, keyNode);
+   return keyNode->getContextList();
 }
 
 /**Inserts a new TreeNode into the binary tree into the appropriate location based on the given keyword.
 @param treePtr The TreeNode pointer pointing to the root node of the tree.
 @param keyWord A keyword from the corpus.
-@param context New context to be added.
+@param keyNode Set to the TreeNode containing the keyword.
 @return Returns the root pointer to the binary search tree after the TreeNode has been added to the appropriate location.
-@pre The keyword must be of type string and the context to be added must be of type ListNode::contextArr.
-@post A new TreeNode containing the keyword will be added to the tree in the appropriate location based on the keyword, and a new ContextList object will be created for the given context. Or if a TreeNode containing the keyword already exists the new context will be added to the end of the context list stored in the TreeNode. After insertion, the pointer to the root node of the tree will be returned.*/
-TreeNode* BinarySearchTree::insert(TreeNode* treePtr, const string& keyWord, const ListNode::contextArr& context)
+@pre The keyword must be of type string.
+@post A new TreeNode containing the keyword and an empty ContextList will be added to the tree in the appropriate location based on the keyword, unless a TreeNode containing the keyword already exists. keyNode will point to the TreeNode containing the keyword. After insertion, the subtree will be rebalanced and the pointer to its root node will be returned.*/
+template <int BEFORE, int AFTER>
+TreeNode* BinarySearchTree<BEFORE, AFTER>::insert(TreeNode* treePtr, const string& keyWord, TreeNode*& keyNode)
 {
    //tree is empty or subtree has no children
    if ( treePtr == nullptr )
    {
-      //create a new context list and add the given context
-      ContextList newList;
-      newList.add(context);
-      
-      //create a new TreeNode with the given keyword and new context list created
-      TreeNode* newNodePtr = new TreeNode(keyWord, newList, nullptr, nullptr);
+      //create a new TreeNode in the arena with a copy of the given keyword and an empty context list
+      TreeNode* newNodePtr = nodeArena.template create<TreeNode>(keyWord, nodeArena);
+      numKeys++;
       
       //set treePtr to the new node created
       treePtr = newNodePtr;
+      keyNode = newNodePtr;
       
       //return the TreeNode's pointer
       return treePtr;
    }
+   
+   //compare once and branch on the result
+   int comparison = keyWord.compare(treePtr->getKey());
+   numComparisons++;
+   
    //keyword to be inserted is less than current TreeNode's keyword
-   else if ( keyWord < treePtr->getKey() )
+   if ( comparison < 0 )
    {
       //insert new TreeNode into left subtree
-      treePtr->setLeftChild( insert(treePtr->getLeftChild(), keyWord, context) );
+      treePtr->setLeftChild( insert(treePtr->getLeftChild(), keyWord, keyNode) );
    }
    //a TreeNode containing the keyword is already in the tree
-   else if (keyWord == treePtr->getKey() )
+   else if ( comparison == 0 )
    {
-      //add the new context array to the context list
-      treePtr->updateContextList(context);
+      //the shape of the tree is unchanged
+      keyNode = treePtr;
+      return treePtr;
    }
    //keyWord to be inserted is greater than current TreeNode's keyWord
    //insert into the right subtree
    else
-      treePtr->setRightChild( insert(treePtr->getRightChild(), keyWord, context) );
-   return treePtr;
+      treePtr->setRightChild( insert(treePtr->getRightChild(), keyWord, keyNode) );
+   
+   //a node was added below this one, restore the balance on the way back up
+   return rebalance(treePtr);
    
 }
 
-/** Performs a recursive inorder traversal of the binary search tree and prints a formatted context list after visiting each node. Private method.
-@param treePtr The TreeNode pointer pointing to the root node of the tree or subtree.
-@pre treePtr must be a pointer to a TreeNode object.
-@post The context list for each node in the binary search tree will be printed to cout in alphabetical order based on the key in each TreeNode. If the tree is empty, nothing will be printed to cout.*/
-void BinarySearchTree::inorder(TreeNode* treePtr) const
+/**Returns the height of a subtree.
+@param treePtr The TreeNode pointer pointing to the root of the subtree.
+@return The height of the subtree, or 0 if the subtree is empty.
+@pre treePtr must be a pointer to a TreeNode object or nullptr.
+@post The height of the subtree will be returned. */
+template <int BEFORE, int AFTER>
+int BinarySearchTree<BEFORE, AFTER>::height(const TreeNode* treePtr)
 {
-   //if tree is not empty
-   if ( treePtr != nullptr )
-   {
-      //recursively traverse the left subtree
-      inorder(treePtr->getLeftChild());
-      
-      //print the context list of the tree's root
-      ( treePtr->getContextList() ).printFormatted(maxPreKeyLen, maxKeyLen, maxPostKeyLen);
-      
-      //recursively traverse the right subtree
-      inorder(treePtr->getRightChild());
-   }
+   return treePtr == nullptr ? 0 : treePtr->getHeight();
 }
 
-/** Performs a recursive inorder traversal of the binary search tree and prints a formatted context list after visiting each node. Public method.
- @pre None.
-@post The context list for each node in the binary search tree will be printed to cout in alphabetical order based on the key in each TreeNode. If the tree is empty, nothing will be printed to cout.*/
-void BinarySearchTree::printConcordance() const
+/**Recomputes the height of a TreeNode from the heights of its children.
+@param treePtr The TreeNode pointer whose height is updated.
+@pre treePtr must point to a TreeNode whose children have correct heights.
+@post The height stored in the TreeNode will be one more than the height of its taller child. */
+template <int BEFORE, int AFTER>
+void BinarySearchTree<BEFORE, AFTER>::updateHeight(TreeNode* treePtr)
 {
-   inorder(root);
+   int leftHeight = height(treePtr->getLeftChild());
+   int rightHeight = height(treePtr->getRightChild());
+   treePtr->setHeight(1 + (leftHeight > rightHeight ? leftHeight : rightHeight));
 }
 
-
-/** Tests whether binary tree is empty.
-@return True if the binary tree is empty, false otherwise.
-@pre none
-@post Returns true if the binary tree is empty, false otherwise.*/
-bool BinarySearchTree::isEmpty() const
+/**Rotates a subtree to the left, making the right child the new root of the subtree.
+@param treePtr The TreeNode pointer pointing to the root of the subtree.
+@return The TreeNode pointer to the new root of the subtree.
+@pre treePtr and its right child must not be nullptr.
+@post The subtree will be rotated left, and the heights of the two rotated nodes will be updated. */
+template <int BEFORE, int AFTER>
+TreeNode* BinarySearchTree<BEFORE, AFTER>::rotateLeft(TreeNode* treePtr)
 {
-   return root == nullptr;
+   //the right child becomes the root of the subtree
+   TreeNode* newRoot = treePtr->getRightChild();
+   
+   //the new root's left subtree moves under the old root
+   treePtr->setRightChild(newRoot->getLeftChild());
+   newRoot->setLeftChild(treePtr);
+   
+   //old root is now the lower node, update its height first
+   updateHeight(treePtr);
+   updateHeight(newRoot);
+   return newRoot;
 }
 
-/** Updates the maximum lengths of the pre-key context length, the key length, and the post-key context length.
-@param context The array of context words.
-@pre The context must be of type ListNode::contextArr
-@post If any of the lengths in the given array are greater than the current maximum lengths, the maximum length(s) will be updated with the appropriate length(s) in the given array. If no lengths in the array are greater, the maximum lengths will remain the same.
- */
-void BinarySearchTree::setMaxLengths(const ListNode::contextArr& context)
+/**Rotates a subtree to the right, making the left child the new root of the subtree.
+@param treePtr The TreeNode pointer pointing to the root of the subtree.
+@return The TreeNode pointer to the new root of the subtree.
+@pre treePtr and its left child must not be nullptr.
+@post The subtree will be rotated right, and the heights of the two rotated nodes will be updated. */
+template <int BEFORE, int AFTER>
+TreeNode* BinarySearchTree<BEFORE, AFTER>::rotateRight(TreeNode* treePtr)
 {
-   int preKeyLen = 0;
-   int keyLen = (int)context.at(5).length();
-   int postKeyLen = 0;
-   
-   //pre-key context words are in index 0-4
-   //finds total length of all pre-key context words in given array
-   for (int i = 0; i < 5; i++)
-      preKeyLen += (int)context.at(i).length();
+   //the left child becomes the root of the subtree
+   TreeNode* newRoot = treePtr->getLeftChild();
    
-   //post-key context words are in index 6-10
-   //finds the total length of all post-key context words in the given array
-   for (int i = 6; i < 11; i++)
-      postKeyLen += (int)(context.at(i).length());
-   
-   //if any of the lengths in the given array are greater than the current max lengths
-   //update max lengths
-   maxPreKeyLen = preKeyLen > maxPreKeyLen ? preKeyLen : maxPreKeyLen;
-   maxKeyLen = keyLen > maxKeyLen ? keyLen : maxKeyLen;
-   maxPostKeyLen = postKeyLen > maxPostKeyLen ? postKeyLen : maxPostKeyLen;
+   //the new root's right subtree moves under the old root
+   treePtr->setLeftChild(newRoot->getRightChild());
+   newRoot->setRightChild(treePtr);
    
+   //old root is now the lower node, update its height first
+   updateHeight(treePtr);
+   updateHeight(newRoot);
+   return newRoot;
 }
 
-/**Builds a vector containing the stop words.
- @param stopWordFile The name of the file containing the stop words.
- @return True if the file exists, could be opened, and the vector was filled with at least one string. False if the file does not exist, could not be opened, or the file contained not strings.
- @pre The stopword file must be located in the same directory as the executable. The argument must be of type string.
- @post If the stopword file exists and could be read, the stopWordVector will be filled with the stop words in the file. If the file does not contain strings, the vector will remain empty and false will be returned. If the file does not exist or could not be opened, the vector will remain empty and false will be returned.
- */
-bool BinarySearchTree::buildStopWordVector(const string& stopWordFile)
+/**Restores the AVL balance of a subtree after an insertion into one of its children.
+@param treePtr The TreeNode pointer pointing to the root of the subtree.
+@return The TreeNode pointer to the root of the balanced subtree.
+@pre treePtr must not be nullptr and its children must be balanced AVL subtrees whose heights differ by at most 2.
+@post The heights of the child subtrees will differ by at most 1 and the height of the root will be updated. */
+template <int BEFORE, int AFTER>
+TreeNode* BinarySearchTree<BEFORE, AFTER>::rebalance(TreeNode* treePtr)
 {
-   ifstream fileReader(stopWordFile);
+   updateHeight(treePtr);
+   int balance = height(treePtr->getLeftChild()) - height(treePtr->getRightChild());
    
-   //cannot open file
-   if ( !fileReader.is_open() )
+   //left subtree is too tall
+   if ( balance > 1 )
    {
-      return false;
+      //left-right case, turn it into a left-left case first
+      if ( height(treePtr->getLeftChild()->getLeftChild()) < height(treePtr->getLeftChild()->getRightChild()) )
+         treePtr->setLeftChild( rotateLeft(treePtr->getLeftChild()) );
+      return rotateRight(treePtr);
    }
-   //the stopword to be read from the file
-   string stopWord;
-   
-   //continue reading until end of file
-   while ( !fileReader.eof() )
+   //right subtree is too tall
+   else if ( balance < -1 )
    {
-      //read each stopword in the file
-      if ( fileReader >> stopWord )
-      {
-         //strip stopword of punctuation and make lowercase
-         removePunctAndLower(stopWord);
-         
-         //add stopword to vector
-         stopWordVector.push_back(stopWord);
-      }
+      //right-left case, turn it into a right-right case first
+      if ( height(treePtr->getRightChild()->getRightChild()) < height(treePtr->getRightChild()->getLeftChild()) )
+         treePtr->setRightChild( rotateRight(treePtr->getRightChild()) );
+      return rotateLeft(treePtr);
    }
    
-   //the vector is empty, no strings in the stopword file
-   if ( stopWordVector.size() == 0 )
-      return false;
-   else
-      return true;
+   //subtree is already balanced
+   return treePtr;
 }
 
-/**Strips a word of punctuation and makes it lowercase.
- @param word The word to be reformatted.
- @pre The word must be of type string.
- @post The word will be stripped of punctuation and be lowercase.
- */
-void BinarySearchTree::removePunctAndLower(string& word)
+/** Collects the context list of each node in alphabetical order with a TreeIterator.
+@param lists The vector to store the context lists in.
+@pre none
+@post lists will hold the context list of each node in the binary search tree in alphabetical order based on the key in each TreeNode.*/
+template <int BEFORE, int AFTER>
+void BinarySearchTree<BEFORE, AFTER>::sortedLists(vector<const ContextList*>& lists) const
 {
-   int length = (int)word.length();
-   //iterate through the word
-   for ( int i = 0; i < length; i++ )
-   {
-      //if a character in the word is a punctuation symbol
-      if ( ispunct(word[i]) )
-         //erase punct from the word, decrement i
-         word.erase(i--, 1);
-   }
-   //set the word to lowercase
-   transform(word.begin(), word.end(), word.begin(), ::tolower);
+   lists.clear();
+   for (TreeIterator<BEFORE, AFTER> keys = begin(); keys != end(); keys.nextKey())
+      lists.push_back(&keys.getContextList());
 }
 
-/**Shifts words in the context array 1 index to the left. After shifting, the element at array index 10 will contain an empty string.
-@param arr The context array.
-@pre The array must be of type ListNode::contextArr.
-@post Words in indices 1-10 will be shifted 1 index to the left. The element at index 10 will be an empty string.
- */
-void BinarySearchTree::shiftArray(ListNode::contextArr& arr)
+/** Collects the context lists of the keywords a query matches with a TreeIterator that skips the subtrees holding no matches.
+@param query The keywords to collect.
+@param lists The vector to store the context lists in.
+@pre none
+@post lists will hold the context list of each matching node in alphabetical order based on the key in each TreeNode. Only the paths to the first and last match and the matching nodes are visited, so it takes O(log n + matches).*/
+template <int BEFORE, int AFTER>
+void BinarySearchTree<BEFORE, AFTER>::matchingLists(const KeyQuery& query, vector<const ContextList*>& lists) const
 {
-   //iterate through the context array
-   for (int i = 1; i < 11; i++)
-      //shift elements 1 to the left
-      arr.at(i - 1) = arr.at(i);
-   //set element at index 10 to an empty string
-   arr.at(10) = "";
+   lists.clear();
+   for (TreeIterator<BEFORE, AFTER> keys = beginMatches(query); keys != end(); keys.nextKey())
+      lists.push_back(&keys.getContextList());
 }
 
-/**Fills the context array with words from the corpus starting at index 5.
- @param word The word to be inserted into the array.
- @param arr The context array to insert the word into.
- @param wordCount The number of words that have been iterated through in the corpus text.
- @pre The arguments for the word, array, and index must be of type  string, ListNode::contextArr, and int, respectively.
- @post The context array will be filled with the word given starting at index 5-9 when wordCount is 0-4. When wordCount is >=5 the array will be filled at index 10 with the given word.
- */
-void BinarySearchTree::fillContextArray(string& word, ListNode::contextArr& arr, int& wordCount)
+/** Starts a TreeWalk over the keywords a query matches, in alphabetical order.
+@param query The keywords to visit, or nullptr to visit every keyword.
+@return A new TreeWalk at the first matching keyword, which the caller must delete.
+@pre The tree must not be changed, and the query must not be destroyed, while the walk is used.
+@post The walk will hold the path down to its keyword, no longer than the height of the tree. */
+template <int BEFORE, int AFTER>
+KeyWalk* BinarySearchTree<BEFORE, AFTER>::walkKeys(const KeyQuery* query) const
 {
-   //do not allow negative integers for wordCount
-   if ( wordCount < 0)
-      return;
-   //for the first 5 words
-   else if (wordCount < 5 )
+   return new TreeWalk(root, query);
+}
+
+/** Writes the rows of every keyword in alphabetical order, pulled one at a time from a TreeIterator.
+@param writer The OutputWriter to write the rows to, with its columns set.
+@param threads The number of threads to format the rows on.
+@pre threads must be at least 1.
+@post The rows of every keyword will be written in alphabetical order, and in corpus order within a keyword. One thread formats the rows straight from the iterator, more than one split the rows into ranges as every concordance does. */
+template <int BEFORE, int AFTER>
+void BinarySearchTree<BEFORE, AFTER>::writeRows(OutputWriter& writer, int threads) const
+{
+   //the ranges are cut from the whole list of context lists
+   if ( threads > 1 )
    {
-      //start filling at indices 5-9
-      arr.at( wordCount + 5 ) = word;
+      WindowedConcordance<BEFORE, AFTER>::writeRows(writer, threads);
+      return;
    }
-   //for subsequent words, fill only index 10
-   else
-      arr.at(10) = word;
+   
+   for (TreeIterator<BEFORE, AFTER> rows = begin(); rows != end(); ++rows)
+      writer.writeRow<BEFORE, AFTER>(rows->context, vocabulary, rows->document);
+}
+
+/** Writes the rows of the keywords a query matches in alphabetical order, pulled one at a time from a TreeIterator.
+@param writer The OutputWriter to write the rows to, with its columns set.
+@param query The keywords to write.
+@pre none
+@post The rows of every matching keyword will be written in alphabetical order, and in corpus order within a keyword. */
+template <int BEFORE, int AFTER>
+void BinarySearchTree<BEFORE, AFTER>::writeMatchingRows(OutputWriter& writer, const KeyQuery& query) const
+{
+   for (TreeIterator<BEFORE, AFTER> rows = beginMatches(query); rows != end(); ++rows)
+      writer.writeRow<BEFORE, AFTER>(rows->context, vocabulary, rows->document);
 }
 
-/**Checks if a lone character in the corpus is a punctuation symbol.
- @param word The word to be checked.
- @return True will be returned if the word is a punctuation symbol. False otherwise.
- @pre The word must be of type string.
- @post True will be returned if the word is a punctuation symbol. False otherwise.
- */
-bool BinarySearchTree::isPunct(string& word)
+/**Returns an iterator at the first row of the tree.
+@return An iterator over the rows in alphabetical order based on the keyword, and in corpus order within a keyword.
+@pre The tree must not be changed while the iterator is used.
+@post The iterator will be at the first context of the first keyword, or equal to end() if the tree is empty. Only the path to the first keyword is visited. */
+template <int BEFORE, int AFTER>
+TreeIterator<BEFORE, AFTER> BinarySearchTree<BEFORE, AFTER>::begin() const
 {
-   return (word.length() == 1 && ispunct(word[0]));
+   return TreeIterator<BEFORE, AFTER>(root, &words);
 }
 
+/**Returns an iterator past the last row of the tree.
+@return The iterator every other iterator of the tree is equal to once it has passed its last row.
+@pre none
+@post An iterator past the last row will be returned. */
+template <int BEFORE, int AFTER>
+TreeIterator<BEFORE, AFTER> BinarySearchTree<BEFORE, AFTER>::end() const
+{
+   return TreeIterator<BEFORE, AFTER>();
+}
 
-/** Checks if the given word is a word in the stopword vector.
- @param word The word to be checked.
- @return True if the word is a stopword, false otherwise.
- @pre The word must be of type string.
- @post True will be returned if the word found in the stopword vector, otherwise false will be returned.
- */
-bool BinarySearchTree::isStopWord(string& word)
+/**Returns an iterator at the first row of the keywords a query matches.
+@param query The keywords to visit.
+@return An iterator over the rows of the matching keywords in alphabetical order, and in corpus order within a keyword.
+@pre The tree must not be changed, and the query must not be destroyed, while the iterator is used.
+@post The iterator will be at the first context of the first matching keyword, or equal to end() if nothing matches. Subtrees holding no matches are never visited. */
+template <int BEFORE, int AFTER>
+TreeIterator<BEFORE, AFTER> BinarySearchTree<BEFORE, AFTER>::beginMatches(const KeyQuery& query) const
 {
-   //initialize iterators to the start and end of the stopword vector
-   vector<string>::iterator itr = stopWordVector.begin();
-   vector<string>::iterator end = stopWordVector.end();
-   
-   bool isStop = false;
-   
-   //iterate through vector
-   while ( itr != end )
-   {
-      //if word given equals a word in the vector, set
-      //isStop to true
-      if ( word == *(itr++) )
-         isStop = true;
-   }
-   return isStop;
+   return TreeIterator<BEFORE, AFTER>(root, &words, &query);
 }
+
+/** Tests whether binary tree is empty.
+@return True if the binary tree is empty, false otherwise.
+@pre none
+@post Returns true if the binary tree is empty, false otherwise.*/
+template <int BEFORE, int AFTER>
+bool BinarySearchTree<BEFORE, AFTER>::isEmpty() const
+{
+   return root == nullptr;
+}
+
+/**Adds the counters of the tree to a report.
+@param runStats The RunStats the counters are set in.
+@pre none
+@post The report will hold the counters of every concordance, the number of keywords in the tree, its height, and the number of keyword comparisons made by insertions and their average. */
+template <int BEFORE, int AFTER>
+void BinarySearchTree<BEFORE, AFTER>::collectStats(RunStats& runStats) const
+{
+   Concordance::collectStats(runStats);
+   runStats.setCounter("distinct_keys", (double)numKeys);
+   runStats.setCounter("tree_height", (double)height(root));
+   runStats.setCounter("key_comparisons", (double)numComparisons);
+   runStats.setCounter("comparisons_per_insert", numInserts == 0 ? 0 : (double)numComparisons / (double)numInserts);
+}
+
+//compile the BinarySearchTree of every window
+#define INSTANTIATE(BEFORE, AFTER) template class BinarySearchTree<BEFORE, AFTER>;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
@@ -2,25 +2,25 @@
 file name: Node.h
 author: Hall, Ashley
 date: 2019-Nov-23
-description: The header file for the BinarySearchTree class. The BinarySearchTree class represents a concordance. The tree is composed of TreeNodes representing each word and its list of contexts in the corpus and is indexed alphabetically by the words in the corpus. 
+description: The header file for the BinarySearchTree class. The BinarySearchTree class is a Concordance engine that keeps the keywords in alphabetical order as they are added. The tree is composed of TreeNodes representing each word and its list of contexts in the corpus and is indexed alphabetically by the words in the corpus. The tree is kept height-balanced (AVL) so insertion costs O(log n) and the recursion depth stays bounded no matter what order the words arrive in. The rows are read in order through TreeIterators, which keep the path down the tree on an explicit stack, so a caller can pull rows one at a time and stop whenever it likes, and printing uses the same iterators. It is a template over the window of its contexts.
 */
 
 #ifndef BINARYSEARCHTREE_H
 #define BINARYSEARCHTREE_H
 
-#include <vector>
-#include <fstream>
-#include <iostream>
+#include "WindowedConcordance.h"
 #include "TreeNode.h"
+#include "TreeIterator.h"
 
-class BinarySearchTree
+template <int BEFORE, int AFTER>
+class BinarySearchTree : public WindowedConcordance<BEFORE, AFTER>
 {
    
 public:
    
    /** The default constructor for the BinarySearchTree class.
    Constructs an empty BinarySearchTree object.
-   The root is initialized to nullptr, maxPreKeyLen, maxKeyLen, maxPostKeyLen are initialized to 0, and stopWords is initialized to false. */
+   The root is initialized to nullptr. */
    BinarySearchTree();
   
    /**The copy constructor for the BinarySearchTree class.
@@ -29,23 +29,15 @@ public:
    BinarySearchTree(const BinarySearchTree& tree);
    
    /** The destructor for the BinarySearchTree class.
-   Destroys the BinarySearchTree object, freeing the memory allocated for the TreeNodes in the tree when its lifetime ends.*/
+   Destroys the BinarySearchTree object when its lifetime ends. The TreeNodes own nothing outside the NodeArena they were created in, so they are not visited: the arena releases them in bulk.*/
    virtual ~BinarySearchTree();
    
    /** Tests whether binary tree is empty.
    @return True if the binary tree is empty, false otherwise.
    @pre none
    @post Returns true if the binary tree is empty, false otherwise.*/
-   bool isEmpty() const;
+   bool isEmpty() const override;
    
-   /**Adds a new TreeNode containing the keyword and the context, or updates the context list with the new context if the TreeNode containing the keyword already exists.
-   @param keyWord A keyword from the corpus.
-   @param newContext New context to be added.
-   @return True if the new TreeNode could be added to the binary search tree or the TreeNode containing the keyword already exists and the context list was updated. False otherwise
-   @pre The keyword must be of type string and the context to be added must be of type ListNode::contextArr.
-   @post If the addition was successful, a new TreeNode containing the keyword and the context given will be added to the tree. Or if a TreeNode containing the keyword already exists the context list will be updated with the new context. If the new context contains the longest pre-key context, post-key context, and/or keyword, the maximum lengths for these values will be updated.*/
-   bool add(string& keyWord, const ListNode::contextArr& newContext);
-
    void clear();
    
    /** Overloaded assignment operator for the BinarySearchTree class.
@@ -54,108 +46,143 @@ public:
    @param rhs The tree on the right side of the assignment operator. */
    BinarySearchTree& operator=(const BinarySearchTree& rhs);
    
-   /** Performs a recursive inorder traversal of the binary search tree and prints a formatted context list after visiting each node. Public method.
-    @pre None.
-   @post The context list for each node in the binary search tree will be printed to cout in alphabetical order based on the key in each TreeNode. If the tree is empty, nothing will be printed to cout.*/
-   void printConcordance() const;
-   
-   /**Builds a vector containing the stop words.
-   @param stopWordFile The name of the file containing the stop words.
-   @return True if the file exists, could be opened, and the vector was filled with at least one string. False if the file does not exist, could not be opened, or the file contained not strings.
-   @pre The stopword file must be located in the same directory as the executable. The argument must be of type string.
-   @post If the stopword file exists and could be read, the stopWordVector will be filled with the stop words in the file. If the file does not contain strings, the vector will remain empty and false will be returned. If the file does not exist or could not be opened, the vector will remain empty and false will be returned.
-   */
-   bool buildStopWordVector(const string& stopWordFile);
-   
-   /** Updates the maximum lengths of the pre-key context length, the key length, and the post-key context length.
-   @param context The array of context words.
-   @pre The context must be of type ListNode::contextArr
-   @post If any of the lengths in the given array are greater than the current maximum lengths, the maximum length(s) will be updated with the appropriate length(s) in the given array. If no lengths in the array are greater, the maximum lengths will remain the same.
-    */
-   void setMaxLengths(const ListNode::contextArr& context);
-   
-   /**Sets the boolean value stopWords and fills the stopword vector with stopwords.
-   @param stopWordFile The file to read the stop words from.
-   @return True if the file exists, was read from, and populated the stopword vector with at least 1 string. False otherwise.
-   @pre The stopWordFile must be of type string.
-   @post If a stopword file exists, could be read from, and contains at least 1 string. The size of the stopword vector will be greater than 0, the vector will be filled with the string(s) in the stop word file, the boolean value stopWords will be set to true, and true will be returned. If the file does not exist, could not be read from, or does not contain at least 1 string, the stopword vector will have size 0, stopWords will be set to false, and false will be returned. */
-   bool excludeStopWords(const string& stopWordFile);
-   
-   /** Checks if the given word is a word in the stopword vector.
-   @param word The word to be checked.
-   @return True if the word is a stopword, false otherwise.
-   @pre The word must be of type string.
-   @post True will be returned if the word found in the stopword vector, otherwise false will be returned.
-   */
-   bool isStopWord(string& word);
-   
-   /**Checks if a lone character in the corpus is a punctuation symbol.
-   @param word The word to be checked.
-   @return True will be returned if the word is a punctuation symbol. False otherwise.
-   @pre The word must be of type string.
-   @post True will be returned if the word is a punctuation symbol. False otherwise.
-   */
-   bool static isPunct(string& word);
-   
-   /**Fills the context array with words from the corpus starting at index 5.
-   @param word The word to be inserted into the array.
-   @param arr The context array to insert the word into.
-   @param wordCount The number of words that have been iterated through in the corpus text.
-   @pre The arguments for the word, array, and index must be of type  string, ListNode::contextArr, and int, respectively.
-   @post The context array will be filled with the word given starting at index 5-9 when wordCount is 0-4. When wordCount is >=5 the array will be filled at index 10 with the given word.
-   */
-   void static fillContextArray(string& word, ListNode::contextArr& arr, int& wordCount);
-   
-   /**Shifts words in the context array 1 index to the left. After shifting, the element at array index 10 will contain an empty string.
-   @param arr The context array.
-   @pre The array must be of type ListNode::contextArr.
-   @post Words in indices 1-10 will be shifted 1 index to the left. The element at index 10 will be an empty string.
-    */
-   void static shiftArray(ListNode::contextArr& arr);
-   
-   /**Strips a word of punctuation and makes it lowercase.
-   @param word The word to be reformatted.
-   @pre The word must be of type string.
-   @post The word will be stripped of punctuation and be lowercase.
-   */
-   void static removePunctAndLower(string& word);
+   /**The move constructor for the BinarySearchTree class.
+   Takes the nodes of the tree supplied as the argument without copying them.
+   @param tree The tree to be moved. It may only be destroyed or assigned to afterwards. */
+   BinarySearchTree(BinarySearchTree&& tree);
+   
+   /** Overloaded move assignment operator for the BinarySearchTree class.
+   @pre Objects on the left and right side of the operator must BinarySearchTree objects.
+   @post The tree on the left side of the operator will hold the nodes of the tree on the right, which may only be destroyed or assigned to afterwards. The nodes that were in the left tree are destroyed.
+   @param rhs The tree on the right side of the assignment operator. */
+   BinarySearchTree& operator=(BinarySearchTree&& rhs);
+   
+   /**Adds the counters of the tree to a report.
+   @param runStats The RunStats the counters are set in.
+   @pre none
+   @post The report will hold the counters of every concordance, the number of keywords in the tree, its height, and the number of keyword comparisons made by insertions and their average. */
+   void collectStats(RunStats& runStats) const override;
+   
+   /**Returns an iterator at the first row of the tree.
+   @return An iterator over the rows in alphabetical order based on the keyword, and in corpus order within a keyword.
+   @pre The tree must not be changed while the iterator is used.
+   @post The iterator will be at the first context of the first keyword, or equal to end() if the tree is empty. Only the path to the first keyword is visited. */
+   TreeIterator<BEFORE, AFTER> begin() const;
    
+   /**Returns an iterator past the last row of the tree.
+   @return The iterator every other iterator of the tree is equal to once it has passed its last row.
+   @pre none
+   @post An iterator past the last row will be returned. */
+   TreeIterator<BEFORE, AFTER> end() const;
+   
+   /**Returns an iterator at the first row of the keywords a query matches.
+   @param query The keywords to visit.
+   @return An iterator over the rows of the matching keywords in alphabetical order, and in corpus order within a keyword.
+   @pre The tree must not be changed, and the query must not be destroyed, while the iterator is used.
+   @post The iterator will be at the first context of the first matching keyword, or equal to end() if nothing matches. Subtrees holding no matches are never visited. */
+   TreeIterator<BEFORE, AFTER> beginMatches(const KeyQuery& query) const;
+   
+protected:
+   /**Finds the context list of a keyword, adding a new TreeNode with an empty context list for the keyword first if it is not in the tree yet.
+   @param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+   @return The keyword's context list.
+   @pre The keyword must not be a stop word.
+   @post The keyword will be in the tree. The tree will remain balanced. */
+   ContextList& findOrInsert(const string& keyWord) override;
+   
+   /** Collects the context list of each node in alphabetical order with a TreeIterator.
+   @param lists The vector to store the context lists in.
+   @pre none
+   @post lists will hold the context list of each node in the binary search tree in alphabetical order based on the key in each TreeNode.*/
+   void sortedLists(vector<const ContextList*>& lists) const override;
+   
+   /** Collects the context lists of the keywords a query matches with a TreeIterator that skips the subtrees holding no matches.
+   @param query The keywords to collect.
+   @param lists The vector to store the context lists in.
+   @pre none
+   @post lists will hold the context list of each matching node in alphabetical order based on the key in each TreeNode. Only the paths to the first and last match and the matching nodes are visited, so it takes O(log n + matches).*/
+   void matchingLists(const KeyQuery& query, vector<const ContextList*>& lists) const override;
+   
+   /** Starts a TreeWalk over the keywords a query matches, in alphabetical order.
+   @param query The keywords to visit, or nullptr to visit every keyword.
+   @return A new TreeWalk at the first matching keyword, which the caller must delete.
+   @pre The tree must not be changed, and the query must not be destroyed, while the walk is used.
+   @post The walk will hold the path down to its keyword, no longer than the height of the tree. */
+   KeyWalk* walkKeys(const KeyQuery* query) const override;
+   
+   /** Writes the rows of every keyword in alphabetical order, pulled one at a time from a TreeIterator.
+   @param writer The OutputWriter to write the rows to, with its columns set.
+   @param threads The number of threads to format the rows on.
+   @pre threads must be at least 1.
+   @post The rows of every keyword will be written in alphabetical order, and in corpus order within a keyword. One thread formats the rows straight from the iterator, more than one split the rows into ranges as every concordance does. */
+   void writeRows(OutputWriter& writer, int threads) const override;
+   
+   /** Writes the rows of the keywords a query matches in alphabetical order, pulled one at a time from a TreeIterator.
+   @param writer The OutputWriter to write the rows to, with its columns set.
+   @param query The keywords to write.
+   @pre none
+   @post The rows of every matching keyword will be written in alphabetical order, and in corpus order within a keyword. */
+   void writeMatchingRows(OutputWriter& writer, const KeyQuery& query) const override;
    
 private:
+   using Concordance::vocabulary;
+   using Concordance::words;
+   using Concordance::nodeArena;
+   
    TreeNode* root; //pointer to root node
-   int maxPreKeyLen; //length of longest string of context words before keyword in the tree
-   int maxKeyLen; //length of longest keyword in the tree
-   int maxPostKeyLen; //length of longest string of context words after keyword in the tree
-   bool stopWords; //true if excluding stopwords
-   vector<string> stopWordVector; //vector to contain the stopwords
+   uint64_t numKeys; //number of TreeNodes in the tree
+   uint64_t numInserts; //number of keywords looked up or inserted
+   uint64_t numComparisons; //number of keyword comparisons made by the insertions
    
    /**Inserts a new TreeNode into the binary tree into the appropriate location based on the given keyword.
    @param treePtr The TreeNode pointer pointing to the root node of the tree.
    @param keyWord A keyword from the corpus.
-   @param context New context to be added.
+   @param keyNode Set to the TreeNode containing the keyword.
    @return Returns the root pointer to the binary search tree after the TreeNode has been added to the appropriate location.
-   @pre The keyword must be of type string and the context to be added must be of type ListNode::contextArr.
-   @post A new TreeNode containing the keyword will be added to the tree in the appropriate location based on the keyword, and a new ContextList object will be created for the given context. Or if a TreeNode containing the keyword already exists the new context will be added to the end of the context list stored in the TreeNode. After insertion, the pointer to the root node of the tree will be returned.*/
-   TreeNode* insert(TreeNode* treePtr, const string& keyWord, const ListNode::contextArr& context);
+   @pre The keyword must be of type string.
+   @post A new TreeNode containing the keyword and an empty ContextList will be added to the tree in the appropriate location based on the keyword, unless a TreeNode containing the keyword already exists. keyNode will point to the TreeNode containing the keyword. After insertion, the subtree will be rebalanced and the pointer to its root node will be returned.*/
+   TreeNode* insert(TreeNode* treePtr, const string& keyWord, TreeNode*& keyNode);
    
    /** Creates a deep copy for each node in a binary search tree using a recursive preorder traversal.
    @param origTreePtr The TreeNode pointer to the root of the original tree.
    @return The TreeNode pointer to the root of the copied tree.
    @pre origTreePtr must be a pointer to a TreeNode
    @post All nodes in the original tree will be deep copied and the pointer to the root node of the copied tree will be returned.*/
-   TreeNode* copyTree(const TreeNode* origTreePtr) const;
-   
-   /** Deletes each node in the tree using a recursive postorder traversal.
-   @param treePtr The pointer to the root of the tree or subtree.
-   @pre treePtr must be a pointer to a TreeNode object.
-   @post Each node in the tree or subtree will be deleted. */
-   void destroyTree(TreeNode* treePtr);
-   
-   /** Performs a recursive inorder traversal of the binary search tree and prints a formatted context list after visiting each node. Private method.
-   @param treePtr The TreeNode pointer pointing to the root node of the tree or subtree.
-   @pre treePtr must be a pointer to a TreeNode object.
-   @post The context list for each node in the binary search tree will be printed to cout in alphabetical order based on the key in each TreeNode. If the tree is empty, nothing will be printed to cout.*/
-   void inorder(TreeNode* treePtr) const;
+   TreeNode* copyTree(const TreeNode* origTreePtr);
+   
+   /**Returns the height of a subtree.
+   @param treePtr The TreeNode pointer pointing to the root of the subtree.
+   @return The height of the subtree, or 0 if the subtree is empty.
+   @pre treePtr must be a pointer to a TreeNode object or nullptr.
+   @post The height of the subtree will be returned. */
+   int static height(const TreeNode* treePtr);
+   
+   /**Recomputes the height of a TreeNode from the heights of its children.
+   @param treePtr The TreeNode pointer whose height is updated.
+   @pre treePtr must point to a TreeNode whose children have correct heights.
+   @post The height stored in the TreeNode will be one more than the height of its taller child. */
+   void static updateHeight(TreeNode* treePtr);
+   
+   /**Rotates a subtree to the left, making the right child the new root of the subtree.
+   @param treePtr The TreeNode pointer pointing to the root of the subtree.
+   @return The TreeNode pointer to the new root of the subtree.
+   @pre treePtr and its right child must not be nullptr.
+   @post The subtree will be rotated left, and the heights of the two rotated nodes will be updated. */
+   static TreeNode* rotateLeft(TreeNode* treePtr);
+   
+   /**Rotates a subtree to the right, making the left child the new root of the subtree.
+   @param treePtr The TreeNode pointer pointing to the root of the subtree.
+   @return The TreeNode pointer to the new root of the subtree.
+   @pre treePtr and its left child must not be nullptr.
+   @post The subtree will be rotated right, and the heights of the two rotated nodes will be updated. */
+   static TreeNode* rotateRight(TreeNode* treePtr);
+   
+   /**Restores the AVL balance of a subtree after an insertion into one of its children.
+   @param treePtr The TreeNode pointer pointing to the root of the subtree.
+   @return The TreeNode pointer to the root of the balanced subtree.
+   @pre treePtr must not be nullptr and its children must be balanced AVL subtrees whose heights differ by at most 2.
+   @post The heights of the child subtrees will differ by at most 1 and the height of the root will be updated. */
+   static TreeNode* rebalance(TreeNode* treePtr);
    
 };
 
@@ -0,0 +1,496 @@
+/*
+file name: BurstTrie.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the BurstTrie class. The BurstTrie class is a Concordance engine that keeps the keywords in a burst trie. A trie node has a child for each byte value, so a keyword is found by following one child per byte, and the bytes a keyword shares with others are stored once, in the path down to it. Below the nodes, the keywords are kept in buckets, each holding the rest of up to BURST_KEYS keywords after the bytes of its path, one after another in a single block of memory, so a bucket is searched with a short scan instead of a chain of nodes. A bucket that grows past BURST_KEYS bursts into a node of its own with new buckets below it. Finding a keyword costs O(length of the keyword), plus the scan of one bucket. The rows are collected in alphabetical order by walking the children of each node in byte order and sorting the few keywords of each bucket with a StringSort, which gives the order of operator< that the BinarySearchTree prints in. A prefix query only walks the nodes below the prefix. It is a template over the window of its contexts.
+*/
+
+#include "BurstTrie.h"
+
+#include <cstring>
+
+using namespace std;
+
+/** The default constructor for the BurstTrie class.
+Constructs an empty BurstTrie object, a root node with no children. */
+template <int BEFORE, int AFTER>
+BurstTrie<BEFORE, AFTER>::BurstTrie() : WindowedConcordance<BEFORE, AFTER>(), nodes(1, Node{}), numBursts(0)
+{
+}
+
+/** The destructor for the BurstTrie class.
+Destroys the BurstTrie object, freeing the memory allocated for the nodes, the buckets and the context lists when its lifetime ends.*/
+template <int BEFORE, int AFTER>
+BurstTrie<BEFORE, AFTER>::~BurstTrie()
+{
+}
+
+/** Tests whether the trie is empty.
+@return True if no keywords have been added, false otherwise.
+@pre none
+@post Returns true if the trie is empty, false otherwise.*/
+template <int BEFORE, int AFTER>
+bool BurstTrie<BEFORE, AFTER>::isEmpty() const
+{
+   return contextLists.empty();
+}
+
+/**Finds the context list of a keyword, adding the keyword to the trie with an empty context list first if it is not in the trie yet.
+@param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+@return The keyword's context list.
+@pre The keyword must not be a stop word.
+@post The keyword will be in the trie. If its bucket was full it will have burst into a node first. */
+template <int BEFORE, int AFTER>
+ContextList& BurstTrie<BEFORE, AFTER>::findOrInsert(const string& keyWord)
+{
+   uint32_t node = 0;
+   size_t depth = 0;
+
+   //follow a child for each byte of the keyword until it ends at a node or reaches a bucket
+   while ( true )
+   {
+      if ( depth == keyWord.length() )
+      {
+         if ( nodes[node].endList == 0 )
+         {
+            uint32_t list = newList();
+            nodes[node].endList = list + 1;
+         }
+         return contextLists[nodes[node].endList - 1];
+      }
+
+      unsigned char byte = (unsigned char)keyWord[depth];
+      uint32_t child = nodes[node].children[byte];
+      string_view rest(keyWord.data() + depth + 1, keyWord.length() - depth - 1);
+
+      //no keyword has the path yet, it gets a bucket of its own
+      if ( child == NO_CHILD )
+      {
+         buckets.push_back(Bucket{vector<char>(), 0});
+         nodes[node].children[byte] = BUCKET_CHILD | (uint32_t)(buckets.size() - 1);
+         uint32_t list = newList();
+         appendRecord(buckets.back(), rest, list);
+         return contextLists[list];
+      }
+
+      if ( (child & BUCKET_CHILD) == 0 )
+      {
+         node = child;
+         depth++;
+         continue;
+      }
+
+      Bucket& bucket = buckets[child & ~BUCKET_CHILD];
+      uint32_t found = findRecord(bucket, rest);
+      if ( found != 0 )
+         return contextLists[found - 1];
+
+      //a full bucket becomes a node, and the keyword is looked for again below it
+      if ( bucket.numKeys >= BURST_KEYS )
+      {
+         burst(node, byte);
+         continue;
+      }
+
+      uint32_t list = newList();
+      appendRecord(bucket, rest, list);
+      return contextLists[list];
+   }
+}
+
+/**Finds the list of a keyword.
+@param keyWord A keyword, stripped of punctuation and lowercase.
+@return The keyword's list, or nullptr if the keyword is not in the trie.
+@pre none
+@post The trie is unchanged. */
+template <int BEFORE, int AFTER>
+const ContextList* BurstTrie<BEFORE, AFTER>::find(const string& keyWord) const
+{
+   uint32_t node = 0;
+   for (size_t depth = 0; depth < keyWord.length(); depth++)
+   {
+      uint32_t child = nodes[node].children[(unsigned char)keyWord[depth]];
+      if ( child == NO_CHILD )
+         return nullptr;
+      if ( (child & BUCKET_CHILD) != 0 )
+      {
+         uint32_t found = findRecord(buckets[child & ~BUCKET_CHILD], string_view(keyWord).substr(depth + 1));
+         return found == 0 ? nullptr : &contextLists[found - 1];
+      }
+      node = child;
+   }
+   return nodes[node].endList == 0 ? nullptr : &contextLists[nodes[node].endList - 1];
+}
+
+/**Appends a record to a bucket.
+@param bucket The bucket.
+@param rest The bytes of the keyword after the path to the bucket.
+@param list The index of the keyword's list.
+@pre rest must be shorter than 4 GB.
+@post The record will be the last in the bucket. */
+template <int BEFORE, int AFTER>
+void BurstTrie<BEFORE, AFTER>::appendRecord(Bucket& bucket, string_view rest, uint32_t list)
+{
+   uint32_t length = (uint32_t)rest.length();
+   size_t start = bucket.records.size();
+   bucket.records.resize(start + RECORD_HEADER + length);
+   char* record = bucket.records.data() + start;
+   memcpy(record, &length, sizeof(length));
+   memcpy(record + sizeof(length), &list, sizeof(list));
+   memcpy(record + RECORD_HEADER, rest.data(), length);
+   bucket.numKeys++;
+}
+
+/**Finds the list of a keyword in a bucket.
+@param bucket The bucket.
+@param rest The bytes of the keyword after the path to the bucket.
+@return The index of the keyword's list plus 1, or 0 if the bucket does not hold the keyword.
+@pre none
+@post The bucket is unchanged. */
+template <int BEFORE, int AFTER>
+uint32_t BurstTrie<BEFORE, AFTER>::findRecord(const Bucket& bucket, string_view rest)
+{
+   //the records are scanned in the order they were added, and only records of the same length are compared
+   const char* record = bucket.records.data();
+   const char* end = record + bucket.records.size();
+   while ( record < end )
+   {
+      uint32_t length;
+      memcpy(&length, record, sizeof(length));
+      if ( length == rest.length() && memcmp(record + RECORD_HEADER, rest.data(), length) == 0 )
+      {
+         uint32_t list;
+         memcpy(&list, record + sizeof(length), sizeof(list));
+         return list + 1;
+      }
+      record += RECORD_HEADER + length;
+   }
+   return 0;
+}
+
+/**Adds a new, empty context list.
+@return The index of the list.
+@pre none
+@post The list will be created in the NodeArena. */
+template <int BEFORE, int AFTER>
+uint32_t BurstTrie<BEFORE, AFTER>::newList()
+{
+   contextLists.emplace_back(&nodeArena);
+   return (uint32_t)(contextLists.size() - 1);
+}
+
+/**Replaces a full bucket with a node, moving each of its keywords into the node or a new bucket below it.
+@param parent The index of the node the bucket is a child of.
+@param byte The byte value of the bucket in its parent.
+@pre The child must be a bucket.
+@post The child will be a node holding the keywords of the bucket. The bucket's memory is released. */
+template <int BEFORE, int AFTER>
+void BurstTrie<BEFORE, AFTER>::burst(uint32_t parent, unsigned char byte)
+{
+   uint32_t old = nodes[parent].children[byte] & ~BUCKET_CHILD;
+   vector<char> records;
+   records.swap(buckets[old].records);
+   buckets[old].numKeys = 0;
+
+   nodes.push_back(Node{});
+   uint32_t node = (uint32_t)(nodes.size() - 1);
+   nodes[parent].children[byte] = node;
+   numBursts++;
+
+   //each keyword moves down a byte, the old bucket is reused for the first new one
+   bool oldReused = false;
+   const char* record = records.data();
+   const char* end = record + records.size();
+   while ( record < end )
+   {
+      uint32_t length;
+      uint32_t list;
+      memcpy(&length, record, sizeof(length));
+      memcpy(&list, record + sizeof(length), sizeof(list));
+      const char* rest = record + RECORD_HEADER;
+      record = rest + length;
+
+      if ( length == 0 )
+      {
+         nodes[node].endList = list + 1;
+         continue;
+      }
+
+      uint32_t& child = nodes[node].children[(unsigned char)rest[0]];
+      if ( child == NO_CHILD )
+      {
+         if ( !oldReused )
+         {
+            child = BUCKET_CHILD | old;
+            oldReused = true;
+         }
+         else
+         {
+            buckets.push_back(Bucket{vector<char>(), 0});
+            child = BUCKET_CHILD | (uint32_t)(buckets.size() - 1);
+         }
+      }
+      appendRecord(buckets[child & ~BUCKET_CHILD], string_view(rest + 1, length - 1), list);
+   }
+}
+
+/** Collects the context list of each keyword in alphabetical order.
+@param lists The vector to store the context lists in.
+@pre none
+@post lists will hold the context list of each keyword in alphabetical order.*/
+template <int BEFORE, int AFTER>
+void BurstTrie<BEFORE, AFTER>::sortedLists(vector<const ContextList*>& lists) const
+{
+   lists.clear();
+   lists.reserve(contextLists.size());
+   for (TrieWalk walk(this, nullptr); !walk.atEnd(); walk.next())
+      lists.push_back(&walk.getContextList());
+}
+
+/** Collects the context lists of the keywords a query matches, in alphabetical order.
+@param query The keywords to collect.
+@param lists The vector to store the context lists in.
+@pre none
+@post lists will hold the context list of each matching keyword in alphabetical order. An exact keyword is found by following its bytes down the trie. For a prefix or a range, the nodes whose keywords all come before the first match are skipped, and the walk stops at the first keyword after the matches.*/
+template <int BEFORE, int AFTER>
+void BurstTrie<BEFORE, AFTER>::matchingLists(const KeyQuery& query, vector<const ContextList*>& lists) const
+{
+   if ( query.isSingleKey() )
+   {
+      lists.clear();
+      const ContextList* list = find(query.getFirst());
+      if ( list != nullptr )
+         lists.push_back(list);
+      return;
+   }
+   lists.clear();
+   for (TrieWalk walk(this, &query); !walk.atEnd(); walk.next())
+      lists.push_back(&walk.getContextList());
+}
+
+/** Starts a TrieWalk over the keywords a query matches, in alphabetical order.
+@param query The keywords to visit, or nullptr to visit every keyword.
+@return A new TrieWalk at the first matching keyword, which the caller must delete.
+@pre The trie must not be changed, and the query must not be destroyed, while the walk is used.
+@post The walk will hold the path down to its keyword and the sorted keywords of one bucket. */
+template <int BEFORE, int AFTER>
+KeyWalk* BurstTrie<BEFORE, AFTER>::walkKeys(const KeyQuery* query) const
+{
+   return new TrieWalk(this, query);
+}
+
+/** Constructor for the TrieWalk class that accepts the trie and the keywords to visit.
+Walks down to the first keyword of the trie, or to the first keyword the query matches.
+@param trie The trie whose keywords are visited.
+@param query The keywords to visit, or nullptr to visit every keyword.
+@pre The trie, and the query if given, must not change or be destroyed while the walk is used. */
+template <int BEFORE, int AFTER>
+BurstTrie<BEFORE, AFTER>::TrieWalk::TrieWalk(const BurstTrie* trie, const KeyQuery* query)
+   : trie(trie), query(query), bucketIndex(0), list(nullptr)
+{
+   stack.push_back(WalkStep{0, -1, 0});
+   advance();
+}
+
+/**Makes a copy of the walk at the same keyword.
+@return A new walk the caller must delete.
+@pre none
+@post The copy will hold a copy of the path and of the sorted keywords of the current bucket, which holds no more than BURST_KEYS keywords. */
+template <int BEFORE, int AFTER>
+KeyWalk* BurstTrie<BEFORE, AFTER>::TrieWalk::clone() const
+{
+   return new TrieWalk(*this);
+}
+
+/**Tests whether the walk is past the last keyword.
+@return True if there are no keywords left, false otherwise.
+@pre none
+@post The walk is unchanged. */
+template <int BEFORE, int AFTER>
+bool BurstTrie<BEFORE, AFTER>::TrieWalk::atEnd() const
+{
+   return list == nullptr;
+}
+
+/**Moves to the next keyword.
+@pre The walk must not be past the last keyword.
+@post The walk will be at the next keyword in byte order that matches, or past the last keyword. */
+template <int BEFORE, int AFTER>
+void BurstTrie<BEFORE, AFTER>::TrieWalk::next()
+{
+   advance();
+}
+
+/**Returns the current keyword.
+@return The keyword.
+@pre The walk must not be past the last keyword.
+@post The keyword will be returned as a view of the walk's copy of it, valid until the walk is moved or destroyed. */
+template <int BEFORE, int AFTER>
+string_view BurstTrie<BEFORE, AFTER>::TrieWalk::getKey() const
+{
+   return keyWord;
+}
+
+/**Returns the context list of the current keyword.
+@return The context list.
+@pre The walk must not be past the last keyword.
+@post The context list will be returned as a const reference. */
+template <int BEFORE, int AFTER>
+const ContextList& BurstTrie<BEFORE, AFTER>::TrieWalk::getContextList() const
+{
+   return *list;
+}
+
+/**Moves to the next keyword that matches, from the next keyword of the current bucket or the next child of the node on top of the stack.
+@pre none
+@post The walk will be at a keyword that matches, or past the last keyword with the stack empty. */
+template <int BEFORE, int AFTER>
+void BurstTrie<BEFORE, AFTER>::TrieWalk::advance()
+{
+   while ( true )
+   {
+      //every keyword of the bucket starts with the path to it
+      while ( bucketIndex < bucketKeys.size() )
+      {
+         const StringSort::Key& key = bucketKeys[bucketIndex++];
+         keyWord.assign(path).append(key.data, key.length);
+         if ( query != nullptr )
+         {
+            if ( query->isAfter(keyWord) )
+            {
+               finish();
+               return;
+            }
+            if ( !query->matches(keyWord) )
+               continue;
+         }
+         list = &trie->contextLists[key.index];
+         return;
+      }
+      
+      if ( stack.empty() )
+      {
+         finish();
+         return;
+      }
+      WalkStep& step = stack.back();
+      const Node& node = trie->nodes[step.node];
+      path.resize(step.depth);
+      
+      //the keyword ending at a node comes before every keyword below it
+      if ( step.nextChild < 0 )
+      {
+         step.nextChild = 0;
+         if ( node.endList != 0 )
+         {
+            if ( query != nullptr && query->isAfter(path) )
+            {
+               finish();
+               return;
+            }
+            if ( query == nullptr || query->matches(path) )
+            {
+               keyWord = path;
+               list = &trie->contextLists[node.endList - 1];
+               return;
+            }
+         }
+         continue;
+      }
+      if ( step.nextChild > 255 )
+      {
+         stack.pop_back();
+         continue;
+      }
+      
+      unsigned char byte = (unsigned char)step.nextChild++;
+      uint32_t child = node.children[byte];
+      if ( child == NO_CHILD )
+         continue;
+      path.push_back((char)byte);
+      
+      //every keyword below the child starts with the path, so the path alone can rule them all out
+      if ( query != nullptr )
+      {
+         if ( isBeforeAll(path, *query) )
+            continue;
+         if ( query->isAfter(path) )
+         {
+            finish();
+            return;
+         }
+      }
+      
+      if ( (child & BUCKET_CHILD) != 0 )
+         loadBucket(trie->buckets[child & ~BUCKET_CHILD]);
+      else
+         stack.push_back(WalkStep{child, -1, path.length()});
+   }
+}
+
+/**Sorts the keywords of a bucket for the walk to visit.
+@param bucket The bucket.
+@pre path must hold the bytes of the path to the bucket.
+@post bucketKeys will hold the rest of each keyword of the bucket in alphabetical order, and the walk will be at the first of them. */
+template <int BEFORE, int AFTER>
+void BurstTrie<BEFORE, AFTER>::TrieWalk::loadBucket(const Bucket& bucket)
+{
+   //every keyword of the bucket starts with the path, so sorting the rest of each one is enough
+   bucketKeys.clear();
+   const char* record = bucket.records.data();
+   const char* end = record + bucket.records.size();
+   while ( record < end )
+   {
+      uint32_t length;
+      uint32_t list;
+      memcpy(&length, record, sizeof(length));
+      memcpy(&list, record + sizeof(length), sizeof(list));
+      bucketKeys.push_back(StringSort::makeKey(string_view(record + RECORD_HEADER, length), list));
+      record += RECORD_HEADER + length;
+   }
+   StringSort::sort(bucketKeys);
+   bucketIndex = 0;
+}
+
+/**Ends the walk.
+@pre none
+@post The walk will be past the last keyword. */
+template <int BEFORE, int AFTER>
+void BurstTrie<BEFORE, AFTER>::TrieWalk::finish()
+{
+   stack.clear();
+   bucketKeys.clear();
+   bucketIndex = 0;
+   list = nullptr;
+}
+
+/**Tests whether every keyword starting with a path comes before the matches of a query.
+@param path The bytes of the path.
+@param query The query.
+@return True if the path comes before the query's first match and is not a prefix of it, false otherwise.
+@pre none
+@post The query is unchanged. */
+template <int BEFORE, int AFTER>
+bool BurstTrie<BEFORE, AFTER>::isBeforeAll(const string& path, const KeyQuery& query)
+{
+   return query.isBefore(path) && query.getFirst().compare(0, path.length(), path) != 0;
+}
+
+/**Adds the counters of the trie to a report.
+@param runStats The RunStats the counters are set in.
+@pre none
+@post The report will hold the counters of every concordance, the number of keywords, nodes and buckets, and the number of buckets that burst. */
+template <int BEFORE, int AFTER>
+void BurstTrie<BEFORE, AFTER>::collectStats(RunStats& runStats) const
+{
+   Concordance::collectStats(runStats);
+   runStats.setCounter("distinct_keys", (double)contextLists.size());
+   runStats.setCounter("trie_nodes", (double)nodes.size());
+   runStats.setCounter("trie_buckets", (double)buckets.size());
+   runStats.setCounter("bursts", (double)numBursts);
+}
+
+//compile the BurstTrie of every window
+#define INSTANTIATE(BEFORE, AFTER) template class BurstTrie<BEFORE, AFTER>;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
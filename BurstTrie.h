@@ -0,0 +1,224 @@
+/*
+file name: BurstTrie.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the BurstTrie class. The BurstTrie class is a Concordance engine that keeps the keywords in a burst trie. A trie node has a child for each byte value, so a keyword is found by following one child per byte, and the bytes a keyword shares with others are stored once, in the path down to it. Below the nodes, the keywords are kept in buckets, each holding the rest of up to BURST_KEYS keywords after the bytes of its path, one after another in a single block of memory, so a bucket is searched with a short scan instead of a chain of nodes. A bucket that grows past BURST_KEYS bursts into a node of its own with new buckets below it. Finding a keyword costs O(length of the keyword), plus the scan of one bucket. The rows are collected in alphabetical order by walking the children of each node in byte order and sorting the few keywords of each bucket with a StringSort, which gives the order of operator< that the BinarySearchTree prints in. A prefix query only walks the nodes below the prefix. It is a template over the window of its contexts.
+*/
+
+#ifndef BURSTTRIE_H
+#define BURSTTRIE_H
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "WindowedConcordance.h"
+#include "StringSort.h"
+
+template <int BEFORE, int AFTER>
+class BurstTrie : public WindowedConcordance<BEFORE, AFTER>
+{
+
+public:
+
+   static constexpr uint32_t BURST_KEYS = 48; //a bucket holding this many keywords bursts into a node before it takes another
+
+   /** The default constructor for the BurstTrie class.
+   Constructs an empty BurstTrie object, a root node with no children. */
+   BurstTrie();
+
+   /** The destructor for the BurstTrie class.
+   Destroys the BurstTrie object, freeing the memory allocated for the nodes, the buckets and the context lists when its lifetime ends.*/
+   virtual ~BurstTrie();
+
+   /** Tests whether the trie is empty.
+   @return True if no keywords have been added, false otherwise.
+   @pre none
+   @post Returns true if the trie is empty, false otherwise.*/
+   bool isEmpty() const override;
+
+   /**Adds the counters of the trie to a report.
+   @param runStats The RunStats the counters are set in.
+   @pre none
+   @post The report will hold the counters of every concordance, the number of keywords, nodes and buckets, and the number of buckets that burst. */
+   void collectStats(RunStats& runStats) const override;
+
+protected:
+   using Concordance::nodeArena;
+
+   /**Finds the context list of a keyword, adding the keyword to the trie with an empty context list first if it is not in the trie yet.
+   @param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+   @return The keyword's context list.
+   @pre The keyword must not be a stop word.
+   @post The keyword will be in the trie. If its bucket was full it will have burst into a node first. */
+   ContextList& findOrInsert(const string& keyWord) override;
+
+   /** Collects the context list of each keyword in alphabetical order.
+   @param lists The vector to store the context lists in.
+   @pre none
+   @post lists will hold the context list of each keyword in alphabetical order.*/
+   void sortedLists(vector<const ContextList*>& lists) const override;
+
+   /** Collects the context lists of the keywords a query matches, in alphabetical order.
+   @param query The keywords to collect.
+   @param lists The vector to store the context lists in.
+   @pre none
+   @post lists will hold the context list of each matching keyword in alphabetical order. An exact keyword is found by following its bytes down the trie. For a prefix or a range, the nodes whose keywords all come before the first match are skipped, and the walk stops at the first keyword after the matches.*/
+   void matchingLists(const KeyQuery& query, vector<const ContextList*>& lists) const override;
+   
+   /** Starts a TrieWalk over the keywords a query matches, in alphabetical order.
+   @param query The keywords to visit, or nullptr to visit every keyword.
+   @return A new TrieWalk at the first matching keyword, which the caller must delete.
+   @pre The trie must not be changed, and the query must not be destroyed, while the walk is used.
+   @post The walk will hold the path down to its keyword and the sorted keywords of one bucket. */
+   KeyWalk* walkKeys(const KeyQuery* query) const override;
+
+private:
+
+   static constexpr uint32_t BUCKET_CHILD = 0x80000000u; //set in a child that is a bucket, whose index is in the other bits
+   static constexpr uint32_t NO_CHILD = 0; //a child that is empty, the root is never a child
+   static constexpr size_t RECORD_HEADER = 2 * sizeof(uint32_t); //bytes before the rest of a keyword in a bucket: its length and the index of its list
+
+   //a node of the trie, with a child for each value of the next byte of a keyword
+   struct Node
+   {
+      uint32_t endList; //index of the list of the keyword ending at the node plus 1, or 0 if none does
+      uint32_t children[256]; //the index of the child node, or of the child bucket with BUCKET_CHILD set, or NO_CHILD
+   };
+
+   //the keywords below a child of a node, stored as the rest of each keyword after the bytes of the path to the bucket
+   //each record is the length of the rest, the index of the keyword's list, and then the bytes of the rest
+   struct Bucket
+   {
+      vector<char> records; //the records one after another
+      uint32_t numKeys; //number of records
+   };
+
+   //a node being walked in alphabetical order, and the next of its children to walk
+   struct WalkStep
+   {
+      uint32_t node; //index of the node
+      int nextChild; //the next byte value to walk, -1 for the keyword ending at the node
+      size_t depth; //the number of bytes in the path to the node
+   };
+
+   //a walk over the keywords of the trie in alphabetical order, walking the children of each node in byte order and sorting the few keywords of each bucket with a StringSort
+   //the path to the current node is kept on an explicit stack, so the walk does not recurse however long the keywords are
+   class TrieWalk : public KeyWalk
+   {
+   public:
+      /** Constructor for the TrieWalk class that accepts the trie and the keywords to visit.
+      Walks down to the first keyword of the trie, or to the first keyword the query matches.
+      @param trie The trie whose keywords are visited.
+      @param query The keywords to visit, or nullptr to visit every keyword.
+      @pre The trie, and the query if given, must not change or be destroyed while the walk is used. */
+      TrieWalk(const BurstTrie* trie, const KeyQuery* query);
+      
+      /**Makes a copy of the walk at the same keyword.
+      @return A new walk the caller must delete.
+      @pre none
+      @post The copy will hold a copy of the path and of the sorted keywords of the current bucket, which holds no more than BURST_KEYS keywords. */
+      KeyWalk* clone() const override;
+      
+      /**Tests whether the walk is past the last keyword.
+      @return True if there are no keywords left, false otherwise.
+      @pre none
+      @post The walk is unchanged. */
+      bool atEnd() const override;
+      
+      /**Moves to the next keyword.
+      @pre The walk must not be past the last keyword.
+      @post The walk will be at the next keyword in byte order that matches, or past the last keyword. */
+      void next() override;
+      
+      /**Returns the current keyword.
+      @return The keyword.
+      @pre The walk must not be past the last keyword.
+      @post The keyword will be returned as a view of the walk's copy of it, valid until the walk is moved or destroyed. */
+      string_view getKey() const override;
+      
+      /**Returns the context list of the current keyword.
+      @return The context list.
+      @pre The walk must not be past the last keyword.
+      @post The context list will be returned as a const reference. */
+      const ContextList& getContextList() const override;
+      
+   private:
+      /**Moves to the next keyword that matches, from the next keyword of the current bucket or the next child of the node on top of the stack.
+      @pre none
+      @post The walk will be at a keyword that matches, or past the last keyword with the stack empty. */
+      void advance();
+      
+      /**Sorts the keywords of a bucket for the walk to visit.
+      @param bucket The bucket.
+      @pre path must hold the bytes of the path to the bucket.
+      @post bucketKeys will hold the rest of each keyword of the bucket in alphabetical order, and the walk will be at the first of them. */
+      void loadBucket(const Bucket& bucket);
+      
+      /**Ends the walk.
+      @pre none
+      @post The walk will be past the last keyword. */
+      void finish();
+      
+      const BurstTrie* trie; //the trie whose keywords are visited
+      const KeyQuery* query; //the keywords to visit, or nullptr for every keyword
+      vector<WalkStep> stack; //the nodes on the path to the current keyword and the next child of each to walk
+      string path; //the bytes of the path to the node or bucket being walked
+      vector<StringSort::Key> bucketKeys; //the rest of each keyword of the current bucket after the path, in alphabetical order
+      size_t bucketIndex; //the index in bucketKeys of the next keyword of the bucket to visit
+      string keyWord; //the current keyword
+      const ContextList* list; //the context list of the current keyword, nullptr past the last keyword
+   };
+   
+   /**Appends a record to a bucket.
+   @param bucket The bucket.
+   @param rest The bytes of the keyword after the path to the bucket.
+   @param list The index of the keyword's list.
+   @pre rest must be shorter than 4 GB.
+   @post The record will be the last in the bucket. */
+   void static appendRecord(Bucket& bucket, string_view rest, uint32_t list);
+
+   /**Finds the list of a keyword in a bucket.
+   @param bucket The bucket.
+   @param rest The bytes of the keyword after the path to the bucket.
+   @return The index of the keyword's list plus 1, or 0 if the bucket does not hold the keyword.
+   @pre none
+   @post The bucket is unchanged. */
+   uint32_t static findRecord(const Bucket& bucket, string_view rest);
+
+   /**Adds a new, empty context list.
+   @return The index of the list.
+   @pre none
+   @post The list will be created in the NodeArena. */
+   uint32_t newList();
+
+   /**Replaces a full bucket with a node, moving each of its keywords into the node or a new bucket below it.
+   @param parent The index of the node the bucket is a child of.
+   @param byte The byte value of the bucket in its parent.
+   @pre The child must be a bucket.
+   @post The child will be a node holding the keywords of the bucket. The bucket's memory is released. */
+   void burst(uint32_t parent, unsigned char byte);
+
+   /**Finds the list of a keyword.
+   @param keyWord A keyword, stripped of punctuation and lowercase.
+   @return The keyword's list, or nullptr if the keyword is not in the trie.
+   @pre none
+   @post The trie is unchanged. */
+   const ContextList* find(const string& keyWord) const;
+
+   /**Tests whether every keyword starting with a path comes before the matches of a query.
+   @param path The bytes of the path.
+   @param query The query.
+   @return True if the path comes before the query's first match and is not a prefix of it, false otherwise.
+   @pre none
+   @post The query is unchanged. */
+   bool static isBeforeAll(const string& path, const KeyQuery& query);
+
+   vector<Node> nodes; //the nodes of the trie, the root first
+   vector<Bucket> buckets; //the buckets of the trie, including the empty ones left by bursting
+   deque<ContextList> contextLists; //the lists of the keywords in the order they were first added, a deque so lists never move
+   size_t numBursts; //number of buckets that burst into nodes
+};
+
+#endif
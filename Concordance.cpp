@@ -0,0 +1,402 @@
+/*
+file name: Concordance.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the Concordance class. The Concordance class is the abstract base class of the concordance engines. It holds everything the engines share: the Vocabulary and the WordStream the contexts are read from, the stop words, the maximum column lengths used to format the output, and the rules for cleaning words read from the corpus. It does not depend on the size of the contexts: WindowedConcordance adds the contexts of a given window, and the engines derived from it decide how the keywords and their context lists are indexed and how they are put in alphabetical order for printing.
+*/
+
+#include "Concordance.h"
+
+using namespace std;
+
+/** The default constructor for the Concordance class.
+Constructs an empty Concordance object.
+maxPreKeyLen, maxKeyLen, maxPostKeyLen are initialized to 0, and stopWords is initialized to false. */
+Concordance::Concordance() : maxPreKeyLen(0), maxKeyLen(0), maxPostKeyLen(0), stopWords(false), stats(nullptr), numKeywordsRead(0), numStopWordHits(0), numDocuments(0)
+{
+}
+
+/** The copy constructor for the Concordance class.
+Copies the Vocabulary, the WordStream, the stop words, and the maximum lengths. The copy starts with an empty NodeArena, the derived class copies the nodes into it.
+@param other The concordance to be copied. */
+Concordance::Concordance(const Concordance& other) : maxPreKeyLen(other.maxPreKeyLen), maxKeyLen(other.maxKeyLen), maxPostKeyLen(other.maxPostKeyLen), vocabulary(other.vocabulary), words(other.words), stopWords(other.stopWords), stopWordSet(other.stopWordSet), stats(nullptr), numKeywordsRead(other.numKeywordsRead), numStopWordHits(other.numStopWordHits), numDocuments(other.numDocuments)
+{
+}
+
+/** Overloaded assignment operator for the Concordance class.
+@pre The derived class must have released the nodes in the NodeArena.
+@post The Vocabulary, the WordStream, the stop words, and the maximum lengths will be copies of those on the right side. The NodeArena is left as it is.
+@param rhs The concordance on the right side of the assignment operator. */
+Concordance& Concordance::operator=(const Concordance& rhs)
+{
+   if ( this != &rhs )
+   {
+      maxPreKeyLen = rhs.maxPreKeyLen;
+      maxKeyLen = rhs.maxKeyLen;
+      maxPostKeyLen = rhs.maxPostKeyLen;
+      vocabulary = rhs.vocabulary;
+      words = rhs.words;
+      stopWords = rhs.stopWords;
+      stopWordSet = rhs.stopWordSet;
+      numKeywordsRead = rhs.numKeywordsRead;
+      numStopWordHits = rhs.numStopWordHits;
+      numDocuments = rhs.numDocuments;
+   }
+   return *this;
+}
+
+/** The move constructor for the Concordance class.
+Takes the Vocabulary, the WordStream, the stop words, the maximum lengths, and the blocks of the NodeArena without copying them.
+@param other The concordance to be moved. It may only be destroyed or assigned to afterwards. */
+Concordance::Concordance(Concordance&& other) : maxPreKeyLen(other.maxPreKeyLen), maxKeyLen(other.maxKeyLen), maxPostKeyLen(other.maxPostKeyLen), vocabulary(move(other.vocabulary)), words(move(other.words)), stopWords(other.stopWords), stopWordSet(move(other.stopWordSet)), stats(nullptr), numKeywordsRead(other.numKeywordsRead), numStopWordHits(other.numStopWordHits), numDocuments(other.numDocuments)
+{
+   //the nodes the derived class takes from other live in other's arena
+   nodeArena.adopt(other.nodeArena);
+}
+
+/** Overloaded move assignment operator for the Concordance class.
+@pre The derived class must have released the nodes in the NodeArena.
+@post The Vocabulary, the WordStream, the stop words, the maximum lengths, and the blocks of the NodeArena will be taken from the right side, which may only be destroyed or assigned to afterwards.
+@param rhs The concordance on the right side of the assignment operator. */
+Concordance& Concordance::operator=(Concordance&& rhs)
+{
+   if ( this != &rhs )
+   {
+      maxPreKeyLen = rhs.maxPreKeyLen;
+      maxKeyLen = rhs.maxKeyLen;
+      maxPostKeyLen = rhs.maxPostKeyLen;
+      vocabulary = move(rhs.vocabulary);
+      words = move(rhs.words);
+      stopWords = rhs.stopWords;
+      stopWordSet = move(rhs.stopWordSet);
+      numKeywordsRead = rhs.numKeywordsRead;
+      numStopWordHits = rhs.numStopWordHits;
+      numDocuments = rhs.numDocuments;
+      nodeArena.adopt(rhs.nodeArena);
+   }
+   return *this;
+}
+
+/** The destructor for the Concordance class.
+Destroys the Concordance object when its lifetime ends.*/
+Concordance::~Concordance()
+{
+}
+
+/** Prints a formatted context list for each keyword in alphabetical order.
+@param threads The number of threads to format the rows on.
+@pre threads must be at least 1.
+@return The number of bytes written to standard output.
+@post The context list for each keyword in the concordance will be printed to standard output in alphabetical order based on the keyword, through an OutputWriter. Anything waiting in cout is flushed first. If the concordance is empty, nothing will be printed.*/
+uint64_t Concordance::printConcordance(int threads) const
+{
+   //the writer bypasses cout, so earlier output must reach the descriptor first
+   cout.flush();
+   
+   OutputWriter writer(STDOUT_FILENO);
+   writeConcordance(writer, threads);
+   writer.flush();
+   return writer.getBytesWritten();
+}
+
+/** Writes a formatted context list for each keyword in alphabetical order.
+@param writer The OutputWriter to write the rows to.
+@param threads The number of threads to format the rows on.
+@pre threads must be at least 1.
+@post The writer's columns will be set from the maximum lengths, and the context list for each keyword will be written to it in alphabetical order based on the keyword. With more than one thread, the rows are split into ranges that are formatted in parallel and written to the writer's file descriptor strictly in order, so the output is the same. If the concordance is empty, nothing will be written.*/
+void Concordance::writeConcordance(OutputWriter& writer, int threads) const
+{
+   writer.setColumns(maxPreKeyLen, maxKeyLen, maxPostKeyLen);
+   writer.setDocumentColumn(numDocuments);
+   writeRows(writer, threads);
+}
+
+/** Prints the formatted context lists of the keywords a query matches, in alphabetical order.
+@param query The keywords to print.
+@return The number of bytes written to standard output.
+@pre none
+@post The rows of each matching keyword will be printed to standard output, laid out with the columns of the whole concordance so they are the same as those rows in printConcordance. Anything waiting in cout is flushed first. If no keyword matches, nothing will be printed.*/
+uint64_t Concordance::printMatches(const KeyQuery& query) const
+{
+   //the writer bypasses cout, so earlier output must reach the descriptor first
+   cout.flush();
+   
+   OutputWriter writer(STDOUT_FILENO);
+   writeMatches(writer, query);
+   writer.flush();
+   return writer.getBytesWritten();
+}
+
+/** Writes the formatted context lists of the keywords a query matches, in alphabetical order.
+@param writer The OutputWriter to write the rows to.
+@param query The keywords to write.
+@pre none
+@post The writer's columns will be set from the maximum lengths of the whole concordance, and the context list of each matching keyword will be written to it in alphabetical order based on the keyword.*/
+void Concordance::writeMatches(OutputWriter& writer, const KeyQuery& query) const
+{
+   writer.setColumns(maxPreKeyLen, maxKeyLen, maxPostKeyLen);
+   writer.setDocumentColumn(numDocuments);
+   writeMatchingRows(writer, query);
+}
+
+/**Interns a word from the corpus in the concordance's Vocabulary.
+@param word The word to be interned.
+@return The ID of the word, as it is stored in the WordStream.
+@pre word must be of type string_view.
+@post If the word was not in the Vocabulary, a copy of it will be added and assigned a new ID. */
+Vocabulary::wordId Concordance::internWord(string_view word)
+{
+   return vocabulary.intern(word);
+}
+
+/**Returns the Vocabulary the context word IDs are interned in.
+@return The concordance's Vocabulary.
+@pre none
+@post The Vocabulary will be returned as a const reference. */
+const Vocabulary& Concordance::getVocabulary() const
+{
+   return vocabulary;
+}
+
+/**Returns the WordStream the context lists point into.
+@return The concordance's WordStream.
+@pre none
+@post The WordStream will be returned as a const reference. */
+const WordStream& Concordance::getWords() const
+{
+   return words;
+}
+
+/**Sets aside memory in the concordance's WordStream for words to be appended.
+@param count The number of words that will be appended.
+@pre none
+@post Appending up to count words will not move the WordStream. */
+void Concordance::reserveWords(uint64_t count)
+{
+   words.reserve(count);
+}
+
+/**Makes room at the end of the concordance's WordStream for a run of another concordance's words, to be filled in by remapWords.
+@param other The concordance whose words are appended.
+@param first The position in other's WordStream of the first word appended.
+@param last The position in other's WordStream one past the last word appended.
+@return The number added to a position in other's WordStream to give the position of the same word in this concordance's.
+@pre other must not be this concordance.
+@post The WordStream will end with room for the words, in their documents. */
+int64_t Concordance::placeWords(const Concordance& other, uint64_t first, uint64_t last)
+{
+   return words.appendRun(other.words, first, last);
+}
+
+/**Copies a run of another concordance's words into the room made for it by placeWords, in this concordance's IDs.
+@param other The concordance whose words are copied.
+@param first The position in other's WordStream of the first word copied.
+@param last The position in other's WordStream one past the last word copied.
+@param shift The number returned by placeWords for the run.
+@param newIds The ID in this concordance's Vocabulary of each word, indexed by its ID in other's, as returned by mapVocabulary.
+@pre placeWords must have made room for the run. Runs placed one after another may be copied on different threads at once, as long as nothing is appended to the WordStream meanwhile.
+@post The room will hold the words of the run. */
+void Concordance::remapWords(const Concordance& other, uint64_t first, uint64_t last, int64_t shift, const vector<Vocabulary::wordId>& newIds)
+{
+   words.remapRun(other.words, first, last, shift, newIds);
+}
+
+/**Interns every word of another Vocabulary in the concordance's Vocabulary.
+@param other The Vocabulary whose words are interned.
+@return The ID in this concordance's Vocabulary of each word, indexed by its ID in other.
+@pre none
+@post Every word of other will be in the concordance's Vocabulary. Vocabulary::EMPTY_WORD is mapped to itself. */
+vector<Vocabulary::wordId> Concordance::mapVocabulary(const Vocabulary& other)
+{
+   vector<Vocabulary::wordId> newIds(other.size());
+   
+   //the empty word is ID 0 in every Vocabulary
+   newIds[Vocabulary::EMPTY_WORD] = Vocabulary::EMPTY_WORD;
+   for (int id = 1; id < other.size(); id++)
+      newIds[id] = vocabulary.intern(other.getWord(id));
+   return newIds;
+}
+
+/**Takes over the nodes of another concordance, so context lists moved from it stay valid after it is destroyed.
+@param other The concordance whose NodeArena is taken.
+@pre other must not be this concordance.
+@post The nodes created in other's NodeArena will be released with this concordance. other must not create or use nodes after this. */
+void Concordance::adoptNodes(Concordance& other)
+{
+   nodeArena.adopt(other.nodeArena);
+}
+
+/**Updates the maximum lengths with the maximum lengths of another concordance.
+@param other The concordance whose maximum lengths are merged in.
+@pre none
+@post Each maximum length, and the highest document number, will be the larger of its value in this concordance and in other. */
+void Concordance::mergeMaxLengths(const Concordance& other)
+{
+   maxPreKeyLen = max(maxPreKeyLen, other.maxPreKeyLen);
+   maxKeyLen = max(maxKeyLen, other.maxKeyLen);
+   maxPostKeyLen = max(maxPostKeyLen, other.maxPostKeyLen);
+   numDocuments = max(numDocuments, other.numDocuments);
+}
+
+/**Sets the document the words added next are read from.
+@param documentNumber The number of the document, counting from 1.
+@pre none
+@post The words read next will be in the document, so their contexts carry its number, and the rows will be printed with a document column wide enough for the highest number set. */
+void Concordance::setDocument(uint32_t documentNumber)
+{
+   words.startDocument(documentNumber);
+   numDocuments = max(numDocuments, documentNumber);
+}
+
+/**Sets the boolean value stopWords and fills the stopword set with stopwords.
+ @param stopWordFile The file to read the stop words from.
+ @param useBuiltIn True to fall back to the built-in stop word list if the file gives no stop words.
+ @return True if stop words will be excluded, from the file or from the built-in list. False otherwise.
+ @pre The stopWordFile must be of type string.
+ @post If a stopword file exists, could be read from, and contains at least 1 string, the stopword set will contain the string(s) in the stop word file, the boolean value stopWords will be set to true, and true will be returned. Otherwise, if useBuiltIn is true the set will use the built-in stop word list and true will be returned. If neither applies, the set will be empty, stopWords will be set to false, and false will be returned. */
+bool Concordance::excludeStopWords(const string& stopWordFile, bool useBuiltIn)
+{
+   //if stopwords file doesn't exist, couldn't be read from, or does not
+   //contain strings, set boolean value stopWords to false
+   stopWords = buildStopWordSet(stopWordFile);
+   
+   //no stop words in a file, use the list compiled into the program instead
+   if ( !stopWords && useBuiltIn )
+   {
+      stopWordSet.useBuiltInList();
+      stopWords = true;
+   }
+   return stopWords;
+}
+
+/**Sets the boolean value stopWords and fills the stopword set with a list of stop words.
+@param stopWordList The stop words, already stripped of punctuation and lowercase.
+@return True if stop words will be excluded, false if the list is empty.
+@pre none
+@post The stopword set will contain exactly the words of the list, and stopWords will be true if there is at least one. */
+bool Concordance::setStopWords(const vector<string>& stopWordList)
+{
+   stopWordSet.clear();
+   for (size_t w = 0; w < stopWordList.size(); w++)
+      stopWordSet.insert(stopWordList[w]);
+   stopWords = stopWordSet.size() != 0;
+   return stopWords;
+}
+
+/**Returns the set of stop words left out of the concordance.
+@return The stopword set, empty if no stop words are excluded.
+@pre none
+@post The set is unchanged. */
+const StopWordSet& Concordance::getStopWords() const
+{
+   return stopWordSet;
+}
+
+/** Checks if the given word is a word in the stopword set.
+ @param word The word to be checked, stripped of punctuation and lowercase.
+ @return True if the word is a stopword, false otherwise.
+ @pre The word must be of type string_view.
+ @post True will be returned if the word is found in the stopword set, otherwise false will be returned.
+ */
+bool Concordance::isStopWord(string_view word) const
+{
+   return stopWordSet.contains(word);
+}
+
+/**Builds the set of stop words.
+ @param stopWordFile The name of the file containing the stop words.
+ @return True if the file exists, could be opened, and the set was filled with at least one string. False if the file does not exist, could not be opened, or the file contained no strings.
+ @pre The stopword file must be located in the same directory as the executable. The argument must be of type string.
+ @post If the stopword file exists and could be read, the stopWordSet will contain the stop words in the file, stripped of punctuation and lowercase. If the file does not contain strings, or does not exist or could not be opened, the set will remain empty and false will be returned.
+ */
+bool Concordance::buildStopWordSet(const string& stopWordFile)
+{
+   stopWordSet.clear();
+   
+   ifstream fileReader(stopWordFile);
+   
+   //cannot open file
+   if ( !fileReader.is_open() )
+   {
+      return false;
+   }
+   //the stopword to be read from the file
+   string stopWord;
+   
+   //continue reading until end of file
+   while ( !fileReader.eof() )
+   {
+      //read each stopword in the file
+      if ( fileReader >> stopWord )
+      {
+         //strip stopword of punctuation and make lowercase
+         removePunctAndLower(stopWord);
+         
+         //add stopword to the set, duplicates are only stored once
+         stopWordSet.insert(stopWord);
+      }
+   }
+   
+   //the set is empty, no strings in the stopword file
+   if ( stopWordSet.size() == 0 )
+      return false;
+   else
+      return true;
+}
+
+/**Strips a word of punctuation and makes it lowercase.
+ @param word The word to be reformatted.
+ @pre The word must be of type string.
+ @post The word will be stripped of punctuation and be lowercase.
+ */
+void Concordance::removePunctAndLower(string& word)
+{
+   //one pass over the word, in place
+   Normalizer::normalize(word);
+}
+
+/**Copies a word with its punctuation stripped and in lowercase.
+ @param word The word to be reformatted.
+ @param cleaned The string to store the reformatted word in.
+ @pre The word must be of type string_view and must not view cleaned.
+ @post cleaned will contain the word stripped of punctuation and in lowercase. The word itself is unchanged.
+ */
+void Concordance::removePunctAndLower(string_view word, string& cleaned)
+{
+   //one pass over the word, reusing cleaned's capacity
+   Normalizer::normalize(word, cleaned);
+}
+
+/**Checks if a lone character in the corpus is a punctuation symbol.
+ @param word The word to be checked.
+ @return True will be returned if the word is a punctuation symbol. False otherwise.
+ @pre The word must be of type string_view.
+ @post True will be returned if the word is a single ASCII punctuation character or the UTF-8 sequence of a single Unicode punctuation character. False otherwise.
+ */
+bool Concordance::isPunct(string_view word)
+{
+   return Normalizer::isPunctSymbol(word);
+}
+
+/**Attaches a RunStats that samples the time of the stages of add.
+@param runStats The RunStats, or nullptr to stop sampling.
+@pre runStats must outlive the concordance, or be detached first.
+@post One add in RunStats::SAMPLE_INTERVAL will time its stages into runStats. Without a RunStats, add only checks for one. */
+void Concordance::setStats(RunStats* runStats)
+{
+   stats = runStats;
+}
+
+/**Adds the counters of the concordance to a report.
+@param runStats The RunStats the counters are set in.
+@pre none
+@post The report will hold the number of keywords read, stop words skipped, rows, and distinct words, and the bytes held by the WordStream and the NodeArena. Engines add counters of their own. */
+void Concordance::collectStats(RunStats& runStats) const
+{
+   runStats.setCounter("tokens", (double)numKeywordsRead);
+   runStats.setCounter("stop_word_hits", (double)numStopWordHits);
+   runStats.setCounter("rows", (double)(numKeywordsRead - numStopWordHits));
+   runStats.setCounter("distinct_words", (double)(vocabulary.size() - 1));
+   runStats.setCounter("stream_bytes", (double)words.getBytes());
+   runStats.setCounter("arena_bytes", (double)nodeArena.getBlockBytes());
+}
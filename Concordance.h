@@ -0,0 +1,289 @@
+/*
+file name: Concordance.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the Concordance class. The Concordance class is the abstract base class of the concordance engines. It holds everything the engines share: the Vocabulary and the WordStream the contexts are read from, the stop words, the maximum column lengths used to format the output, and the rules for cleaning words read from the corpus. It does not depend on the size of the contexts: WindowedConcordance adds the contexts of a given window, and the engines derived from it decide how the keywords and their context lists are indexed and how they are put in alphabetical order for printing.
+*/
+
+#ifndef CONCORDANCE_H
+#define CONCORDANCE_H
+
+#include <vector>
+#include <string_view>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include "ContextList.h"
+#include "WordStream.h"
+#include "CorpusReader.h"
+#include "Normalizer.h"
+#include "StopWordSet.h"
+#include "KeyQuery.h"
+#include "RunStats.h"
+
+class Concordance
+{
+   
+public:
+   
+   /** The default constructor for the Concordance class.
+   Constructs an empty Concordance object.
+   maxPreKeyLen, maxKeyLen, maxPostKeyLen are initialized to 0, and stopWords is initialized to false. */
+   Concordance();
+   
+   /** The copy constructor for the Concordance class.
+   Copies the Vocabulary, the WordStream, the stop words, and the maximum lengths. The copy starts with an empty NodeArena, the derived class copies the nodes into it.
+   @param other The concordance to be copied. */
+   Concordance(const Concordance& other);
+   
+   /** Overloaded assignment operator for the Concordance class.
+   @pre The derived class must have released the nodes in the NodeArena.
+   @post The Vocabulary, the WordStream, the stop words, and the maximum lengths will be copies of those on the right side. The NodeArena is left as it is.
+   @param rhs The concordance on the right side of the assignment operator. */
+   Concordance& operator=(const Concordance& rhs);
+   
+   /** The move constructor for the Concordance class.
+   Takes the Vocabulary, the WordStream, the stop words, the maximum lengths, and the blocks of the NodeArena without copying them.
+   @param other The concordance to be moved. It may only be destroyed or assigned to afterwards. */
+   Concordance(Concordance&& other);
+   
+   /** Overloaded move assignment operator for the Concordance class.
+   @pre The derived class must have released the nodes in the NodeArena.
+   @post The Vocabulary, the WordStream, the stop words, the maximum lengths, and the blocks of the NodeArena will be taken from the right side, which may only be destroyed or assigned to afterwards.
+   @param rhs The concordance on the right side of the assignment operator. */
+   Concordance& operator=(Concordance&& rhs);
+   
+   /** The destructor for the Concordance class.
+   Destroys the Concordance object when its lifetime ends.*/
+   virtual ~Concordance();
+   
+   /** Tests whether the concordance is empty.
+   @return True if the concordance contains no keywords, false otherwise.
+   @pre none
+   @post Returns true if the concordance is empty, false otherwise.*/
+   virtual bool isEmpty() const = 0;
+   
+   /** Returns the number of context words before each keyword.
+   @return The number of words before the keyword in every context of the concordance. */
+   virtual int getWordsBefore() const = 0;
+   
+   /** Returns the number of context words after each keyword.
+   @return The number of words after the keyword in every context of the concordance. */
+   virtual int getWordsAfter() const = 0;
+   
+   /**Adds every word of a corpus, with its context, to the concordance.
+   @param reader The CorpusReader the corpus is open in.
+   @param threads The number of threads to read the corpus on.
+   @pre threads must be at least 1, and the concordance must be empty if it is more. The stop words must already be set.
+   @post Every word of the corpus that is not a lone punctuation symbol will have been added as a keyword with its context, in corpus order. */
+   virtual void addCorpus(CorpusReader& reader, int threads) = 0;
+   
+   /**Adds every word of a list of documents, with its context, to the concordance, numbering the documents from 1 in the order given.
+   @param documents The names of the document files.
+   @param threads The number of threads to read the documents on.
+   @param unreadable Set to the name of the first document that could not be opened.
+   @return True if every document was read, false if one could not be opened.
+   @pre threads must be at least 1, and the concordance must be empty if it is more. The stop words must already be set.
+   @post Every word of each document that is not a lone punctuation symbol will have been added as a keyword with its context and the number of its document. No context reaches across the end of a document, and the contexts of a keyword are in document order, then in the order they appear in the document. */
+   virtual bool addDocuments(const vector<string>& documents, int threads, string& unreadable) = 0;
+   
+   /**Sets the document the words added next are read from.
+   @param documentNumber The number of the document, counting from 1.
+   @pre none
+   @post The words read next will be in the document, so their contexts carry its number, and the rows will be printed with a document column wide enough for the highest number set. */
+   void setDocument(uint32_t documentNumber);
+   
+   /** Prints a formatted context list for each keyword in alphabetical order.
+   @param threads The number of threads to format the rows on.
+   @pre threads must be at least 1.
+   @return The number of bytes written to standard output.
+   @post The context list for each keyword in the concordance will be printed to standard output in alphabetical order based on the keyword, through an OutputWriter. Anything waiting in cout is flushed first. If the concordance is empty, nothing will be printed.*/
+   uint64_t printConcordance(int threads = 1) const;
+   
+   /** Writes a formatted context list for each keyword in alphabetical order.
+   @param writer The OutputWriter to write the rows to.
+   @param threads The number of threads to format the rows on.
+   @pre threads must be at least 1.
+   @post The writer's columns will be set from the maximum lengths, and the context list for each keyword will be written to it in alphabetical order based on the keyword. With more than one thread, the rows are split into ranges that are formatted in parallel and written to the writer's file descriptor strictly in order, so the output is the same. If the concordance is empty, nothing will be written.*/
+   void writeConcordance(OutputWriter& writer, int threads = 1) const;
+   
+   /** Prints the formatted context lists of the keywords a query matches, in alphabetical order.
+   @param query The keywords to print.
+   @return The number of bytes written to standard output.
+   @pre none
+   @post The rows of each matching keyword will be printed to standard output, laid out with the columns of the whole concordance so they are the same as those rows in printConcordance. Anything waiting in cout is flushed first. If no keyword matches, nothing will be printed.*/
+   uint64_t printMatches(const KeyQuery& query) const;
+   
+   /** Writes the formatted context lists of the keywords a query matches, in alphabetical order.
+   @param writer The OutputWriter to write the rows to.
+   @param query The keywords to write.
+   @pre none
+   @post The writer's columns will be set from the maximum lengths of the whole concordance, and the context list of each matching keyword will be written to it in alphabetical order based on the keyword.*/
+   void writeMatches(OutputWriter& writer, const KeyQuery& query) const;
+   
+   /**Interns a word from the corpus in the concordance's Vocabulary.
+   @param word The word to be interned.
+   @return The ID of the word, as it is stored in the WordStream.
+   @pre word must be of type string_view.
+   @post If the word was not in the Vocabulary, a copy of it will be added and assigned a new ID. */
+   Vocabulary::wordId internWord(string_view word);
+   
+   /**Returns the Vocabulary the context word IDs are interned in.
+   @return The concordance's Vocabulary.
+   @pre none
+   @post The Vocabulary will be returned as a const reference. */
+   const Vocabulary& getVocabulary() const;
+   
+   /**Returns the WordStream the context lists point into.
+   @return The concordance's WordStream.
+   @pre none
+   @post The WordStream will be returned as a const reference. */
+   const WordStream& getWords() const;
+   
+   /**Sets aside memory in the concordance's WordStream for words to be appended.
+   @param count The number of words that will be appended.
+   @pre none
+   @post Appending up to count words will not move the WordStream. */
+   void reserveWords(uint64_t count);
+   
+   /**Makes room at the end of the concordance's WordStream for a run of another concordance's words, to be filled in by remapWords.
+   @param other The concordance whose words are appended.
+   @param first The position in other's WordStream of the first word appended.
+   @param last The position in other's WordStream one past the last word appended.
+   @return The number added to a position in other's WordStream to give the position of the same word in this concordance's.
+   @pre other must not be this concordance.
+   @post The WordStream will end with room for the words, in their documents. */
+   int64_t placeWords(const Concordance& other, uint64_t first, uint64_t last);
+   
+   /**Copies a run of another concordance's words into the room made for it by placeWords, in this concordance's IDs.
+   @param other The concordance whose words are copied.
+   @param first The position in other's WordStream of the first word copied.
+   @param last The position in other's WordStream one past the last word copied.
+   @param shift The number returned by placeWords for the run.
+   @param newIds The ID in this concordance's Vocabulary of each word, indexed by its ID in other's, as returned by mapVocabulary.
+   @pre placeWords must have made room for the run. Runs placed one after another may be copied on different threads at once, as long as nothing is appended to the WordStream meanwhile.
+   @post The room will hold the words of the run. */
+   void remapWords(const Concordance& other, uint64_t first, uint64_t last, int64_t shift, const vector<Vocabulary::wordId>& newIds);
+   
+   /**Interns every word of another Vocabulary in the concordance's Vocabulary.
+   @param other The Vocabulary whose words are interned.
+   @return The ID in this concordance's Vocabulary of each word, indexed by its ID in other.
+   @pre none
+   @post Every word of other will be in the concordance's Vocabulary. Vocabulary::EMPTY_WORD is mapped to itself. */
+   vector<Vocabulary::wordId> mapVocabulary(const Vocabulary& other);
+   
+   /**Takes over the nodes of another concordance, so context lists moved from it stay valid after it is destroyed.
+   @param other The concordance whose NodeArena is taken.
+   @pre other must not be this concordance.
+   @post The nodes created in other's NodeArena will be released with this concordance. other must not create or use nodes after this. */
+   void adoptNodes(Concordance& other);
+   
+   /**Updates the maximum lengths with the maximum lengths of another concordance.
+   @param other The concordance whose maximum lengths are merged in.
+   @pre none
+   @post Each maximum length, and the highest document number, will be the larger of its value in this concordance and in other. */
+   void mergeMaxLengths(const Concordance& other);
+   
+   /**Builds the set of stop words.
+   @param stopWordFile The name of the file containing the stop words.
+   @return True if the file exists, could be opened, and the set was filled with at least one string. False if the file does not exist, could not be opened, or the file contained no strings.
+   @pre The stopword file must be located in the same directory as the executable. The argument must be of type string.
+   @post If the stopword file exists and could be read, the stopWordSet will contain the stop words in the file, stripped of punctuation and lowercase. If the file does not contain strings, or does not exist or could not be opened, the set will remain empty and false will be returned.
+   */
+   bool buildStopWordSet(const string& stopWordFile);
+   
+   /**Sets the boolean value stopWords and fills the stopword set with stopwords.
+   @param stopWordFile The file to read the stop words from.
+   @param useBuiltIn True to fall back to the built-in stop word list if the file gives no stop words.
+   @return True if stop words will be excluded, from the file or from the built-in list. False otherwise.
+   @pre The stopWordFile must be of type string.
+   @post If a stopword file exists, could be read from, and contains at least 1 string, the stopword set will contain the string(s) in the stop word file, the boolean value stopWords will be set to true, and true will be returned. Otherwise, if useBuiltIn is true the set will use the built-in stop word list and true will be returned. If neither applies, the set will be empty, stopWords will be set to false, and false will be returned. */
+   bool excludeStopWords(const string& stopWordFile, bool useBuiltIn = false);
+   
+   /**Sets the boolean value stopWords and fills the stopword set with a list of stop words.
+   @param stopWordList The stop words, already stripped of punctuation and lowercase.
+   @return True if stop words will be excluded, false if the list is empty.
+   @pre none
+   @post The stopword set will contain exactly the words of the list, and stopWords will be true if there is at least one. */
+   bool setStopWords(const vector<string>& stopWordList);
+   
+   /**Returns the set of stop words left out of the concordance.
+   @return The stopword set, empty if no stop words are excluded.
+   @pre none
+   @post The set is unchanged. */
+   const StopWordSet& getStopWords() const;
+   
+   /** Checks if the given word is a word in the stopword set.
+   @param word The word to be checked, stripped of punctuation and lowercase.
+   @return True if the word is a stopword, false otherwise.
+   @pre The word must be of type string_view.
+   @post True will be returned if the word is found in the stopword set, otherwise false will be returned.
+   */
+   bool isStopWord(string_view word) const;
+   
+   /**Checks if a lone character in the corpus is a punctuation symbol.
+   @param word The word to be checked.
+   @return True will be returned if the word is a punctuation symbol. False otherwise.
+   @pre The word must be of type string_view.
+   @post True will be returned if the word is a single ASCII punctuation character or the UTF-8 sequence of a single Unicode punctuation character. False otherwise.
+   */
+   bool static isPunct(string_view word);
+   
+   /**Strips a word of punctuation and makes it lowercase.
+   @param word The word to be reformatted.
+   @pre The word must be of type string.
+   @post The word will be stripped of punctuation and be lowercase.
+   */
+   void static removePunctAndLower(string& word);
+   
+   /**Copies a word with its punctuation stripped and in lowercase.
+   @param word The word to be reformatted.
+   @param cleaned The string to store the reformatted word in.
+   @pre The word must be of type string_view and must not view cleaned.
+   @post cleaned will contain the word stripped of punctuation and in lowercase. The word itself is unchanged.
+   */
+   void static removePunctAndLower(string_view word, string& cleaned);
+   
+   /**Attaches a RunStats that samples the time of the stages of add.
+   @param runStats The RunStats, or nullptr to stop sampling.
+   @pre runStats must outlive the concordance, or be detached first.
+   @post One add in RunStats::SAMPLE_INTERVAL will time its stages into runStats. Without a RunStats, add only checks for one. */
+   void setStats(RunStats* runStats);
+   
+   /**Adds the counters of the concordance to a report.
+   @param runStats The RunStats the counters are set in.
+   @pre none
+   @post The report will hold the number of keywords read, stop words skipped, rows, and distinct words, and the bytes held by the WordStream and the NodeArena. Engines add counters of their own. */
+   virtual void collectStats(RunStats& runStats) const;
+   
+protected:
+   /** Writes the rows of every keyword in alphabetical order, from the context lists in memory.
+   @param writer The OutputWriter to write the rows to, with its columns set.
+   @param threads The number of threads to format the rows on.
+   @pre threads must be at least 1.
+   @post The rows of every keyword will be written in alphabetical order, and in corpus order within a keyword. With more than one thread, the rows are split into ranges that are formatted in parallel and written to the writer's file descriptor strictly in order. */
+   virtual void writeRows(OutputWriter& writer, int threads) const = 0;
+   
+   /** Writes the rows of the keywords a query matches in alphabetical order, from the context lists in memory.
+   @param writer The OutputWriter to write the rows to, with its columns set.
+   @param query The keywords to write.
+   @pre none
+   @post The rows of every matching keyword will be written in alphabetical order, and in corpus order within a keyword. */
+   virtual void writeMatchingRows(OutputWriter& writer, const KeyQuery& query) const = 0;
+   
+   int maxPreKeyLen; //length of longest string of context words before keyword in the concordance
+   int maxKeyLen; //length of longest keyword in the concordance
+   int maxPostKeyLen; //length of longest string of context words after keyword in the concordance
+   Vocabulary vocabulary; //the words the WordStream refers to by ID
+   WordStream words; //the words read, in corpus order, the context lists hold positions in it
+   NodeArena nodeArena; //arena the engine's nodes are created in, released in bulk when the concordance is destroyed
+   bool stopWords; //true if excluding stopwords
+   StopWordSet stopWordSet; //hashed set of the stopwords
+   string cleanedKey; //buffer the keyword is cleaned into by add, reused so adding does not allocate
+   RunStats* stats; //samples the stages of add, or nullptr
+   uint64_t numKeywordsRead; //keywords added, stop words included
+   uint64_t numStopWordHits; //keywords left out as stop words
+   uint32_t numDocuments; //highest document number added, 0 for a single corpus
+};
+
+#endif
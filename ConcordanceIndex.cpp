@@ -0,0 +1,707 @@
+/*
+file name: ConcordanceIndex.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the ConcordanceIndex class. A ConcordanceIndex is a concordance saved to a binary file that is mapped into memory as it is, so it can be used again without reading the corpus or building a tree. The file is a series of segments, one for the text the index was built from and one for each text appended to it since. Each segment holds its own words, its part of the corpus as one word ID per word, a directory of its keywords in alphabetical order, for each keyword the positions of its occurrences in the whole corpus, in corpus order, and the stop words it was built with, so an appended text leaves out the same stop words as the rest of the index. A row is rebuilt by reading the words of the window on either side of an occurrence from the stored corpus, crossing into the segments before or after it as needed, so the rows next to the end of one segment see the words of the next. Opening an index checks every offset, count, word ID and position in it against the bounds of its segment, in one pass over the file, so a damaged file is refused instead of read out of bounds. The window of context is saved with the index, and its rows are rebuilt by the code compiled for that window.
+*/
+
+#include "ConcordanceIndex.h"
+
+#include <fstream>
+#include <unordered_map>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "CorpusReader.h"
+#include "StringSort.h"
+
+using namespace std;
+
+/** The default constructor for the ConcordanceIndex class.
+Constructs a ConcordanceIndex with no file open. */
+ConcordanceIndex::ConcordanceIndex() : mapping(nullptr), mappedSize(0), maxPreKeyLen(0), maxKeyLen(0), maxPostKeyLen(0), wordsBefore(0), wordsAfter(0)
+{
+}
+
+/** The destructor for the ConcordanceIndex class.
+Unmaps the index file when its lifetime ends. */
+ConcordanceIndex::~ConcordanceIndex()
+{
+   close();
+}
+
+/**Builds the index of a corpus and saves it to a file.
+@param corpus The text of the corpus.
+@param concordance The concordance whose stop words are left out of the index and whose window the index is built with.
+@param indexFile The name of the file to save the index to.
+@return True if the index was saved, false if the file could not be written.
+@pre none
+@post The file will hold an index with one segment that prints the same concordance as concordance would after reading the corpus. */
+bool ConcordanceIndex::build(string_view corpus, const Concordance& concordance, const string& indexFile)
+{
+   ofstream out(indexFile, ios::binary | ios::trunc);
+   if ( !out.is_open() )
+      return false;
+
+   bool written = writeSegment(corpus, concordance, vector<string>(), 0, concordance.getWordsBefore(), concordance.getWordsAfter(), out);
+   out.close();
+   return written && !out.fail();
+}
+
+/**Opens an index file and maps it into memory.
+@param indexFile The name of the index file.
+@return True if the file could be mapped and has the layout of an index, false otherwise.
+@pre none
+@post If true is returned, the index can be read. Any index opened before will be closed. Every offset, count, word ID and position in each segment is checked against the bounds of the segment, so a damaged file is refused instead of read out of bounds. Every segment must have the same window, one the program is compiled for. */
+bool ConcordanceIndex::open(const string& indexFile)
+{
+   close();
+
+   int fd = ::open(indexFile.c_str(), O_RDONLY);
+   if ( fd < 0 )
+      return false;
+
+   struct stat info;
+   if ( fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || (size_t)info.st_size < sizeof(Header) )
+   {
+      ::close(fd);
+      return false;
+   }
+   void* addr = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   ::close(fd);
+   if ( addr == MAP_FAILED )
+      return false;
+   mapping = addr;
+   mappedSize = (size_t)info.st_size;
+
+   //walk the segments, each must start where the one before it ends, in the file and in the corpus
+   const char* base = (const char*)addr;
+   size_t at = 0;
+   uint64_t nextToken = 0;
+   uint64_t longestWord = 0;
+   while ( at < mappedSize )
+   {
+      const Header* header = (const Header*)(base + at);
+      uint64_t segmentBytes = mappedSize - at >= sizeof(Header) ? header->segmentBytes : 0;
+
+      //checks that a part of the segment starts on a multiple of 8 and ends inside the segment
+      auto fits = [&](uint64_t partAt, uint64_t count, uint64_t size)
+      {
+         return partAt % 8 == 0 && partAt <= segmentBytes && count <= (segmentBytes - partAt) / size;
+      };
+
+      if ( segmentBytes < sizeof(Header) || segmentBytes % 8 != 0 || segmentBytes > mappedSize - at
+          || memcmp(header->magic, "KWICIDX", 8) != 0 || header->version != VERSION
+          || header->firstToken != nextToken || header->numWords == 0
+          || !isCompiledWindow(header->wordsBefore, header->wordsAfter)
+          || (at != 0 && (header->wordsBefore != wordsBefore || header->wordsAfter != wordsAfter))
+          || !fits(header->wordOffsetsAt, header->numWords + 1, sizeof(uint64_t))
+          || !fits(header->wordTextAt, 0, 1)
+          || !fits(header->tokensAt, header->numTokens, sizeof(uint32_t))
+          || !fits(header->keysAt, header->numKeys, sizeof(KeyEntry))
+          || !fits(header->keyTextAt, 0, 1)
+          || !fits(header->occurrencesAt, header->numOccurrences, sizeof(uint64_t))
+          || !fits(header->stopWordOffsetsAt, header->numStopWords + 1, sizeof(uint64_t))
+          || !fits(header->stopWordTextAt, 0, 1) )
+      {
+         close();
+         return false;
+      }
+
+      const char* segmentBase = base + at;
+      Segment segment;
+      segment.header = header;
+      segment.wordOffsets = (const uint64_t*)(segmentBase + header->wordOffsetsAt);
+      segment.wordText = segmentBase + header->wordTextAt;
+      segment.tokens = (const uint32_t*)(segmentBase + header->tokensAt);
+      segment.keys = (const KeyEntry*)(segmentBase + header->keysAt);
+      segment.keyText = segmentBase + header->keyTextAt;
+      segment.occurrences = (const uint64_t*)(segmentBase + header->occurrencesAt);
+      segment.stopWordOffsets = (const uint64_t*)(segmentBase + header->stopWordOffsetsAt);
+      segment.stopWordText = segmentBase + header->stopWordTextAt;
+
+      //the contents are only trusted once every offset, ID and position in them has been checked
+      if ( !checkSegment(segment, longestWord)
+          || header->maxPreKeyLen < 0 || (uint64_t)header->maxPreKeyLen > longestWord * (uint64_t)header->wordsBefore
+          || header->maxKeyLen < 0 || (uint64_t)header->maxKeyLen > longestWord
+          || header->maxPostKeyLen < 0 || (uint64_t)header->maxPostKeyLen > longestWord * (uint64_t)header->wordsAfter )
+      {
+         close();
+         return false;
+      }
+      segments.push_back(segment);
+
+      maxPreKeyLen = max(maxPreKeyLen, (int)header->maxPreKeyLen);
+      maxKeyLen = max(maxKeyLen, (int)header->maxKeyLen);
+      maxPostKeyLen = max(maxPostKeyLen, (int)header->maxPostKeyLen);
+      wordsBefore = header->wordsBefore;
+      wordsAfter = header->wordsAfter;
+      nextToken += header->numTokens;
+      at += segmentBytes;
+   }
+
+   fileName = indexFile;
+   return true;
+}
+
+/**Adds the words of a text to the end of the corpus of the open index.
+@param text The text appended to the corpus.
+@param concordance The concordance whose stop words are left out of the index.
+@return True if the text was added, false if the index file could not be written.
+@pre An index must be open, and concordance must exclude the stop words returned by getStopWords.
+@post A segment for the text will be added to the end of the index file, which is opened again. The index will print the same concordance as one built from the old corpus followed by white space and the text. The segment has the window of the index, whatever the window of concordance. Only the text and the last few words before it are read, so the cost does not depend on the size of the index. If the file could not be written, it is left as it was. */
+bool ConcordanceIndex::append(string_view text, const Concordance& concordance)
+{
+   //the rows of the last words get their words after the keyword from the text, and the first rows of the text their words before it
+   uint64_t numTokens = getNumTokens();
+   uint64_t numPrevious = (uint64_t)max(wordsBefore, wordsAfter);
+   vector<string> previousWords;
+   for (uint64_t t = numTokens < numPrevious ? 0 : numTokens - numPrevious; t < numTokens; t++)
+      previousWords.push_back(string(getToken(t)));
+
+   string indexFile = fileName;
+   size_t oldSize = mappedSize;
+   int before = wordsBefore;
+   int after = wordsAfter;
+   close();
+
+   ofstream out(indexFile, ios::binary | ios::app);
+   bool written = out.is_open() && writeSegment(text, concordance, previousWords, numTokens, before, after, out);
+   out.close();
+   written = written && !out.fail();
+
+   //a partly written segment would make the whole file unreadable
+   if ( !written && truncate(indexFile.c_str(), (off_t)oldSize) != 0 )
+      return false;
+   return open(indexFile) && written;
+}
+
+/**Unmaps the index file.
+@pre none
+@post No index will be open. */
+void ConcordanceIndex::close()
+{
+   if ( mapping != nullptr )
+      munmap(mapping, mappedSize);
+   mapping = nullptr;
+   mappedSize = 0;
+   segments.clear();
+   fileName.clear();
+   maxPreKeyLen = maxKeyLen = maxPostKeyLen = 0;
+   wordsBefore = wordsAfter = 0;
+}
+
+/** Tests whether the index has no keywords.
+@return True if the index has no keywords, false otherwise.
+@pre An index must be open.
+@post Returns true if no segment has a keyword, false otherwise.*/
+bool ConcordanceIndex::isEmpty() const
+{
+   for (size_t s = 0; s < segments.size(); s++)
+   {
+      if ( segments[s].header->numKeys != 0 )
+         return false;
+   }
+   return true;
+}
+
+/**Returns the number of words in the corpus of the index.
+@return The number of words, not counting punctuation.
+@pre An index must be open.
+@post The number of words will be returned as a uint64_t. */
+uint64_t ConcordanceIndex::getNumTokens() const
+{
+   if ( segments.empty() )
+      return 0;
+   return segments.back().header->firstToken + segments.back().header->numTokens;
+}
+
+/**Returns the number of segments in the index.
+@return The number of segments, one more than the number of texts appended.
+@pre An index must be open.
+@post The number of segments will be returned as a size_t. */
+size_t ConcordanceIndex::getNumSegments() const
+{
+   return segments.size();
+}
+
+/**Returns the stop words the index was built with.
+@param stopWords Set to the stop words left out of the first segment, stripped of punctuation and lowercase.
+@pre An index must be open.
+@post stopWords will be empty if the index was built without stop words. Appending keeps the stop words of the first segment, so every segment leaves out the same ones. */
+void ConcordanceIndex::getStopWords(vector<string>& stopWords) const
+{
+   const Segment& first = segments.front();
+   stopWords.clear();
+   for (uint64_t s = 0; s < first.header->numStopWords; s++)
+      stopWords.push_back(string(first.stopWordText + first.stopWordOffsets[s], first.stopWordOffsets[s + 1] - first.stopWordOffsets[s]));
+}
+
+/**Returns the number of context words before each keyword in the index.
+@return The number of words before the keyword in every row.
+@pre An index must be open.
+@post The number of words will be returned as an int. */
+int ConcordanceIndex::getWordsBefore() const
+{
+   return wordsBefore;
+}
+
+/**Returns the number of context words after each keyword in the index.
+@return The number of words after the keyword in every row.
+@pre An index must be open.
+@post The number of words will be returned as an int. */
+int ConcordanceIndex::getWordsAfter() const
+{
+   return wordsAfter;
+}
+
+/**Rebuilds the words of the row of a keyword occurrence from the stored corpus.
+@param position The position of the occurrence in the corpus, counted in words.
+@param words Set to the words of the row, with the keyword as it appears in the corpus at index BEFORE.
+@pre position must be less than getNumTokens(). BEFORE and AFTER must be the window of the index.
+@post Words before the first word or after the last word of the corpus will be empty. */
+template <int BEFORE, int AFTER>
+void ConcordanceIndex::getRow(uint64_t position, OutputWriter::rowWords<BEFORE, AFTER>& words) const
+{
+   uint64_t numTokens = getNumTokens();
+   for (int i = 0; i < ListNode<BEFORE, AFTER>::NUM_WORDS; i++)
+   {
+      //the word i - BEFORE places from the keyword, if there is one
+      uint64_t t = position + (uint64_t)i - BEFORE;
+      bool inCorpus = position + (uint64_t)i >= BEFORE && t < numTokens;
+      //an empty word still points at characters, since its data is copied with memcpy
+      words[i] = inCorpus ? getToken(t) : string_view("");
+   }
+}
+
+/** Prints the concordance stored in the index to standard output.
+@return The number of bytes written to standard output.
+@pre An index must be open.
+@post Every row will be printed in the same order and layout as Concordance::printConcordance prints them. Anything waiting in cout is flushed first. */
+uint64_t ConcordanceIndex::printConcordance() const
+{
+   //the writer bypasses cout, so earlier output must reach the descriptor first
+   cout.flush();
+
+   OutputWriter writer(STDOUT_FILENO);
+   writeConcordance(writer);
+   writer.flush();
+   return writer.getBytesWritten();
+}
+
+/** Writes the concordance stored in the index.
+@param writer The OutputWriter to write the rows to.
+@pre An index must be open.
+@post The writer's columns will be set from the maximum lengths saved in the index, and every row will be written to it. */
+void ConcordanceIndex::writeConcordance(OutputWriter& writer) const
+{
+   vector<size_t> firstKeys(segments.size(), 0);
+   vector<size_t> endKeys(segments.size());
+   for (size_t s = 0; s < segments.size(); s++)
+      endKeys[s] = (size_t)segments[s].header->numKeys;
+   writeKeys(writer, firstKeys, endKeys);
+}
+
+/** Prints the rows of the keywords a query matches.
+@param query The keywords to print.
+@return The number of bytes written to standard output.
+@pre An index must be open.
+@post The rows of each matching keyword will be printed to standard output, the same as those rows are printed by printConcordance. Anything waiting in cout is flushed first. */
+uint64_t ConcordanceIndex::printMatches(const KeyQuery& query) const
+{
+   //the writer bypasses cout, so earlier output must reach the descriptor first
+   cout.flush();
+
+   OutputWriter writer(STDOUT_FILENO);
+   writeMatches(writer, query);
+   writer.flush();
+   return writer.getBytesWritten();
+}
+
+/** Writes the rows of the keywords a query matches.
+@param writer The OutputWriter to write the rows to.
+@param query The keywords to write.
+@pre An index must be open.
+@post The writer's columns will be set from the maximum lengths saved in the index, and the rows of every matching keyword will be written to it. Each segment is searched with two binary searches, so it takes O(s log n + matches) for s segments. */
+void ConcordanceIndex::writeMatches(OutputWriter& writer, const KeyQuery& query) const
+{
+   vector<size_t> firstKeys(segments.size());
+   vector<size_t> endKeys(segments.size());
+   for (size_t s = 0; s < segments.size(); s++)
+      findMatches(segments[s], query, firstKeys[s], endKeys[s]);
+   writeKeys(writer, firstKeys, endKeys);
+}
+
+/**Builds a segment for a text and writes it to the end of a file.
+@param text The text of the segment.
+@param concordance The concordance whose stop words are left out of the segment.
+@param previousWords The last words of the corpus before the text, at most as many as the larger side of the window.
+@param firstToken The position in the corpus of the first word of the text.
+@param wordsBefore The number of context words before each keyword.
+@param wordsAfter The number of context words after each keyword.
+@param out The file to write the segment to, positioned where the segment starts.
+@return True if the segment was written, false otherwise.
+@pre none
+@post The segment will be written. Its maximum lengths also cover the rows of previousWords, whose words after the keyword now come from the text. */
+bool ConcordanceIndex::writeSegment(string_view text, const Concordance& concordance, const vector<string>& previousWords,
+                                    uint64_t firstToken, int wordsBefore, int wordsAfter, ofstream& out)
+{
+   //the keyword of a word that is a stop word
+   const uint32_t NO_KEY = UINT32_MAX;
+
+   //split the text into word IDs, leaving out lone punctuation symbols as the concordance does
+   Vocabulary vocab;
+   vector<uint32_t> tokenIds;
+   CorpusReader reader;
+   reader.openText(text);
+   string_view word;
+   while ( reader.nextWord(word) )
+   {
+      if ( !Concordance::isPunct(word) )
+         tokenIds.push_back(vocab.intern(word));
+   }
+
+   //clean each distinct word once to find its keyword
+   vector<uint32_t> wordKeys(vocab.size(), NO_KEY);
+   unordered_map<string, uint32_t> keyIds;
+   vector<string> keyWords;
+   string cleaned;
+   for (int w = 1; w < vocab.size(); w++)
+   {
+      Concordance::removePunctAndLower(vocab.getWord(w), cleaned);
+      if ( concordance.isStopWord(cleaned) )
+         continue;
+      auto found = keyIds.emplace(cleaned, (uint32_t)keyWords.size());
+      if ( found.second )
+         keyWords.push_back(cleaned);
+      wordKeys[w] = found.first->second;
+   }
+
+   //count the occurrences of each keyword
+   vector<uint64_t> counts(keyWords.size(), 0);
+   uint64_t numOccurrences = 0;
+   for (size_t t = 0; t < tokenIds.size(); t++)
+   {
+      if ( wordKeys[tokenIds[t]] != NO_KEY )
+      {
+         counts[wordKeys[tokenIds[t]]]++;
+         numOccurrences++;
+      }
+   }
+
+   //sort the keywords and give each a run of the occurrences, in alphabetical order
+   vector<StringSort::Key> sortKeys;
+   sortKeys.reserve(keyWords.size());
+   for (size_t k = 0; k < keyWords.size(); k++)
+      sortKeys.push_back(StringSort::makeKey(keyWords[k], k));
+   StringSort::sort(sortKeys);
+   vector<uint32_t> order(keyWords.size());
+   for (size_t k = 0; k < order.size(); k++)
+      order[k] = sortKeys[k].index;
+
+   vector<KeyEntry> keyEntries(keyWords.size());
+   vector<uint64_t> nextOccurrence(keyWords.size());
+   uint64_t textOffset = 0;
+   uint64_t firstOccurrence = 0;
+   for (size_t k = 0; k < order.size(); k++)
+   {
+      const string& keyWord = keyWords[order[k]];
+      keyEntries[k] = KeyEntry{textOffset, firstOccurrence, counts[order[k]], (uint32_t)keyWord.length(), 0};
+      nextOccurrence[order[k]] = firstOccurrence;
+      textOffset += keyWord.length();
+      firstOccurrence += counts[order[k]];
+   }
+
+   //place each occurrence, the text is scanned in order so each keyword's run is in corpus order
+   vector<uint64_t> positions(numOccurrences);
+   for (size_t t = 0; t < tokenIds.size(); t++)
+   {
+      if ( wordKeys[tokenIds[t]] != NO_KEY )
+         positions[nextOccurrence[wordKeys[tokenIds[t]]]++] = firstToken + t;
+   }
+
+   //the maximum lengths cover every word, stop words included, as WindowedConcordance::add does
+   //the previous words come first: their rows now reach into the text, and lengths only grow, so the
+   //larger lengths of their finished rows can simply be added to the maximums of the segments before
+   size_t numPrevious = previousWords.size();
+   size_t numWords = numPrevious + tokenIds.size();
+
+   //lengthBefore[i] is the total length of the words before word i
+   vector<uint64_t> lengthBefore(numWords + 1, 0);
+   for (size_t i = 0; i < numWords; i++)
+   {
+      size_t length = i < numPrevious ? previousWords[i].length() : (size_t)vocab.getLength(tokenIds[i - numPrevious]);
+      lengthBefore[i + 1] = lengthBefore[i] + length;
+   }
+   int maxPreKeyLen = 0;
+   int maxKeyLen = 0;
+   int maxPostKeyLen = 0;
+   for (size_t i = 0; i < numWords; i++)
+   {
+      int preKeyLen = (int)(lengthBefore[i] - lengthBefore[i < (size_t)wordsBefore ? 0 : i - wordsBefore]);
+      int keyLen = (int)(lengthBefore[i + 1] - lengthBefore[i]);
+      int postKeyLen = (int)(lengthBefore[min(numWords, i + 1 + wordsAfter)] - lengthBefore[i + 1]);
+      maxPreKeyLen = max(maxPreKeyLen, preKeyLen);
+      maxKeyLen = max(maxKeyLen, keyLen);
+      maxPostKeyLen = max(maxPostKeyLen, postKeyLen);
+   }
+
+   //lay out the parts of the segment, each starting on a multiple of 8
+   auto align = [](uint64_t offset) { return (offset + 7) & ~(uint64_t)7; };
+   vector<uint64_t> offsets(vocab.size() + 1, 0);
+   for (int w = 0; w < vocab.size(); w++)
+      offsets[w + 1] = offsets[w] + (uint64_t)vocab.getLength(w);
+   const StopWordSet& stopWords = concordance.getStopWords();
+   vector<uint64_t> stopWordOffsets((size_t)stopWords.size() + 1, 0);
+   for (int s = 0; s < stopWords.size(); s++)
+      stopWordOffsets[s + 1] = stopWordOffsets[s] + stopWords.getWord(s).length();
+
+   Header head;
+   memset(&head, 0, sizeof(head));
+   memcpy(head.magic, "KWICIDX", 8);
+   head.version = VERSION;
+   head.maxPreKeyLen = maxPreKeyLen;
+   head.maxKeyLen = maxKeyLen;
+   head.maxPostKeyLen = maxPostKeyLen;
+   head.wordsBefore = wordsBefore;
+   head.wordsAfter = wordsAfter;
+   head.numWords = (uint64_t)vocab.size();
+   head.firstToken = firstToken;
+   head.numTokens = tokenIds.size();
+   head.numKeys = keyEntries.size();
+   head.numOccurrences = numOccurrences;
+   head.wordOffsetsAt = sizeof(Header);
+   head.wordTextAt = head.wordOffsetsAt + offsets.size() * sizeof(uint64_t);
+   head.tokensAt = align(head.wordTextAt + offsets.back());
+   head.keysAt = align(head.tokensAt + tokenIds.size() * sizeof(uint32_t));
+   head.keyTextAt = head.keysAt + keyEntries.size() * sizeof(KeyEntry);
+   head.occurrencesAt = align(head.keyTextAt + textOffset);
+   head.numStopWords = (uint64_t)stopWords.size();
+   head.stopWordOffsetsAt = head.occurrencesAt + positions.size() * sizeof(uint64_t);
+   head.stopWordTextAt = head.stopWordOffsetsAt + stopWordOffsets.size() * sizeof(uint64_t);
+   head.segmentBytes = align(head.stopWordTextAt + stopWordOffsets.back());
+
+   //counts the bytes written, so the parts can be padded to their offsets
+   uint64_t written = 0;
+   auto put = [&](const void* data, uint64_t bytes)
+   {
+      out.write((const char*)data, (streamsize)bytes);
+      written += bytes;
+   };
+   auto padTo = [&](uint64_t offset)
+   {
+      static const char zeros[8] = {};
+      put(zeros, offset - written);
+   };
+
+   put(&head, sizeof(head));
+   put(offsets.data(), offsets.size() * sizeof(uint64_t));
+   for (int w = 0; w < vocab.size(); w++)
+      put(vocab.getWord(w).data(), (uint64_t)vocab.getLength(w));
+   padTo(head.tokensAt);
+   put(tokenIds.data(), tokenIds.size() * sizeof(uint32_t));
+   padTo(head.keysAt);
+   put(keyEntries.data(), keyEntries.size() * sizeof(KeyEntry));
+   for (size_t k = 0; k < order.size(); k++)
+      put(keyWords[order[k]].data(), keyWords[order[k]].length());
+   padTo(head.occurrencesAt);
+   put(positions.data(), positions.size() * sizeof(uint64_t));
+   put(stopWordOffsets.data(), stopWordOffsets.size() * sizeof(uint64_t));
+   for (int s = 0; s < stopWords.size(); s++)
+      put(stopWords.getWord(s).data(), stopWords.getWord(s).length());
+   padTo(head.segmentBytes);
+
+   return !out.fail();
+}
+
+/**Checks that the contents of a segment stay within the segment.
+@param segment The segment, whose header has been checked and whose parts fit in it.
+@param longestWord The length of the longest word of the segments before, set to the longest word of this segment if it is longer.
+@return True if every word offset, word ID, keyword entry, occurrence position and stop word offset is within bounds, false otherwise.
+@pre none
+@post The segment is unchanged. Reading any word, keyword, row or stop word of a segment that passes cannot go outside the segment. */
+bool ConcordanceIndex::checkSegment(const Segment& segment, uint64_t& longestWord)
+{
+   const Header& header = *segment.header;
+
+   //checks that a run of offsets starts at 0, never goes back, and ends inside the bytes left for its text
+   auto offsetsFit = [](const uint64_t* offsets, uint64_t count, uint64_t textBytes, uint64_t& longest)
+   {
+      if ( offsets[0] != 0 || offsets[count] > textBytes )
+         return false;
+      for (uint64_t i = 0; i < count; i++)
+      {
+         if ( offsets[i + 1] < offsets[i] )
+            return false;
+         longest = max(longest, offsets[i + 1] - offsets[i]);
+      }
+      return true;
+   };
+
+   uint64_t longestStopWord = 0;
+   if ( !offsetsFit(segment.wordOffsets, header.numWords, header.segmentBytes - header.wordTextAt, longestWord)
+       || !offsetsFit(segment.stopWordOffsets, header.numStopWords, header.segmentBytes - header.stopWordTextAt, longestStopWord) )
+      return false;
+
+   for (uint64_t t = 0; t < header.numTokens; t++)
+   {
+      if ( segment.tokens[t] >= header.numWords )
+         return false;
+   }
+
+   uint64_t keyTextBytes = header.segmentBytes - header.keyTextAt;
+   for (uint64_t k = 0; k < header.numKeys; k++)
+   {
+      const KeyEntry& key = segment.keys[k];
+      if ( key.textOffset > keyTextBytes || key.textLength > keyTextBytes - key.textOffset
+          || key.firstOccurrence > header.numOccurrences || key.numOccurrences > header.numOccurrences - key.firstOccurrence )
+         return false;
+   }
+
+   //a segment's occurrences are all in its own part of the corpus
+   for (uint64_t o = 0; o < header.numOccurrences; o++)
+   {
+      if ( segment.occurrences[o] < header.firstToken || segment.occurrences[o] - header.firstToken >= header.numTokens )
+         return false;
+   }
+   return true;
+}
+
+/**Returns the word at a position in the corpus.
+@param position The position of the word, counted in words.
+@return The word as a view into the index file.
+@pre position must be less than getNumTokens().
+@post The word will be returned as a string_view. */
+string_view ConcordanceIndex::getToken(uint64_t position) const
+{
+   //find the last segment starting at or before the position
+   size_t low = 0;
+   size_t high = segments.size();
+   while ( high - low > 1 )
+   {
+      size_t mid = low + (high - low) / 2;
+      if ( segments[mid].header->firstToken <= position )
+         low = mid;
+      else
+         high = mid;
+   }
+
+   const Segment& segment = segments[low];
+   uint32_t id = segment.tokens[position - segment.header->firstToken];
+   return string_view(segment.wordText + segment.wordOffsets[id], segment.wordOffsets[id + 1] - segment.wordOffsets[id]);
+}
+
+/**Returns a keyword of a segment.
+@param segment The segment.
+@param key The position of the keyword in the segment's alphabetical order.
+@return The keyword, stripped of punctuation and lowercase.
+@pre key must be less than the segment's number of keywords.
+@post The keyword will be returned as a view into the index file. */
+string_view ConcordanceIndex::getKey(const Segment& segment, size_t key)
+{
+   return string_view(segment.keyText + segment.keys[key].textOffset, segment.keys[key].textLength);
+}
+
+/**Finds the keywords of a segment a query matches with two binary searches of its keyword directory.
+@param segment The segment.
+@param query The keywords to find.
+@param firstKey Set to the position of the first matching keyword in the segment's alphabetical order.
+@param endKey Set to one past the position of the last matching keyword.
+@pre none
+@post The matches will be the keywords from firstKey up to endKey, which is firstKey if nothing matches. */
+void ConcordanceIndex::findMatches(const Segment& segment, const KeyQuery& query, size_t& firstKey, size_t& endKey)
+{
+   //the keywords before the matches, then the matches, then the keywords after them
+   size_t numKeys = (size_t)segment.header->numKeys;
+   size_t low = 0;
+   size_t high = numKeys;
+   while ( low < high )
+   {
+      size_t mid = low + (high - low) / 2;
+      if ( query.isBefore(getKey(segment, mid)) )
+         low = mid + 1;
+      else
+         high = mid;
+   }
+   firstKey = low;
+
+   high = numKeys;
+   while ( low < high )
+   {
+      size_t mid = low + (high - low) / 2;
+      if ( !query.isAfter(getKey(segment, mid)) )
+         low = mid + 1;
+      else
+         high = mid;
+   }
+   endKey = low;
+}
+
+/**Writes the rows of a run of keywords of each segment, merging the segments in alphabetical order.
+@param writer The OutputWriter to write the rows to.
+@param firstKeys The position of the first keyword written in each segment.
+@param endKeys One past the position of the last keyword written in each segment.
+@pre Each end must not be greater than the segment's number of keywords.
+@post The writer's columns will be set from the maximum lengths saved in the index. The rows will be written in alphabetical order of the keywords, and in corpus order within a keyword, taking a keyword's occurrences segment by segment, by writeWindowKeys for the window of the index. */
+void ConcordanceIndex::writeKeys(OutputWriter& writer, vector<size_t> firstKeys, const vector<size_t>& endKeys) const
+{
+   writer.setColumns(maxPreKeyLen, maxKeyLen, maxPostKeyLen);
+
+   //open only accepts the windows the program is compiled for, so one of these matches
+#define WRITE_KEYS(BEFORE, AFTER) \
+   if ( wordsBefore == BEFORE && wordsAfter == AFTER ) \
+      writeWindowKeys<BEFORE, AFTER>(writer, firstKeys, endKeys);
+   FOR_EACH_WINDOW(WRITE_KEYS)
+#undef WRITE_KEYS
+}
+
+/**Writes the rows of a run of keywords of each segment for one window, merging the segments in alphabetical order.
+@param writer The OutputWriter to write the rows to, with its columns set.
+@param firstKeys The position of the first keyword written in each segment, moved past each keyword as it is written.
+@param endKeys One past the position of the last keyword written in each segment.
+@pre BEFORE and AFTER must be the window of the index. Each end must not be greater than the segment's number of keywords.
+@post The rows will be written in alphabetical order of the keywords, and in corpus order within a keyword, taking a keyword's occurrences segment by segment. */
+template <int BEFORE, int AFTER>
+void ConcordanceIndex::writeWindowKeys(OutputWriter& writer, vector<size_t>& firstKeys, const vector<size_t>& endKeys) const
+{
+   OutputWriter::rowWords<BEFORE, AFTER> words;
+   while ( true )
+   {
+      //the smallest keyword not written yet, there are only a few segments so each is checked
+      bool found = false;
+      string_view keyWord;
+      for (size_t s = 0; s < segments.size(); s++)
+      {
+         if ( firstKeys[s] < endKeys[s] && (!found || getKey(segments[s], firstKeys[s]) < keyWord) )
+         {
+            keyWord = getKey(segments[s], firstKeys[s]);
+            found = true;
+         }
+      }
+      if ( !found )
+         return;
+
+      //the segments are in corpus order, so their occurrences of the keyword are too
+      for (size_t s = 0; s < segments.size(); s++)
+      {
+         if ( firstKeys[s] == endKeys[s] || getKey(segments[s], firstKeys[s]) != keyWord )
+            continue;
+
+         const KeyEntry& key = segments[s].keys[firstKeys[s]];
+         for (uint64_t o = 0; o < key.numOccurrences; o++)
+         {
+            getRow<BEFORE, AFTER>(segments[s].occurrences[key.firstOccurrence + o], words);
+            writer.writeRow<BEFORE, AFTER>(words);
+         }
+         firstKeys[s]++;
+      }
+   }
+}
+
+//compile the rows of every window
+#define INSTANTIATE(BEFORE, AFTER) \
+   template void ConcordanceIndex::getRow<BEFORE, AFTER>(uint64_t, OutputWriter::rowWords<BEFORE, AFTER>&) const;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
@@ -0,0 +1,266 @@
+/*
+file name: ConcordanceIndex.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the ConcordanceIndex class. A ConcordanceIndex is a concordance saved to a binary file that is mapped into memory as it is, so it can be used again without reading the corpus or building a tree. The file is a series of segments, one for the text the index was built from and one for each text appended to it since. Each segment holds its own words, its part of the corpus as one word ID per word, a directory of its keywords in alphabetical order, for each keyword the positions of its occurrences in the whole corpus, in corpus order, and the stop words it was built with, so an appended text leaves out the same stop words as the rest of the index. A row is rebuilt by reading the words of the window on either side of an occurrence from the stored corpus, crossing into the segments before or after it as needed, so the rows next to the end of one segment see the words of the next. Opening an index checks every offset, count, word ID and position in it against the bounds of its segment, in one pass over the file, so a damaged file is refused instead of read out of bounds. The window of context is saved with the index, and its rows are rebuilt by the code compiled for that window.
+*/
+
+#ifndef CONCORDANCEINDEX_H
+#define CONCORDANCEINDEX_H
+
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <vector>
+#include <cstdint>
+#include "Concordance.h"
+#include "OutputWriter.h"
+#include "KeyQuery.h"
+
+using namespace std;
+
+class ConcordanceIndex
+{
+public:
+   
+   static constexpr uint32_t VERSION = 5; //version of the file format written
+   
+   /** The default constructor for the ConcordanceIndex class.
+   Constructs a ConcordanceIndex with no file open. */
+   ConcordanceIndex();
+   
+   /** The destructor for the ConcordanceIndex class.
+   Unmaps the index file when its lifetime ends. */
+   virtual ~ConcordanceIndex();
+   
+   /**Builds the index of a corpus and saves it to a file.
+   @param corpus The text of the corpus.
+   @param concordance The concordance whose stop words are left out of the index and whose window the index is built with.
+   @param indexFile The name of the file to save the index to.
+   @return True if the index was saved, false if the file could not be written.
+   @pre none
+   @post The file will hold an index with one segment that prints the same concordance as concordance would after reading the corpus. */
+   bool static build(string_view corpus, const Concordance& concordance, const string& indexFile);
+   
+   /**Opens an index file and maps it into memory.
+   @param indexFile The name of the index file.
+   @return True if the file could be mapped and has the layout of an index, false otherwise.
+   @pre none
+   @post If true is returned, the index can be read. Any index opened before will be closed. Every offset, count, word ID and position in each segment is checked against the bounds of the segment, so a damaged file is refused instead of read out of bounds. Every segment must have the same window, one the program is compiled for. */
+   bool open(const string& indexFile);
+   
+   /**Adds the words of a text to the end of the corpus of the open index.
+   @param text The text appended to the corpus.
+   @param concordance The concordance whose stop words are left out of the index.
+   @return True if the text was added, false if the index file could not be written.
+   @pre An index must be open, and concordance must exclude the stop words returned by getStopWords.
+   @post A segment for the text will be added to the end of the index file, which is opened again. The index will print the same concordance as one built from the old corpus followed by white space and the text. The segment has the window of the index, whatever the window of concordance. Only the text and the last few words before it are read, so the cost does not depend on the size of the index. If the file could not be written, it is left as it was. */
+   bool append(string_view text, const Concordance& concordance);
+   
+   /**Unmaps the index file.
+   @pre none
+   @post No index will be open. */
+   void close();
+   
+   /** Tests whether the index has no keywords.
+   @return True if the index has no keywords, false otherwise.
+   @pre An index must be open.
+   @post Returns true if no segment has a keyword, false otherwise.*/
+   bool isEmpty() const;
+   
+   /**Returns the number of words in the corpus of the index.
+   @return The number of words, not counting punctuation.
+   @pre An index must be open.
+   @post The number of words will be returned as a uint64_t. */
+   uint64_t getNumTokens() const;
+   
+   /**Returns the number of segments in the index.
+   @return The number of segments, one more than the number of texts appended.
+   @pre An index must be open.
+   @post The number of segments will be returned as a size_t. */
+   size_t getNumSegments() const;
+   
+   /**Returns the stop words the index was built with.
+   @param stopWords Set to the stop words left out of the first segment, stripped of punctuation and lowercase.
+   @pre An index must be open.
+   @post stopWords will be empty if the index was built without stop words. Appending keeps the stop words of the first segment, so every segment leaves out the same ones. */
+   void getStopWords(vector<string>& stopWords) const;
+   
+   /**Returns the number of context words before each keyword in the index.
+   @return The number of words before the keyword in every row.
+   @pre An index must be open.
+   @post The number of words will be returned as an int. */
+   int getWordsBefore() const;
+   
+   /**Returns the number of context words after each keyword in the index.
+   @return The number of words after the keyword in every row.
+   @pre An index must be open.
+   @post The number of words will be returned as an int. */
+   int getWordsAfter() const;
+   
+   /**Rebuilds the words of the row of a keyword occurrence from the stored corpus.
+   @param position The position of the occurrence in the corpus, counted in words.
+   @param words Set to the words of the row, with the keyword as it appears in the corpus at index BEFORE.
+   @pre position must be less than getNumTokens(). BEFORE and AFTER must be the window of the index.
+   @post Words before the first word or after the last word of the corpus will be empty. */
+   template <int BEFORE, int AFTER>
+   void getRow(uint64_t position, OutputWriter::rowWords<BEFORE, AFTER>& words) const;
+   
+   /** Prints the concordance stored in the index to standard output.
+   @return The number of bytes written to standard output.
+   @pre An index must be open.
+   @post Every row will be printed in the same order and layout as Concordance::printConcordance prints them. Anything waiting in cout is flushed first. */
+   uint64_t printConcordance() const;
+   
+   /** Writes the concordance stored in the index.
+   @param writer The OutputWriter to write the rows to.
+   @pre An index must be open.
+   @post The writer's columns will be set from the maximum lengths saved in the index, and every row will be written to it. */
+   void writeConcordance(OutputWriter& writer) const;
+   
+   /** Prints the rows of the keywords a query matches.
+   @param query The keywords to print.
+   @return The number of bytes written to standard output.
+   @pre An index must be open.
+   @post The rows of each matching keyword will be printed to standard output, the same as those rows are printed by printConcordance. Anything waiting in cout is flushed first. */
+   uint64_t printMatches(const KeyQuery& query) const;
+   
+   /** Writes the rows of the keywords a query matches.
+   @param writer The OutputWriter to write the rows to.
+   @param query The keywords to write.
+   @pre An index must be open.
+   @post The writer's columns will be set from the maximum lengths saved in the index, and the rows of every matching keyword will be written to it. Each segment is searched with two binary searches, so it takes O(s log n + matches) for s segments. */
+   void writeMatches(OutputWriter& writer, const KeyQuery& query) const;
+   
+private:
+   
+   //the first bytes of a segment, every offset is from the start of the segment and a multiple of 8
+   struct Header
+   {
+      char magic[8]; //"KWICIDX" followed by a zero byte
+      uint32_t version; //VERSION of the writer
+      int32_t maxPreKeyLen; //longest run of words before a keyword in the segment or just before it
+      int32_t maxKeyLen; //longest keyword in the segment
+      int32_t maxPostKeyLen; //longest run of words after a keyword in the segment or just before it
+      int32_t wordsBefore; //number of context words before each keyword
+      int32_t wordsAfter; //number of context words after each keyword
+      uint64_t numWords; //number of distinct words in the segment, including the empty word with ID 0
+      uint64_t firstToken; //position in the corpus of the first word of the segment
+      uint64_t numTokens; //number of words in the segment, not counting punctuation
+      uint64_t numKeys; //number of keywords in the segment
+      uint64_t numOccurrences; //number of occurrences in the segment
+      uint64_t wordOffsetsAt; //numWords + 1 uint64_t offsets into the word text
+      uint64_t wordTextAt; //the words, one after another
+      uint64_t tokensAt; //numTokens uint32_t word IDs, the segment's part of the corpus in order
+      uint64_t keysAt; //numKeys KeyEntry records in alphabetical order
+      uint64_t keyTextAt; //the keywords, one after another
+      uint64_t occurrencesAt; //numOccurrences uint64_t positions in the corpus, grouped by keyword in corpus order
+      uint64_t numStopWords; //number of stop words left out of the segment
+      uint64_t stopWordOffsetsAt; //numStopWords + 1 uint64_t offsets into the stop word text
+      uint64_t stopWordTextAt; //the stop words, one after another
+      uint64_t segmentBytes; //size of the whole segment, a multiple of 8
+   };
+   
+   //a keyword in the keyword directory of a segment
+   struct KeyEntry
+   {
+      uint64_t textOffset; //offset of the keyword into the key text
+      uint64_t firstOccurrence; //index of the keyword's first occurrence
+      uint64_t numOccurrences; //number of occurrences of the keyword
+      uint32_t textLength; //length of the keyword
+      uint32_t reserved; //always 0
+   };
+   
+   //the parts of a mapped segment
+   struct Segment
+   {
+      const Header* header; //the header at the start of the segment
+      const uint64_t* wordOffsets; //where each word starts in wordText
+      const char* wordText; //the words of the segment
+      const uint32_t* tokens; //the segment's part of the corpus as word IDs
+      const KeyEntry* keys; //the keyword directory
+      const char* keyText; //the keywords
+      const uint64_t* occurrences; //the positions of the occurrences
+      const uint64_t* stopWordOffsets; //where each stop word starts in stopWordText
+      const char* stopWordText; //the stop words the segment was built with
+   };
+   
+   //an index owns its mapping, so it cannot be copied
+   ConcordanceIndex(const ConcordanceIndex&);
+   ConcordanceIndex& operator=(const ConcordanceIndex&);
+   
+   /**Builds a segment for a text and writes it to the end of a file.
+   @param text The text of the segment.
+   @param concordance The concordance whose stop words are left out of the segment.
+   @param previousWords The last words of the corpus before the text, at most as many as the larger side of the window.
+   @param firstToken The position in the corpus of the first word of the text.
+   @param wordsBefore The number of context words before each keyword.
+   @param wordsAfter The number of context words after each keyword.
+   @param out The file to write the segment to, positioned where the segment starts.
+   @return True if the segment was written, false otherwise.
+   @pre none
+   @post The segment will be written. Its maximum lengths also cover the rows of previousWords, whose words after the keyword now come from the text. */
+   bool static writeSegment(string_view text, const Concordance& concordance, const vector<string>& previousWords,
+                            uint64_t firstToken, int wordsBefore, int wordsAfter, ofstream& out);
+   
+   /**Checks that the contents of a segment stay within the segment.
+   @param segment The segment, whose header has been checked and whose parts fit in it.
+   @param longestWord The length of the longest word of the segments before, set to the longest word of this segment if it is longer.
+   @return True if every word offset, word ID, keyword entry, occurrence position and stop word offset is within bounds, false otherwise.
+   @pre none
+   @post The segment is unchanged. Reading any word, keyword, row or stop word of a segment that passes cannot go outside the segment. */
+   bool static checkSegment(const Segment& segment, uint64_t& longestWord);
+   
+   /**Returns the word at a position in the corpus.
+   @param position The position of the word, counted in words.
+   @return The word as a view into the index file.
+   @pre position must be less than getNumTokens().
+   @post The word will be returned as a string_view. */
+   string_view getToken(uint64_t position) const;
+   
+   /**Returns a keyword of a segment.
+   @param segment The segment.
+   @param key The position of the keyword in the segment's alphabetical order.
+   @return The keyword, stripped of punctuation and lowercase.
+   @pre key must be less than the segment's number of keywords.
+   @post The keyword will be returned as a view into the index file. */
+   string_view static getKey(const Segment& segment, size_t key);
+   
+   /**Finds the keywords of a segment a query matches with two binary searches of its keyword directory.
+   @param segment The segment.
+   @param query The keywords to find.
+   @param firstKey Set to the position of the first matching keyword in the segment's alphabetical order.
+   @param endKey Set to one past the position of the last matching keyword.
+   @pre none
+   @post The matches will be the keywords from firstKey up to endKey, which is firstKey if nothing matches. */
+   void static findMatches(const Segment& segment, const KeyQuery& query, size_t& firstKey, size_t& endKey);
+   
+   /**Writes the rows of a run of keywords of each segment, merging the segments in alphabetical order.
+   @param writer The OutputWriter to write the rows to.
+   @param firstKeys The position of the first keyword written in each segment.
+   @param endKeys One past the position of the last keyword written in each segment.
+   @pre Each end must not be greater than the segment's number of keywords.
+   @post The writer's columns will be set from the maximum lengths saved in the index. The rows will be written in alphabetical order of the keywords, and in corpus order within a keyword, taking a keyword's occurrences segment by segment, by writeWindowKeys for the window of the index. */
+   void writeKeys(OutputWriter& writer, vector<size_t> firstKeys, const vector<size_t>& endKeys) const;
+   
+   /**Writes the rows of a run of keywords of each segment for one window, merging the segments in alphabetical order.
+   @param writer The OutputWriter to write the rows to, with its columns set.
+   @param firstKeys The position of the first keyword written in each segment, moved past each keyword as it is written.
+   @param endKeys One past the position of the last keyword written in each segment.
+   @pre BEFORE and AFTER must be the window of the index. Each end must not be greater than the segment's number of keywords.
+   @post The rows will be written in alphabetical order of the keywords, and in corpus order within a keyword, taking a keyword's occurrences segment by segment. */
+   template <int BEFORE, int AFTER>
+   void writeWindowKeys(OutputWriter& writer, vector<size_t>& firstKeys, const vector<size_t>& endKeys) const;
+   
+   string fileName; //name of the open index file
+   void* mapping; //address of the mapped index file, or nullptr if none is open
+   size_t mappedSize; //size of the mapping
+   vector<Segment> segments; //the segments in corpus order
+   int maxPreKeyLen; //longest run of words before a keyword in any segment
+   int maxKeyLen; //longest keyword in any segment
+   int maxPostKeyLen; //longest run of words after a keyword in any segment
+   int wordsBefore; //number of context words before each keyword, the same in every segment
+   int wordsAfter; //number of context words after each keyword, the same in every segment
+};
+
+#endif
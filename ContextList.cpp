@@ -2,42 +2,109 @@
 file name: Node.h
 author: Hall, Ashley
 date: 2019-Nov-23
-description: The implementation file for the ContextList class. A ContextList is a singly linked list composed of ListNode objects containing each instance of a word's context in the corpus. The ContextList will contain all the contexts for each word in the corpus in the order of the occurrence of the word in the corpus. 
+description: The implementation file for the ContextList class. A ContextList holds each instance of a word in the corpus as the position of the word in the concordance's WordStream, where its context can be read back. The ContextList will contain all the contexts for each word in the corpus in the order of the occurrence of the word in the corpus. The positions are compressed: the list is a chain of blocks, each holding the position of its first occurrence and then the gap to each occurrence after it, as a varint of 7 bits to a byte, so most occurrences take a byte or two instead of a whole context. The blocks double in size up to MAX_BLOCK_BYTES, so the list of a rare word stays small. The positions are read back in order through a Reader. Only the rows it writes depend on the window of its contexts.
 */
 
 #include "ContextList.h"
 
+#include <new>
+#include <algorithm>
+
+
+/** The default constructor for the Reader class.
+Constructs a reader past the last position of any list. */
+ContextList::Reader::Reader() : block(nullptr), index(0), gap(nullptr), position(0)
+{
+}
+
+/** Constructor for the Reader class that accepts the list to read.
+@param list The list to be read.
+@pre The list must not change while it is read. */
+ContextList::Reader::Reader(const ContextList& list) : block(list.head), index(0), gap(nullptr), position(0)
+{
+}
+
+/**Reads the next position of the list.
+@param nextPosition Set to the position read.
+@return True if a position was read, false if the reader was past the last one.
+@pre none
+@post The reader will be at the position after the one read. */
+bool ContextList::Reader::next(uint64_t& nextPosition)
+{
+   if ( block == nullptr )
+      return false;
+
+   //the first position of a block is stored whole, the rest as gaps from the one before
+   if ( index == 0 )
+   {
+      position = block->firstPosition;
+      gap = block->getGaps();
+   }
+   else
+   {
+      uint64_t distance;
+      gap = readGap(gap, distance);
+      position += distance;
+   }
+
+   //move on to the next block after the last position of this one
+   if ( ++index == block->count )
+   {
+      block = block->next;
+      index = 0;
+   }
+   nextPosition = position;
+   return true;
+}
+
+/**Skips positions of the list without reading them.
+@param count The number of positions to skip.
+@pre count must be at most the number of positions left.
+@post The reader will be count positions further on. Whole blocks are skipped by their counts without reading their gaps. */
+void ContextList::Reader::skip(size_t count)
+{
+   //the next block starts with a whole position, so the gaps of the blocks skipped are not needed
+   while ( block != nullptr && count >= block->count - index )
+   {
+      count -= block->count - index;
+      block = block->next;
+      index = 0;
+   }
+
+   uint64_t skipped;
+   for ( ; count > 0; count--)
+      next(skipped);
+}
 
 /** The default constructor for the ContextList class.
 Constructs an empty ContextList object.
 The head and tail pointers are initialized to nullptr.
  */
-ContextList::ContextList() : head(nullptr), tail(nullptr)
+ContextList::ContextList() : head(nullptr), tail(nullptr), arena(nullptr), numContexts(0), lastPosition(0)
+{
+}
+
+/** Constructor for the ContextList class that accepts the arena to take its blocks from.
+Constructs an empty ContextList object whose blocks will be created in the arena.
+@param nodeArena The arena the blocks are created in, or nullptr to create them with new.
+@pre The arena must outlive the list. */
+ContextList::ContextList(NodeArena* nodeArena) : head(nullptr), tail(nullptr), arena(nodeArena), numContexts(0), lastPosition(0)
 {
 }
 
 /**The copy constructor for the ContextList class.
-Makes a deep copy of the list supplied as the argument.
+Makes a deep copy of the list supplied as the argument. The copied blocks are created with new, not in the arena of the original list.
 @param aList The list to be copied.
  */
-ContextList::ContextList(const ContextList& aList)
-{
-   //make deep copies of the nodes and set to this-list's head pointer
-   head = copyNodes(aList.head);
-   
-   //iterate through list until last node is found
-   ListNode* curr = head;
-   while (curr->getNext() != nullptr)
-   {
-      curr = curr->getNext();
-   }
-   //set last node to tail
-   tail = curr;
+ContextList::ContextList(const ContextList& aList) : head(nullptr), tail(nullptr), arena(nullptr), numContexts(0), lastPosition(0)
+{
+   //copy the positions one by one, in order, into new blocks
+   addAll(aList);
 }
 
 /**Overloaded assignment operator for the ContextList class.
 @pre Objects on the left and right side of the operator must be the same data type.
-@post The list on the left side of the operator will contain a deep copy of the list on the right side.
+@post The list on the left side of the operator will contain a deep copy of the list on the right side, created in its own arena if it has one.
 @param rhs The list on the right side of the assignment operator.
 */
 ContextList& ContextList::operator=(const ContextList& rhs)
@@ -47,130 +114,243 @@ ContextList& ContextList::operator=(const ContextList& rhs)
    {
       //deallocate memory assigned to left-hand side list
       clear();
-      
-      //copy nodes from right-hand side to left list
-      head = copyNodes(rhs.head);
-      
-      //find last node in list and set to tail
-      ListNode* curr = head;
-      while (curr->getNext() != nullptr)
-      {
-         curr = curr->getNext();
-      }
-      tail = curr;
+
+      //copy the positions into new blocks, in the left-hand list's arena if it has one
+      addAll(rhs);
    }
-   
+
    //return copy of right-hand side list
    return *this;
 }
-  
+
+/**The move constructor for the ContextList class.
+Takes the blocks of the list supplied as the argument without copying them.
+@param aList The list to be moved. It will be empty afterwards. */
+ContextList::ContextList(ContextList&& aList) noexcept : head(aList.head), tail(aList.tail), arena(aList.arena), numContexts(aList.numContexts), lastPosition(aList.lastPosition)
+{
+   aList.head = nullptr;
+   aList.tail = nullptr;
+   aList.numContexts = 0;
+}
+
+/**Overloaded move assignment operator for the ContextList class.
+@pre Objects on the left and right side of the operator must be the same data type.
+@post The list on the left side of the operator will hold the blocks, and the arena, of the list on the right side, which will be empty. The blocks that were in the left list are deleted.
+@param rhs The list on the right side of the assignment operator.
+*/
+ContextList& ContextList::operator=(ContextList&& rhs) noexcept
+{
+   if (this != &rhs)
+   {
+      clear();
+
+      //take the right-hand list's blocks, they stay wherever they were allocated
+      head = rhs.head;
+      tail = rhs.tail;
+      arena = rhs.arena;
+      numContexts = rhs.numContexts;
+      lastPosition = rhs.lastPosition;
+      rhs.head = nullptr;
+      rhs.tail = nullptr;
+      rhs.numContexts = 0;
+   }
+   return *this;
+}
+
 /** The destructor for the ContextList class.
-Destroys the ContextList object, freeing memory allocated for the nodes in the list when its lifetime ends.
+Destroys the ContextList object, freeing memory allocated for the blocks in the list when its lifetime ends.
  */
 ContextList::~ContextList()
 {
    clear();
 }
 
-/**Copies a chain of ListNode objects.
-@pre origHead must be a pointer to a ListNode object or nullptr.
-@post Returns the deep copy of a ListNode pointer to the first node in a chain of copied nodes.
-@param origHead The pointer to the first node in the chain to be copied.
-@return The  head pointer to the copied chain of nodes.
- */
-ListNode* ContextList::copyNodes(const ListNode* origHead)
+/** Adds the position of a new occurrence to the end of the ContextList object.
+ @param position The position of the keyword in the concordance's WordStream.
+ @pre position must be after the last position in the list.
+ @post The gap from the last position will be written to the last block, or a new block will be started with the position if the gap does not fit.*/
+void ContextList::add(uint64_t position)
 {
-   //list is empty
-   ListNode* copiedHead = nullptr;
-   
-   //list isn't empty
-   if ( origHead != nullptr )
+   //if list is empty or the gap does not fit in the last block, start a new block
+   uint64_t gap = position - lastPosition;
+   size_t spare = tail == nullptr ? 0 : (size_t)(tail->capacity - tail->used);
+   if ( spare < MAX_GAP_BYTES && spare < (size_t)gapBytes(gap) )
    {
-      //create a new ListNode that is a copy of the original
-      copiedHead = new ListNode(origHead->getContext(), origHead->getNext());
-      
-      //set the next node's in the copied list to the next node's in the original list
-      copiedHead->setNext( copyNodes( origHead->getNext() ) );
+      addBlock(position);
+      return;
    }
-   
-   //return the head pointer of the copied list
-   return copiedHead;
+
+   //write the gap after the last one in the block
+   unsigned char* gaps = tail->getGaps();
+   tail->used = (uint16_t)(writeGap(gaps + tail->used, gap) - gaps);
+   tail->count++;
+   lastPosition = position;
+   numContexts++;
 }
 
-/** Adds a new ListNode to the end of the ContextList object.
- @param context The context to be added to the ContextList.
- @pre context must be of type ListNode::contextArr.
- @post The new ListNode will be added to the end of the ContextList object. The tail pointer will point to the new node added.*/
-void ContextList::add(const ListNode::contextArr& context)
+/**Starts a new block at the end of the list.
+ @param position The position of the first occurrence in the block.
+ @pre none
+ @post The new block, twice the size of the last one up to MAX_BLOCK_BYTES, will be the last block of the list, holding the position. */
+void ContextList::addBlock(uint64_t position)
 {
-   //allocate memory for a new ListNode containing the given context
-   ListNode* newNode = new ListNode(context);
-   
-   //if list is empty, set head and tail to point to new ListNode
+   //create the block in the arena if the list has one
+   uint16_t capacity = tail == nullptr ? FIRST_BLOCK_BYTES : (uint16_t)min(tail->capacity * 2, (int)MAX_BLOCK_BYTES);
+   size_t bytes = sizeof(Block) + capacity;
+   void* memory = arena != nullptr ? arena->allocate(bytes, alignof(Block)) : ::operator new(bytes);
+   Block* newBlock = new (memory) Block{nullptr, position, 1, 0, capacity};
+
+   //if list is empty, set head and tail to point to new block
    if (head == nullptr)
+      head = newBlock;
+   else
+      tail->next = newBlock;
+   tail = newBlock;
+   lastPosition = position;
+   numContexts++;
+}
+
+/** Deletes all the blocks in the ContextList.
+ @pre None.
+ @post The ContextList will be empty. Blocks created with new will be deallocated. Blocks created in an arena are left for the arena to release in bulk. */
+void ContextList::clear()
+{
+   //keep deleting blocks until list is empty, arena blocks are released with the arena
+   while(arena == nullptr && head != nullptr)
    {
-      head = newNode;
-      tail = newNode;
+      Block* blockToDelete = head;
+      head = head->next;
+      ::operator delete(blockToDelete);
    }
-   //list is not empty
+   head = nullptr;
+   tail = nullptr;
+   numContexts = 0;
+   lastPosition = 0;
+}
+
+/** Sets the arena new blocks are created in.
+ @param nodeArena The arena the blocks are created in, or nullptr to create them with new.
+ @pre The list must be empty. The arena must outlive the list.
+ @post Blocks added to the list will be created in the arena. */
+void ContextList::setArena(NodeArena* nodeArena)
+{
+   arena = nodeArena;
+}
+
+/** Adds a copy of every position in another ContextList to the end of this one.
+ @param other The list whose positions are copied.
+ @pre other must not be this list, and its positions must come after the positions of this list.
+ @post The positions of other will follow the positions of this list in their original order. */
+void ContextList::addAll(const ContextList& other)
+{
+   Reader reader(other);
+   uint64_t position;
+   while ( reader.next(position) )
+      add(position);
+}
+
+/** Moves every block of another ContextList to the end of this one.
+ @param other The list whose blocks are moved.
+ @param shift The number added to each position of other, for positions in a word stream that was appended to another one.
+ @pre other must not be this list. Both lists must create their blocks the same way: both with new, or in arenas that will be released together. The shifted positions of other must come after the positions of this list.
+ @post The positions of other, shifted, will follow the positions of this list in their original order, and other will be empty. Since only the first position of a block is stored whole, shifting touches each block once, and no gaps are copied or allocated. */
+void ContextList::splice(ContextList& other, int64_t shift)
+{
+   //nothing to move
+   if ( other.head == nullptr )
+      return;
+
+   //the gaps inside each block stay the same
+   for (Block* block = other.head; block != nullptr; block = block->next)
+      block->firstPosition += shift;
+
+   //link the other list's chain after the tail
+   if ( head == nullptr )
+      head = other.head;
    else
+      tail->next = other.head;
+   tail = other.tail;
+   numContexts += other.numContexts;
+   lastPosition = other.lastPosition + shift;
+
+   //the blocks now belong to this list
+   other.head = nullptr;
+   other.tail = nullptr;
+   other.numContexts = 0;
+}
+
+/**Writes each context in the list as a row of the concordance. Each row forms three columns. The first column will contain the words before the keyword and will be right justified. The second column will contain the keyword and will be centered. The third column will contain the words after the keyword and will be left justified.
+ @param writer The OutputWriter to write the rows to.
+ @param vocab The Vocabulary the context word IDs were interned in.
+ @param words The word stream the positions are in.
+ @pre The writer's columns must be set. vocab must be the Vocabulary used to build the stream.
+ @post A row for each position in the ContextList will be written to the writer, in the order of the list. */
+template <int BEFORE, int AFTER>
+void ContextList::writeFormatted(OutputWriter& writer, const Vocabulary& vocab, const WordStream& words) const
+{
+   Reader reader(*this);
+   uint64_t position;
+   while ( reader.next(position) )
    {
-      //add ListNode to end of ContextList
-      tail->setNext(newNode);
-      //set tail to ListNode just added
-      tail = newNode;
+      ListNode<BEFORE, AFTER> context(words, position);
+      writer.writeRow<BEFORE, AFTER>(context.getContext(), vocab, context.getDocument());
    }
 }
 
-/** Deletes all the nodes in the ContextList.
- @pre None.
- @post The ContextList will be empty, memory for the nodes has been deallocated. */
-void ContextList::clear()
+/**Returns the number of contexts in the list.
+ @return The number of positions in the list.
+ @pre none
+ @post The number of contexts will be returned as a size_t. */
+size_t ContextList::size() const
+{
+   return numContexts;
+}
+
+/**Returns the number of bytes a gap takes as a varint.
+ @param gap The gap between two positions.
+ @return The number of bytes, from 1 to MAX_GAP_BYTES. */
+int ContextList::gapBytes(uint64_t gap)
 {
-   //keep deleting nodes until list is empty
-   while(head != nullptr)
+   int bytes = 1;
+   while ( gap >= 0x80 )
    {
-      //start deleting nodes from the beginning of the list
-      ListNode* nodeToDelete = head;
-      //set head to next node
-      head = head->getNext();
-      //deallocate memory for node
-      delete nodeToDelete;
-      //set pointer to nullptr
-      nodeToDelete = nullptr;
+      gap >>= 7;
+      bytes++;
    }
+   return bytes;
 }
 
-/**Prints each context in the list as a string to cout. Each context will be on one line forming three columns. The first column will contain the words before the keyword and will be right justified. The second column will contain the keyword and will be centered. The thrid column will contain the words after the keyword and will be left justified.
- @param preKeyLen The total length of the words before the keyword.
- @param keyLen The length of the keyword.
- @param postKeyLen The total length of the words after the keyword.
- @pre All arguments supplied must be of type int.
- @post The context for each ListNode in the ContextList will be displayed to cout. */
-void ContextList::printFormatted(int preKeyLen, int keyLen, int postKeyLen) const
+/**Writes a gap as a varint, the lowest 7 bits first, the high bit of each byte set if another follows.
+ @param dst Where the gap is written.
+ @param gap The gap between two positions.
+ @return A pointer to the byte after the varint.
+ @pre dst must have room for gapBytes(gap) bytes. */
+unsigned char* ContextList::writeGap(unsigned char* dst, uint64_t gap)
 {
-   ListNode* currNode = head;
-   while (currNode != nullptr)
+   while ( gap >= 0x80 )
    {
-      
-      string keyWord = currNode->getKey();
-      
-      int preKeyColWidth = preKeyLen + 40;
-      int keyColWidth = keyLen + 10;
-      int postKeyColWidth = postKeyLen + 40;
-
-      int currKeyLen = (int)keyWord.length();
-      int padAfter = (keyColWidth - currKeyLen) / 2;
-      int padBefore = keyColWidth - padAfter - currKeyLen;
-
-      keyWord.append(padAfter, ' ');
-      keyWord.insert(keyWord.begin(), padBefore, ' ');
-      
-      cout << setw(preKeyColWidth) << right << currNode->getPreKeyContext();
-      cout << setw(keyColWidth) << keyWord;
-      cout << setw(postKeyColWidth) << left << currNode->getPostKeyContext();
-      
-      currNode = currNode->getNext();
-      cout << endl;
+      *dst++ = (unsigned char)(gap | 0x80);
+      gap >>= 7;
    }
+   *dst++ = (unsigned char)gap;
+   return dst;
 }
+
+/**Reads a gap written by writeGap.
+ @param src The first byte of the varint.
+ @param gap Set to the gap read.
+ @return A pointer to the byte after the varint. */
+const unsigned char* ContextList::readGap(const unsigned char* src, uint64_t& gap)
+{
+   //most gaps are under 128 and take a single byte
+   gap = *src & 0x7F;
+   for (int shift = 7; *src++ & 0x80; shift += 7)
+      gap |= (uint64_t)(*src & 0x7F) << shift;
+   return src;
+}
+
+//compile the rows of every window
+#define INSTANTIATE(BEFORE, AFTER) \
+   template void ContextList::writeFormatted<BEFORE, AFTER>(OutputWriter&, const Vocabulary&, const WordStream&) const;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
@@ -2,7 +2,7 @@
 file name: Node.h
 author: Hall, Ashley
 date: 2019-Nov-23
-description: The header file for the ContextList class. A ContextList is a singly linked list composed of ListNode objects containing each instance of a word's context in the corpus. The ContextList will contain all the contexts for each word in the corpus in the order of the occurrence of the word in the corpus. 
+description: The header file for the ContextList class. A ContextList holds each instance of a word in the corpus as the position of the word in the concordance's WordStream, where its context can be read back. The ContextList will contain all the contexts for each word in the corpus in the order of the occurrence of the word in the corpus. The positions are compressed: the list is a chain of blocks, each holding the position of its first occurrence and then the gap to each occurrence after it, as a varint of 7 bits to a byte, so most occurrences take a byte or two instead of a whole context. The blocks double in size up to MAX_BLOCK_BYTES, so the list of a rare word stays small. The positions are read back in order through a Reader. Only the rows it writes depend on the window of its contexts.
 */
 
 #ifndef CONTEXTLIST_H
@@ -10,70 +10,193 @@ description: The header file for the ContextList class. A ContextList is a singl
 
 #include <iostream>
 #include <iomanip>
+#include <vector>
+#include <cstdint>
 #include "ListNode.h"
+#include "NodeArena.h"
+#include "OutputWriter.h"
+#include "WordStream.h"
 
 using namespace std;
 
 
 class ContextList
 {
+   //a run of positions, the header is followed in memory by capacity bytes of gaps
+   struct Block
+   {
+      Block* next; //pointer to the next block
+      uint64_t firstPosition; //position of the first occurrence in the block
+      uint32_t count; //number of occurrences in the block
+      uint16_t used; //bytes of gaps written
+      uint16_t capacity; //bytes of gaps the block holds
+
+      /**Returns the gaps of the block.
+      @return A pointer to the first byte after the header. */
+      unsigned char* getGaps() { return reinterpret_cast<unsigned char*>(this + 1); }
+
+      /**Returns the gaps of the block.
+      @return A pointer to the first byte after the header. */
+      const unsigned char* getGaps() const { return reinterpret_cast<const unsigned char*>(this + 1); }
+   };
+
 public:
-   
+
+   static constexpr uint16_t FIRST_BLOCK_BYTES = 8; //bytes of gaps in the first block of a list
+   static constexpr uint16_t MAX_BLOCK_BYTES = 1024; //blocks double in size up to this
+   static constexpr int MAX_GAP_BYTES = 10; //bytes of the longest varint, a gap of 64 bits
+
+   //reads the positions of a list in order
+   class Reader
+   {
+   public:
+      /** The default constructor for the Reader class.
+      Constructs a reader past the last position of any list. */
+      Reader();
+
+      /** Constructor for the Reader class that accepts the list to read.
+      @param list The list to be read.
+      @pre The list must not change while it is read. */
+      Reader(const ContextList& list);
+
+      /**Reads the next position of the list.
+      @param nextPosition Set to the position read.
+      @return True if a position was read, false if the reader was past the last one.
+      @pre none
+      @post The reader will be at the position after the one read. */
+      bool next(uint64_t& nextPosition);
+
+      /**Skips positions of the list without reading them.
+      @param count The number of positions to skip.
+      @pre count must be at most the number of positions left.
+      @post The reader will be count positions further on. Whole blocks are skipped by their counts without reading their gaps. */
+      void skip(size_t count);
+
+   private:
+      const Block* block; //block of the next position, nullptr past the last one
+      uint32_t index; //index of the next position in its block
+      const unsigned char* gap; //the gap to the next position, if it is not the first of its block
+      uint64_t position; //the position read last
+   };
+
    /** The default constructor for the ContextList class.
    Constructs an empty ContextList object.
    The head and tail pointers are initialized to nullptr.
     */
    ContextList();
-   
+
+   /** Constructor for the ContextList class that accepts the arena to take its blocks from.
+   Constructs an empty ContextList object whose blocks will be created in the arena.
+   @param nodeArena The arena the blocks are created in, or nullptr to create them with new.
+   @pre The arena must outlive the list. */
+   ContextList(NodeArena* nodeArena);
+
    /**The copy constructor for the ContextList class.
-   Makes a deep copy of the list supplied as the argument.
+   Makes a deep copy of the list supplied as the argument. The copied blocks are created with new, not in the arena of the original list.
    @param aList The list to be copied.
     */
    ContextList(const ContextList& aList);
-   
+
    /**Overloaded assignment operator for the ContextList class.
    @pre Objects on the left and right side of the operator must be the same data type.
-   @post The list on the left side of the operator will contain a deep copy of the list on the right side.
+   @post The list on the left side of the operator will contain a deep copy of the list on the right side, created in its own arena if it has one.
    @param rhs The list on the right side of the assignment operator.
    */
    ContextList& operator=(const ContextList& rhs);
-   
+
+   /**The move constructor for the ContextList class.
+   Takes the blocks of the list supplied as the argument without copying them.
+   @param aList The list to be moved. It will be empty afterwards. */
+   ContextList(ContextList&& aList) noexcept;
+
+   /**Overloaded move assignment operator for the ContextList class.
+   @pre Objects on the left and right side of the operator must be the same data type.
+   @post The list on the left side of the operator will hold the blocks, and the arena, of the list on the right side, which will be empty. The blocks that were in the left list are deleted.
+   @param rhs The list on the right side of the assignment operator.
+   */
+   ContextList& operator=(ContextList&& rhs) noexcept;
+
    /** The destructor for the ContextList class.
-   Destroys the ContextList object, freeing memory allocated for the nodes in the list when its lifetime ends.
+   Destroys the ContextList object, freeing memory allocated for the blocks in the list when its lifetime ends.
     */
    virtual ~ContextList();
-   
-   /** Adds a new ListNode to the end of the ContextList object.
-   @param context The context to be added to the ContextList.
-   @pre context must be of type ListNode::contextArr.
-   @post The new ListNode will be added to the end of the ContextList object. The tail pointer will point to the new node added.*/
-   void add(const ListNode::contextArr& context);
-   
-   /** Deletes all the nodes in the ContextList.
+
+   /** Adds the position of a new occurrence to the end of the ContextList object.
+   @param position The position of the keyword in the concordance's WordStream.
+   @pre position must be after the last position in the list.
+   @post The gap from the last position will be written to the last block, or a new block will be started with the position if the gap does not fit.*/
+   void add(uint64_t position);
+
+   /** Deletes all the blocks in the ContextList.
    @pre None.
-   @post The ContextList will be empty, memory for the nodes has been deallocated. */
+   @post The ContextList will be empty. Blocks created with new will be deallocated. Blocks created in an arena are left for the arena to release in bulk. */
    void clear();
-   
-   /**Prints each context in the list as a string to cout. Each context will be on one line forming three columns. The first column will contain the words before the keyword and will be right justified. The second column will contain the keyword and will be centered. The thrid column will contain the words after the keyword and will be left justified.
-   @param preKeyLen The total length of the words before the keyword.
-   @param keyLen The length of the keyword.
-   @param postKeyLen The total length of the words after the keyword.
-   @pre All arguments supplied must be of type int.
-   @post The context for each ListNode in the ContextList will be displayed to cout. */
-   void printFormatted(int preKeyLen,int keyLen, int postKeyLen) const;
-  
+
+   /** Sets the arena new blocks are created in.
+   @param nodeArena The arena the blocks are created in, or nullptr to create them with new.
+   @pre The list must be empty. The arena must outlive the list.
+   @post Blocks added to the list will be created in the arena. */
+   void setArena(NodeArena* nodeArena);
+
+   /** Adds a copy of every position in another ContextList to the end of this one.
+   @param other The list whose positions are copied.
+   @pre other must not be this list, and its positions must come after the positions of this list.
+   @post The positions of other will follow the positions of this list in their original order. */
+   void addAll(const ContextList& other);
+
+   /** Moves every block of another ContextList to the end of this one.
+   @param other The list whose blocks are moved.
+   @param shift The number added to each position of other, for positions in a word stream that was appended to another one.
+   @pre other must not be this list. Both lists must create their blocks the same way: both with new, or in arenas that will be released together. The shifted positions of other must come after the positions of this list.
+   @post The positions of other, shifted, will follow the positions of this list in their original order, and other will be empty. Since only the first position of a block is stored whole, shifting touches each block once, and no gaps are copied or allocated. */
+   void splice(ContextList& other, int64_t shift = 0);
+
+   /**Writes each context in the list as a row of the concordance. Each row forms three columns. The first column will contain the words before the keyword and will be right justified. The second column will contain the keyword and will be centered. The third column will contain the words after the keyword and will be left justified.
+   @param writer The OutputWriter to write the rows to.
+   @param vocab The Vocabulary the context word IDs were interned in.
+   @param words The word stream the positions are in.
+   @pre The writer's columns must be set. vocab must be the Vocabulary used to build the stream.
+   @post A row for each position in the ContextList will be written to the writer, in the order of the list. */
+   template <int BEFORE, int AFTER>
+   void writeFormatted(OutputWriter& writer, const Vocabulary& vocab, const WordStream& words) const;
+
+   /**Returns the number of contexts in the list.
+   @return The number of positions in the list.
+   @pre none
+   @post The number of contexts will be returned as a size_t. */
+   size_t size() const;
+
 private:
-   /**Copies a chain of ListNode objects.
-   @pre origHead must be a pointer to a ListNode object or nullptr.
-   @post Returns the deep copy of a ListNode pointer to the first node in a chain of copied nodes.
-   @param origHead The pointer to the first node in the chain to be copied.
-   @return The  head pointer to the copied chain of nodes.
-    */
-   ListNode* copyNodes(const ListNode* origHead);
-   
-   ListNode* head; //pointer to first ListNode
-   ListNode* tail; //pointer to last ListNode
+   /**Starts a new block at the end of the list.
+   @param position The position of the first occurrence in the block.
+   @pre none
+   @post The new block, twice the size of the last one up to MAX_BLOCK_BYTES, will be the last block of the list, holding the position. */
+   void addBlock(uint64_t position);
+
+   /**Returns the number of bytes a gap takes as a varint.
+   @param gap The gap between two positions.
+   @return The number of bytes, from 1 to MAX_GAP_BYTES. */
+   int static gapBytes(uint64_t gap);
+
+   /**Writes a gap as a varint, the lowest 7 bits first, the high bit of each byte set if another follows.
+   @param dst Where the gap is written.
+   @param gap The gap between two positions.
+   @return A pointer to the byte after the varint.
+   @pre dst must have room for gapBytes(gap) bytes. */
+   unsigned char static* writeGap(unsigned char* dst, uint64_t gap);
+
+   /**Reads a gap written by writeGap.
+   @param src The first byte of the varint.
+   @param gap Set to the gap read.
+   @return A pointer to the byte after the varint. */
+   const unsigned char static* readGap(const unsigned char* src, uint64_t& gap);
+
+   Block* head; //pointer to first block
+   Block* tail; //pointer to last block
+   NodeArena* arena; //arena the blocks are created in, or nullptr if they are created with new
+   size_t numContexts; //number of positions in the list
+   uint64_t lastPosition; //position of the last occurrence, the gap to the next is from here
+
 
-   
 };
 #endif
@@ -0,0 +1,141 @@
+/*
+file name: CorpusReader.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the CorpusReader class. A CorpusReader maps the corpus file into memory and splits it into words in place. Each word is handed back as a string_view into the mapped file, so no word is copied until the concordance decides to keep it. Words are bounded by white space, the same rule stream extraction with >> uses. If the file cannot be mapped (for example a pipe or an empty file) it is read into a buffer instead.
+*/
+
+#include "CorpusReader.h"
+
+#include <fstream>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/** The default constructor for the CorpusReader class.
+Constructs a CorpusReader with no file open. */
+CorpusReader::CorpusReader() : begin(nullptr), end(nullptr), cursor(nullptr), mapping(nullptr), mappedSize(0)
+{
+}
+
+/** The destructor for the CorpusReader class.
+Unmaps the corpus file when its lifetime ends. */
+CorpusReader::~CorpusReader()
+{
+   close();
+}
+
+/**Opens the corpus file and maps it into memory.
+@param fileName The name of the corpus file.
+@return True if the file could be opened and mapped or read, false otherwise.
+@pre fileName must be of type string.
+@post If true is returned, the next word read will be the first word in the file. Any file opened before will be closed. */
+bool CorpusReader::open(const string& fileName)
+{
+   close();
+   
+   int fd = ::open(fileName.c_str(), O_RDONLY);
+   if ( fd < 0 )
+      return false;
+   
+   //map regular, non-empty files directly
+   struct stat info;
+   if ( fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0 )
+   {
+      void* addr = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if ( addr != MAP_FAILED )
+      {
+         //the corpus is read front to back once
+         madvise(addr, (size_t)info.st_size, MADV_SEQUENTIAL);
+         mapping = addr;
+         mappedSize = (size_t)info.st_size;
+         begin = (const char*)addr;
+      }
+   }
+   ::close(fd);
+   
+   //the file could not be mapped, read it into the buffer instead
+   if ( mapping == nullptr )
+   {
+      ifstream fileReader(fileName, ios::binary);
+      if ( !fileReader.is_open() )
+         return false;
+      buffer.assign(istreambuf_iterator<char>(fileReader), istreambuf_iterator<char>());
+      begin = buffer.data();
+      mappedSize = buffer.size();
+   }
+   
+   end = begin + mappedSize;
+   cursor = begin;
+   return true;
+}
+
+/**Reads the words of a corpus that is already in memory, such as one chunk of a corpus opened by another reader.
+@param text The text to be split into words.
+@pre The text must stay valid while words are read from it.
+@post The next word read will be the first word in the text. Any file opened before will be closed. The text is not copied or owned by the reader. */
+void CorpusReader::openText(string_view text)
+{
+   close();
+   begin = text.data();
+   end = begin + text.length();
+   cursor = begin;
+}
+
+/**Returns the whole text of the open corpus.
+@return A view of the corpus.
+@pre none
+@post The view stays valid until the file is closed. If no file is open the view will be empty. */
+string_view CorpusReader::getContents() const
+{
+   return string_view(begin, (size_t)(end - begin));
+}
+
+/**Closes the corpus file.
+@pre none
+@post The file will be unmapped and no words will be left to read. Views returned by nextWord will no longer be valid. */
+void CorpusReader::close()
+{
+   if ( mapping != nullptr )
+      munmap(mapping, mappedSize);
+   mapping = nullptr;
+   mappedSize = 0;
+   buffer.clear();
+   begin = end = cursor = nullptr;
+}
+
+/**Reads the next word in the corpus.
+@param word The view to set to the word read.
+@return True if a word was read, false if the end of the corpus has been reached.
+@pre A file must have been opened.
+@post If true is returned, word will view the next run of non white space characters in the file. The view stays valid until the file is closed. */
+bool CorpusReader::nextWord(string_view& word)
+{
+   //skip the white space before the word
+   while ( cursor != end && isSpace(*cursor) )
+      cursor++;
+   
+   //nothing but white space was left
+   if ( cursor == end )
+      return false;
+   
+   //the word runs until the next white space or the end of the corpus
+   const char* wordStart = cursor;
+   while ( cursor != end && !isSpace(*cursor) )
+      cursor++;
+   
+   word = string_view(wordStart, (size_t)(cursor - wordStart));
+   return true;
+}
+
+/**Checks if a character is white space in the C locale.
+@param c The character to be checked.
+@return True if the character is a space, tab, newline, vertical tab, form feed, or carriage return.
+@pre none
+@post True will be returned if the character separates words, false otherwise. */
+bool CorpusReader::isSpace(char c)
+{
+   return c == ' ' || (c >= '\t' && c <= '\r');
+}
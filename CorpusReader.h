@@ -0,0 +1,79 @@
+/*
+file name: CorpusReader.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the CorpusReader class. A CorpusReader maps the corpus file into memory and splits it into words in place. Each word is handed back as a string_view into the mapped file, so no word is copied until the concordance decides to keep it. Words are bounded by white space, the same rule stream extraction with >> uses. If the file cannot be mapped (for example a pipe or an empty file) it is read into a buffer instead.
+*/
+
+#ifndef CORPUSREADER_H
+#define CORPUSREADER_H
+
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+class CorpusReader
+{
+public:
+   
+   /** The default constructor for the CorpusReader class.
+   Constructs a CorpusReader with no file open. */
+   CorpusReader();
+   
+   /** The destructor for the CorpusReader class.
+   Unmaps the corpus file when its lifetime ends. */
+   virtual ~CorpusReader();
+   
+   /**Opens the corpus file and maps it into memory.
+   @param fileName The name of the corpus file.
+   @return True if the file could be opened and mapped or read, false otherwise.
+   @pre fileName must be of type string.
+   @post If true is returned, the next word read will be the first word in the file. Any file opened before will be closed. */
+   bool open(const string& fileName);
+   
+   /**Reads the words of a corpus that is already in memory, such as one chunk of a corpus opened by another reader.
+   @param text The text to be split into words.
+   @pre The text must stay valid while words are read from it.
+   @post The next word read will be the first word in the text. Any file opened before will be closed. The text is not copied or owned by the reader. */
+   void openText(string_view text);
+   
+   /**Returns the whole text of the open corpus.
+   @return A view of the corpus.
+   @pre none
+   @post The view stays valid until the file is closed. If no file is open the view will be empty. */
+   string_view getContents() const;
+   
+   /**Closes the corpus file.
+   @pre none
+   @post The file will be unmapped and no words will be left to read. Views returned by nextWord will no longer be valid. */
+   void close();
+   
+   /**Reads the next word in the corpus.
+   @param word The view to set to the word read.
+   @return True if a word was read, false if the end of the corpus has been reached.
+   @pre A file must have been opened.
+   @post If true is returned, word will view the next run of non white space characters in the file. The view stays valid until the file is closed. */
+   bool nextWord(string_view& word);
+   
+   /**Checks if a character is white space in the C locale.
+   @param c The character to be checked.
+   @return True if the character is a space, tab, newline, vertical tab, form feed, or carriage return.
+   @pre none
+   @post True will be returned if the character separates words, false otherwise. */
+   bool static isSpace(char c);
+   
+private:
+   //a reader owns its mapping, so it cannot be copied
+   CorpusReader(const CorpusReader&);
+   CorpusReader& operator=(const CorpusReader&);
+   
+   const char* begin; //first character of the corpus
+   const char* end; //one past the last character of the corpus
+   const char* cursor; //where the next word is searched for
+   void* mapping; //address of the memory mapped file, or nullptr if the file was read into buffer
+   size_t mappedSize; //number of bytes mapped
+   string buffer; //contents of the file when it could not be mapped
+};
+
+#endif
@@ -0,0 +1,390 @@
+/*
+file name: HashConcordance.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the HashConcordance class. The HashConcordance class is a Concordance engine that collects the context lists in an open-addressing hash table keyed by the keyword, so adding an occurrence costs an O(1) probe instead of a descent through an ordered tree. The keywords are sorted only once, when the concordance is printed, with a multikey quicksort, which produces the same alphabetical output as the BinarySearchTree. It is a template over the window of its contexts.
+*/
+
+#include "HashConcordance.h"
+
+#include <algorithm>
+
+using namespace std;
+
+/** The default constructor for the HashConcordance class.
+Constructs an empty HashConcordance object with a small empty table. */
+template <int BEFORE, int AFTER>
+HashConcordance<BEFORE, AFTER>::HashConcordance() : WindowedConcordance<BEFORE, AFTER>(), slots(INITIAL_SLOTS, Slot{0, 0})
+{
+}
+
+/** The destructor for the HashConcordance class.
+Destroys the HashConcordance object, freeing the memory allocated for the keywords and their context lists when its lifetime ends.*/
+template <int BEFORE, int AFTER>
+HashConcordance<BEFORE, AFTER>::~HashConcordance()
+{
+}
+
+/** Tests whether the hash table is empty.
+@return True if no keywords have been added, false otherwise.
+@pre none
+@post Returns true if the hash table is empty, false otherwise.*/
+template <int BEFORE, int AFTER>
+bool HashConcordance<BEFORE, AFTER>::isEmpty() const
+{
+   return entries.empty();
+}
+
+/**Finds the context list of a keyword, adding the keyword to the hash table with an empty context list first if it is not in the table yet.
+@param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+@return The keyword's context list.
+@pre The keyword must not be a stop word.
+@post The keyword will be in the table. If the table is more than half full it will be doubled in size. */
+template <int BEFORE, int AFTER>
+ContextList& HashConcordance<BEFORE, AFTER>::findOrInsert(const string& keyWord)
+{
+   size_t keyHash = hasher(keyWord);
+   size_t mask = slots.size() - 1;
+   
+   //probe linearly from the keyword's home slot
+   for (size_t i = keyHash & mask; ; i = (i + 1) & mask)
+   {
+      Slot& slot = slots[i];
+      
+      //empty slot, the keyword is not in the table yet
+      if ( slot.entry == 0 )
+      {
+         entries.emplace_back();
+         Entry& entry = entries.back();
+         entry.keyWord = keyWord;
+         entry.hash = keyHash;
+         entry.contextList.setArena(&nodeArena);
+         slot.hash = (uint32_t)keyHash;
+         slot.entry = (uint32_t)entries.size();
+         
+         //keep the table at most half full so probe sequences stay short
+         if ( entries.size() * 2 > slots.size() )
+            grow();
+         return entry.contextList;
+      }
+      
+      //only compare the strings when the stored hash bits match
+      if ( slot.hash == (uint32_t)keyHash )
+      {
+         Entry& entry = entries[slot.entry - 1];
+         if ( entry.keyWord == keyWord )
+            return entry.contextList;
+      }
+   }
+}
+
+/**Finds the entry of a keyword.
+@param keyWord A keyword, stripped of punctuation and lowercase.
+@return The keyword's entry, or nullptr if the keyword is not in the table.
+@pre none
+@post The table is unchanged. */
+template <int BEFORE, int AFTER>
+const typename HashConcordance<BEFORE, AFTER>::Entry* HashConcordance<BEFORE, AFTER>::find(const string& keyWord) const
+{
+   size_t keyHash = hasher(keyWord);
+   size_t mask = slots.size() - 1;
+   
+   //probe linearly from the keyword's home slot until the keyword or an empty slot is found
+   for (size_t i = keyHash & mask; slots[i].entry != 0; i = (i + 1) & mask)
+   {
+      const Entry& entry = entries[slots[i].entry - 1];
+      if ( slots[i].hash == (uint32_t)keyHash && entry.keyWord == keyWord )
+         return &entry;
+   }
+   return nullptr;
+}
+
+/**Moves every keyword's context list to the end of the keyword's context list in another concordance, once the words the contexts are read from are in target's word stream.
+@param target The concordance the contexts are moved to.
+@param shift The number added to a position in this concordance's word stream to give the position of the same word in target's, as returned by target's placeWords.
+@pre Every keyword of this concordance must be in the run of words target placed, and target's words around the run must be the context of the words at its edges.
+@post Each context list that is not a stop word in target will be moved to target, keeping its order, with the positions moved along with the words. The maximum lengths of target will be updated, and target will take over this concordance's NodeArena. */
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::moveContextsInto(WindowedConcordance<BEFORE, AFTER>& target, int64_t shift)
+{
+   //the contexts are positions, so they move with the words by the same amount
+   for (size_t e = 0; e < entries.size(); e++)
+      target.appendContexts(entries[e].keyWord, entries[e].contextList, shift);
+   target.mergeMaxLengths(*this);
+   
+   //the moved blocks live in this concordance's arena, which target now releases
+   target.adoptNodes(*this);
+}
+
+/**Doubles the size of the hash table and places every entry in its new slot.
+@pre none
+@post The table will be twice as large and every entry can be found by probing from its hash. */
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::grow()
+{
+   vector<Slot> newSlots(slots.size() * 2, Slot{0, 0});
+   size_t mask = newSlots.size() - 1;
+   
+   //reinsert each entry using its stored hash
+   for (size_t e = 0; e < entries.size(); e++)
+   {
+      size_t i = entries[e].hash & mask;
+      while ( newSlots[i].entry != 0 )
+         i = (i + 1) & mask;
+      newSlots[i].hash = (uint32_t)entries[e].hash;
+      newSlots[i].entry = (uint32_t)(e + 1);
+   }
+   slots.swap(newSlots);
+}
+
+/** Sorts the keywords in the hash table and collects the context list of each keyword in alphabetical order.
+@param lists The vector to store the context lists in.
+@pre none
+@post lists will hold the context list of each keyword in alphabetical order.*/
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::sortedLists(vector<const ContextList*>& lists) const
+{
+   const vector<uint32_t>& sorted = sortedTable();
+   
+   //the lists are already in corpus order
+   lists.clear();
+   lists.reserve(sorted.size());
+   for (size_t e = 0; e < sorted.size(); e++)
+      lists.push_back(&entries[sorted[e]].contextList);
+}
+
+/** Collects the context lists of the keywords a query matches, in alphabetical order.
+@param query The keywords to collect.
+@param lists The vector to store the context lists in.
+@pre none
+@post lists will hold the context list of each matching keyword in alphabetical order. An exact keyword is found with one probe of the table. A prefix or a range is found with a binary search of the sorted table.*/
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::matchingLists(const KeyQuery& query, vector<const ContextList*>& lists) const
+{
+   lists.clear();
+   KeyWalk* walk = walkKeys(&query);
+   for ( ; !walk->atEnd(); walk->next())
+      lists.push_back(&walk->getContextList());
+   delete walk;
+}
+
+/** Starts an EntryWalk over the keywords a query matches, in alphabetical order.
+@param query The keywords to visit, or nullptr to visit every keyword.
+@return A new EntryWalk at the first matching keyword, which the caller must delete.
+@pre The table must not be changed, and the query must not be destroyed, while the walk is used.
+@post The table will be sorted first if keywords were added since it was last sorted, except for an exact keyword, which is found with one probe. The walk will hold an index into the sorted table, which it shares with every copy of it. */
+template <int BEFORE, int AFTER>
+KeyWalk* HashConcordance<BEFORE, AFTER>::walkKeys(const KeyQuery* query) const
+{
+   //a single keyword is looked up directly
+   if ( query != nullptr && query->isSingleKey() )
+   {
+      const Entry* entry = find(query->getFirst());
+      //a keyword not in the table gives a walk already past its last keyword
+      if ( entry == nullptr )
+         return new EntryWalk(this, sortedOrder.size(), query);
+      return new EntryWalk(this, entry);
+   }
+   
+   //the matches are next to each other in the sorted table, after every keyword before them
+   const vector<uint32_t>& sorted = sortedTable();
+   size_t first = 0;
+   if ( query != nullptr )
+   {
+      first = partition_point(sorted.begin(), sorted.end(), [this, query](uint32_t e)
+         { return query->isBefore(entries[e].keyWord); }) - sorted.begin();
+   }
+   return new EntryWalk(this, first, query);
+}
+
+/** Collects the entries of the hash table sorted by keyword.
+@param sorted The vector to store pointers to the entries in.
+@pre none
+@post sorted will hold a pointer to each entry in alphabetical order of the keywords.*/
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::sortedEntries(vector<const Entry*>& sorted) const
+{
+   //collect the entries and sort them once by keyword
+   sorted.clear();
+   sorted.reserve(entries.size());
+   for (size_t e = 0; e < entries.size(); e++)
+      sorted.push_back(&entries[e]);
+   sortByKeyword(sorted);
+}
+
+/**Sorts entries of the hash table by keyword with a StringSort, which reads only the bytes of the keywords.
+@param sorted Pointers to the entries to be sorted.
+@pre none
+@post sorted will be in alphabetical order of the keywords, the order operator< gives. */
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::sortByKeyword(vector<const Entry*>& sorted)
+{
+   //sort the keywords alone, then put the entries in their order
+   vector<StringSort::Key> keys;
+   keys.reserve(sorted.size());
+   for (size_t e = 0; e < sorted.size(); e++)
+      keys.push_back(StringSort::makeKey(sorted[e]->keyWord, e));
+   StringSort::sort(keys);
+
+   vector<const Entry*> unsorted;
+   unsorted.swap(sorted);
+   sorted.reserve(keys.size());
+   for (size_t k = 0; k < keys.size(); k++)
+      sorted.push_back(unsorted[keys[k].index]);
+}
+
+/** Returns the entries of the hash table in alphabetical order of their keywords, sorting them only if keywords were added since they were last sorted.
+@return The indices of the entries in alphabetical order, valid until a keyword is added or the table is cleared.
+@pre The table must not be sorted from two threads at once.
+@post The order will be kept so the next call costs nothing if no keyword has been added. */
+template <int BEFORE, int AFTER>
+const vector<uint32_t>& HashConcordance<BEFORE, AFTER>::sortedTable() const
+{
+   //entries are only ever added, so an order as long as the table is still the order of the table
+   if ( sortedOrder.size() != entries.size() )
+   {
+      vector<StringSort::Key> keys;
+      keys.reserve(entries.size());
+      for (size_t e = 0; e < entries.size(); e++)
+         keys.push_back(StringSort::makeKey(entries[e].keyWord, e));
+      StringSort::sort(keys);
+      
+      sortedOrder.resize(keys.size());
+      for (size_t k = 0; k < keys.size(); k++)
+         sortedOrder[k] = keys[k].index;
+   }
+   return sortedOrder;
+}
+
+/** Removes every keyword and context from the hash table.
+@pre No context list of the table is used again.
+@post The table will be empty and back to its initial size, and the NodeArena the contexts were created in will be released. The Vocabulary and the maximum lengths are kept. */
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::clearTable()
+{
+   //the lists only forget their blocks, which are freed with the arena
+   deque<Entry>().swap(entries);
+   vector<Slot>(INITIAL_SLOTS, Slot{0, 0}).swap(slots);
+   vector<uint32_t>().swap(sortedOrder);
+   nodeArena.release();
+}
+
+/** Estimates the memory held by the hash table and its contexts.
+@return The approximate number of bytes used by the slots, the entries, the NodeArena, and the word stream.
+@pre none
+@post The estimate will be returned as a size_t. */
+template <int BEFORE, int AFTER>
+size_t HashConcordance<BEFORE, AFTER>::tableBytes() const
+{
+   return nodeArena.getBlockBytes() + words.getBytes() + slots.size() * sizeof(Slot)
+      + entries.size() * (sizeof(Entry) + ENTRY_OVERHEAD);
+}
+
+/**Adds the counters of the hash table to a report.
+@param runStats The RunStats the counters are set in.
+@pre none
+@post The report will hold the counters of every concordance, the number of keywords, and the number of slots of the table. */
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::collectStats(RunStats& runStats) const
+{
+   Concordance::collectStats(runStats);
+   runStats.setCounter("distinct_keys", (double)entries.size());
+   runStats.setCounter("hash_slots", (double)slots.size());
+}
+
+/** Constructor for the EntryWalk class that accepts the table and the range of the sorted table to visit.
+@param table The table whose keywords are visited.
+@param first The index in the sorted table of the first keyword to visit.
+@param query The keywords to visit, or nullptr to visit every keyword from first on.
+@pre The table must be sorted, and must not change while the walk is used. */
+template <int BEFORE, int AFTER>
+HashConcordance<BEFORE, AFTER>::EntryWalk::EntryWalk(const HashConcordance* table, size_t first, const KeyQuery* query)
+   : table(table), query(query), index(first), end(table->sortedOrder.size()), single(nullptr)
+{
+   checkQuery();
+}
+
+/** Constructor for the EntryWalk class that accepts a single entry to visit.
+@param table The table the entry is in.
+@param entry The entry.
+@pre The table must not change while the walk is used. */
+template <int BEFORE, int AFTER>
+HashConcordance<BEFORE, AFTER>::EntryWalk::EntryWalk(const HashConcordance* table, const Entry* entry)
+   : table(table), query(nullptr), index(0), end(1), single(entry)
+{
+}
+
+/**Makes a copy of the walk at the same keyword.
+@return A new walk the caller must delete.
+@pre none
+@post The copy will share the sorted table with this walk, so it costs the same however many keywords there are. */
+template <int BEFORE, int AFTER>
+KeyWalk* HashConcordance<BEFORE, AFTER>::EntryWalk::clone() const
+{
+   return new EntryWalk(*this);
+}
+
+/**Tests whether the walk is past the last keyword.
+@return True if there are no keywords left, false otherwise.
+@pre none
+@post The walk is unchanged. */
+template <int BEFORE, int AFTER>
+bool HashConcordance<BEFORE, AFTER>::EntryWalk::atEnd() const
+{
+   return index >= end;
+}
+
+/**Moves to the next keyword.
+@pre The walk must not be past the last keyword.
+@post The walk will be at the next keyword of the sorted table, or past the last keyword if it is after the query. */
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::EntryWalk::next()
+{
+   index++;
+   checkQuery();
+}
+
+/**Returns the current keyword.
+@return The keyword.
+@pre The walk must not be past the last keyword.
+@post The keyword will be returned as a view of the entry's keyword. */
+template <int BEFORE, int AFTER>
+string_view HashConcordance<BEFORE, AFTER>::EntryWalk::getKey() const
+{
+   return getEntry().keyWord;
+}
+
+/**Returns the context list of the current keyword.
+@return The context list.
+@pre The walk must not be past the last keyword.
+@post The context list will be returned as a const reference. */
+template <int BEFORE, int AFTER>
+const ContextList& HashConcordance<BEFORE, AFTER>::EntryWalk::getContextList() const
+{
+   return getEntry().contextList;
+}
+
+/**Returns the entry of the current keyword.
+@return The entry.
+@pre The walk must not be past the last keyword.
+@post The entry will be returned as a const reference. */
+template <int BEFORE, int AFTER>
+const typename HashConcordance<BEFORE, AFTER>::Entry& HashConcordance<BEFORE, AFTER>::EntryWalk::getEntry() const
+{
+   return single != nullptr ? *single : table->entries[table->sortedOrder[index]];
+}
+
+/**Ends the walk if the current keyword is after the query.
+@pre none
+@post The walk will be past the last keyword if its keyword is after the matches. */
+template <int BEFORE, int AFTER>
+void HashConcordance<BEFORE, AFTER>::EntryWalk::checkQuery()
+{
+   if ( query != nullptr && index < end && query->isAfter(getKey()) )
+      index = end;
+}
+
+//compile the HashConcordance of every window
+#define INSTANTIATE(BEFORE, AFTER) template class HashConcordance<BEFORE, AFTER>;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
@@ -0,0 +1,214 @@
+/*
+file name: HashConcordance.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the HashConcordance class. The HashConcordance class is a Concordance engine that collects the context lists in an open-addressing hash table keyed by the keyword, so adding an occurrence costs an O(1) probe instead of a descent through an ordered tree. The keywords are sorted only once, when the concordance is printed, with a multikey quicksort, which produces the same alphabetical output as the BinarySearchTree. The sorted order is kept, so a RowCursor walks it with an index and prefix and range queries find their matches with a binary search. It is a template over the window of its contexts.
+*/
+
+#ifndef HASHCONCORDANCE_H
+#define HASHCONCORDANCE_H
+
+#include <deque>
+#include <functional>
+#include <cstdint>
+#include "WindowedConcordance.h"
+#include "StringSort.h"
+
+template <int BEFORE, int AFTER>
+class HashConcordance : public WindowedConcordance<BEFORE, AFTER>
+{
+   
+public:
+   
+   /** The default constructor for the HashConcordance class.
+   Constructs an empty HashConcordance object with a small empty table. */
+   HashConcordance();
+   
+   /** The destructor for the HashConcordance class.
+   Destroys the HashConcordance object, freeing the memory allocated for the keywords and their context lists when its lifetime ends.*/
+   virtual ~HashConcordance();
+   
+   /** Tests whether the hash table is empty.
+   @return True if no keywords have been added, false otherwise.
+   @pre none
+   @post Returns true if the hash table is empty, false otherwise.*/
+   bool isEmpty() const override;
+   
+   /**Moves every keyword's context list to the end of the keyword's context list in another concordance, once the words the contexts are read from are in target's word stream.
+   @param target The concordance the contexts are moved to.
+   @param shift The number added to a position in this concordance's word stream to give the position of the same word in target's, as returned by target's placeWords.
+   @pre Every keyword of this concordance must be in the run of words target placed, and target's words around the run must be the context of the words at its edges.
+   @post Each context list that is not a stop word in target will be moved to target, keeping its order, with the positions moved along with the words. The maximum lengths of target will be updated, and target will take over this concordance's NodeArena. */
+   void moveContextsInto(WindowedConcordance<BEFORE, AFTER>& target, int64_t shift);
+   
+   /**Adds the counters of the hash table to a report.
+   @param runStats The RunStats the counters are set in.
+   @pre none
+   @post The report will hold the counters of every concordance, the number of keywords, and the number of slots of the table. */
+   void collectStats(RunStats& runStats) const override;
+   
+protected:
+   using Concordance::vocabulary;
+   using Concordance::nodeArena;
+   using Concordance::words;
+   
+   //a keyword and its list of contexts
+   struct Entry
+   {
+      string keyWord; //word from corpus
+      size_t hash; //hash of the keyword, kept so the table can grow without rehashing strings
+      ContextList contextList; //list of contexts for word
+   };
+   
+   /**Finds the context list of a keyword, adding the keyword to the hash table with an empty context list first if it is not in the table yet.
+   @param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+   @return The keyword's context list.
+   @pre The keyword must not be a stop word.
+   @post The keyword will be in the table. If the table is more than half full it will be doubled in size. */
+   ContextList& findOrInsert(const string& keyWord) override;
+   
+   /** Sorts the keywords in the hash table and collects the context list of each keyword in alphabetical order.
+   @param lists The vector to store the context lists in.
+   @pre none
+   @post lists will hold the context list of each keyword in alphabetical order.*/
+   void sortedLists(vector<const ContextList*>& lists) const override;
+   
+   /** Collects the context lists of the keywords a query matches, in alphabetical order.
+   @param query The keywords to collect.
+   @param lists The vector to store the context lists in.
+   @pre none
+   @post lists will hold the context list of each matching keyword in alphabetical order. An exact keyword is found with one probe of the table. A prefix or a range is found with a binary search of the sorted table.*/
+   void matchingLists(const KeyQuery& query, vector<const ContextList*>& lists) const override;
+   
+   /** Starts an EntryWalk over the keywords a query matches, in alphabetical order.
+   @param query The keywords to visit, or nullptr to visit every keyword.
+   @return A new EntryWalk at the first matching keyword, which the caller must delete.
+   @pre The table must not be changed, and the query must not be destroyed, while the walk is used.
+   @post The table will be sorted first if keywords were added since it was last sorted, except for an exact keyword, which is found with one probe. The walk will hold an index into the sorted table, which it shares with every copy of it. */
+   KeyWalk* walkKeys(const KeyQuery* query) const override;
+   
+   /** Collects the entries of the hash table sorted by keyword.
+   @param sorted The vector to store pointers to the entries in.
+   @pre none
+   @post sorted will hold a pointer to each entry in alphabetical order of the keywords.*/
+   void sortedEntries(vector<const Entry*>& sorted) const;
+   
+   /** Returns the entries of the hash table in alphabetical order of their keywords, sorting them only if keywords were added since they were last sorted.
+   @return The indices of the entries in alphabetical order, valid until a keyword is added or the table is cleared.
+   @pre The table must not be sorted from two threads at once.
+   @post The order will be kept so the next call costs nothing if no keyword has been added. */
+   const vector<uint32_t>& sortedTable() const;
+   
+   /** Removes every keyword and context from the hash table.
+   @pre No context list of the table is used again.
+   @post The table will be empty and back to its initial size, and the NodeArena the contexts were created in will be released. The Vocabulary and the maximum lengths are kept. */
+   void clearTable();
+   
+   /** Estimates the memory held by the hash table and its contexts.
+   @return The approximate number of bytes used by the slots, the entries, the NodeArena, and the word stream.
+   @pre none
+   @post The estimate will be returned as a size_t. */
+   size_t tableBytes() const;
+   
+private:
+   
+   //a slot in the hash table, entry is the index into entries plus 1 so that 0 marks an empty slot
+   struct Slot
+   {
+      uint32_t hash; //low bits of the keyword's hash, compared before the keyword itself
+      uint32_t entry; //index of the Entry plus 1, or 0 if the slot is empty
+   };
+   
+   //a walk over the keywords of the table in alphabetical order, as an index into the sorted table
+   class EntryWalk : public KeyWalk
+   {
+   public:
+      /** Constructor for the EntryWalk class that accepts the table and the range of the sorted table to visit.
+      @param table The table whose keywords are visited.
+      @param first The index in the sorted table of the first keyword to visit.
+      @param query The keywords to visit, or nullptr to visit every keyword from first on.
+      @pre The table must be sorted, and must not change while the walk is used. */
+      EntryWalk(const HashConcordance* table, size_t first, const KeyQuery* query);
+      
+      /** Constructor for the EntryWalk class that accepts a single entry to visit.
+      @param table The table the entry is in.
+      @param entry The entry.
+      @pre The table must not change while the walk is used. */
+      EntryWalk(const HashConcordance* table, const Entry* entry);
+      
+      /**Makes a copy of the walk at the same keyword.
+      @return A new walk the caller must delete.
+      @pre none
+      @post The copy will share the sorted table with this walk, so it costs the same however many keywords there are. */
+      KeyWalk* clone() const override;
+      
+      /**Tests whether the walk is past the last keyword.
+      @return True if there are no keywords left, false otherwise.
+      @pre none
+      @post The walk is unchanged. */
+      bool atEnd() const override;
+      
+      /**Moves to the next keyword.
+      @pre The walk must not be past the last keyword.
+      @post The walk will be at the next keyword of the sorted table, or past the last keyword if it is after the query. */
+      void next() override;
+      
+      /**Returns the current keyword.
+      @return The keyword.
+      @pre The walk must not be past the last keyword.
+      @post The keyword will be returned as a view of the entry's keyword. */
+      string_view getKey() const override;
+      
+      /**Returns the context list of the current keyword.
+      @return The context list.
+      @pre The walk must not be past the last keyword.
+      @post The context list will be returned as a const reference. */
+      const ContextList& getContextList() const override;
+      
+   private:
+      /**Returns the entry of the current keyword.
+      @return The entry.
+      @pre The walk must not be past the last keyword.
+      @post The entry will be returned as a const reference. */
+      const Entry& getEntry() const;
+      
+      /**Ends the walk if the current keyword is after the query.
+      @pre none
+      @post The walk will be past the last keyword if its keyword is after the matches. */
+      void checkQuery();
+      
+      const HashConcordance* table; //the table whose keywords are visited
+      const KeyQuery* query; //the keywords to visit, or nullptr for every keyword
+      size_t index; //the index of the current keyword in the sorted table
+      size_t end; //one past the index of the last keyword to visit
+      const Entry* single; //the entry of a walk over one entry, or nullptr for a walk over the sorted table
+   };
+   
+   static constexpr size_t ENTRY_OVERHEAD = 16; //estimated bytes per entry beyond sizeof(Entry), for the deque and long keywords
+   static const size_t INITIAL_SLOTS = 1024; //size of a new table, must be a power of 2
+   
+   /**Doubles the size of the hash table and places every entry in its new slot.
+   @pre none
+   @post The table will be twice as large and every entry can be found by probing from its hash. */
+   void grow();
+   
+   /**Finds the entry of a keyword.
+   @param keyWord A keyword, stripped of punctuation and lowercase.
+   @return The keyword's entry, or nullptr if the keyword is not in the table.
+   @pre none
+   @post The table is unchanged. */
+   const Entry* find(const string& keyWord) const;
+   
+   /**Sorts entries of the hash table by keyword with a StringSort, which reads only the bytes of the keywords.
+   @param sorted Pointers to the entries to be sorted.
+   @pre none
+   @post sorted will be in alphabetical order of the keywords, the order operator< gives. */
+   void static sortByKeyword(vector<const Entry*>& sorted);
+   
+   deque<Entry> entries; //the keywords in the order they were first added, a deque so entries never move
+   vector<Slot> slots; //the open-addressing table, probed linearly
+   hash<string> hasher; //hash function for the keywords
+   mutable vector<uint32_t> sortedOrder; //indices of the entries in alphabetical order of their keywords as of the last sort, sorted again once entries has grown past it
+};
+
+#endif
@@ -0,0 +1,106 @@
+/*
+file name: KeyQuery.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the KeyQuery class. A KeyQuery selects the keywords of a concordance to print: one exact keyword, every keyword starting with a prefix, or every keyword in an alphabetical range. The keywords a query matches are always next to each other in alphabetical order, so an engine can find the first one with a search and stop at the first keyword after the matches.
+*/
+
+#include "KeyQuery.h"
+
+using namespace std;
+
+/**Constructor for the KeyQuery class that accepts the kind of query and its bounds.
+@param kind The kind of query.
+@param first The keyword, the prefix, or the first keyword of the range.
+@param last The last keyword of a range, unused otherwise. */
+KeyQuery::KeyQuery(Kind kind, const string& first, const string& last) : kind(kind), first(first), last(last)
+{
+}
+
+/**Creates a query matching one keyword.
+@param keyWord The keyword, stripped of punctuation and lowercase.
+@return The query.
+@pre none
+@post The query will match only keyWord. */
+KeyQuery KeyQuery::exact(const string& keyWord)
+{
+   return KeyQuery(EXACT, keyWord, keyWord);
+}
+
+/**Creates a query matching every keyword that starts with a prefix.
+@param prefix The first characters of the keywords, in lowercase.
+@return The query.
+@pre none
+@post The query will match every keyword starting with prefix, including prefix itself. */
+KeyQuery KeyQuery::prefix(const string& prefix)
+{
+   return KeyQuery(PREFIX, prefix, "");
+}
+
+/**Creates a query matching every keyword in an alphabetical range.
+@param first The first keyword of the range.
+@param last The last keyword of the range.
+@return The query.
+@pre none
+@post The query will match every keyword from first to last, both included. If last comes before first, nothing matches. */
+KeyQuery KeyQuery::range(const string& first, const string& last)
+{
+   return KeyQuery(RANGE, first, last);
+}
+
+/**Returns the smallest keyword the query can match.
+@return The keyword every match is equal to or after.
+@pre none
+@post The keyword will be returned as a string. */
+const string& KeyQuery::getFirst() const
+{
+   return first;
+}
+
+/**Tests whether the query can match only one keyword.
+@return True if the query matches getFirst() and nothing else, false otherwise.
+@pre none
+@post Returns true for an exact query or a range whose first and last keywords are the same. */
+bool KeyQuery::isSingleKey() const
+{
+   return kind == EXACT || (kind == RANGE && first == last);
+}
+
+/**Tests whether a keyword comes before every match.
+@param keyWord The keyword to test.
+@return True if keyWord is alphabetically before getFirst(), false otherwise.
+@pre none
+@post Returns true if keyWord is before the matches, false otherwise. */
+bool KeyQuery::isBefore(string_view keyWord) const
+{
+   return keyWord < string_view(first);
+}
+
+/**Tests whether a keyword comes after every match.
+@param keyWord The keyword to test.
+@return True if keyWord and every keyword after it do not match, false otherwise.
+@pre none
+@post Returns true if keyWord is after the matches, false otherwise. */
+bool KeyQuery::isAfter(string_view keyWord) const
+{
+   switch ( kind )
+   {
+      case EXACT:
+         return keyWord > string_view(first);
+      case PREFIX:
+         //the keywords starting with the prefix follow it directly, the first one after it that does not start with it ends them
+         return !isBefore(keyWord) && keyWord.compare(0, first.length(), first) != 0;
+      default:
+         return keyWord > string_view(last);
+   }
+}
+
+/**Tests whether the query matches a keyword.
+@param keyWord The keyword to test.
+@return True if keyWord is neither before nor after the matches, false otherwise.
+@pre none
+@post Returns true if the query matches keyWord, false otherwise. */
+bool KeyQuery::matches(string_view keyWord) const
+{
+   return !isBefore(keyWord) && !isAfter(keyWord);
+}
@@ -0,0 +1,91 @@
+/*
+file name: KeyQuery.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the KeyQuery class. A KeyQuery selects the keywords of a concordance to print: one exact keyword, every keyword starting with a prefix, or every keyword in an alphabetical range. The keywords a query matches are always next to each other in alphabetical order, so an engine can find the first one with a search and stop at the first keyword after the matches.
+*/
+
+#ifndef KEYQUERY_H
+#define KEYQUERY_H
+
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+class KeyQuery
+{
+public:
+   
+   /**Creates a query matching one keyword.
+   @param keyWord The keyword, stripped of punctuation and lowercase.
+   @return The query.
+   @pre none
+   @post The query will match only keyWord. */
+   KeyQuery static exact(const string& keyWord);
+   
+   /**Creates a query matching every keyword that starts with a prefix.
+   @param prefix The first characters of the keywords, in lowercase.
+   @return The query.
+   @pre none
+   @post The query will match every keyword starting with prefix, including prefix itself. */
+   KeyQuery static prefix(const string& prefix);
+   
+   /**Creates a query matching every keyword in an alphabetical range.
+   @param first The first keyword of the range.
+   @param last The last keyword of the range.
+   @return The query.
+   @pre none
+   @post The query will match every keyword from first to last, both included. If last comes before first, nothing matches. */
+   KeyQuery static range(const string& first, const string& last);
+   
+   /**Returns the smallest keyword the query can match.
+   @return The keyword every match is equal to or after.
+   @pre none
+   @post The keyword will be returned as a string. */
+   const string& getFirst() const;
+   
+   /**Tests whether the query can match only one keyword.
+   @return True if the query matches getFirst() and nothing else, false otherwise.
+   @pre none
+   @post Returns true for an exact query or a range whose first and last keywords are the same. */
+   bool isSingleKey() const;
+   
+   /**Tests whether a keyword comes before every match.
+   @param keyWord The keyword to test.
+   @return True if keyWord is alphabetically before getFirst(), false otherwise.
+   @pre none
+   @post Returns true if keyWord is before the matches, false otherwise. */
+   bool isBefore(string_view keyWord) const;
+   
+   /**Tests whether a keyword comes after every match.
+   @param keyWord The keyword to test.
+   @return True if keyWord and every keyword after it do not match, false otherwise.
+   @pre none
+   @post Returns true if keyWord is after the matches, false otherwise. */
+   bool isAfter(string_view keyWord) const;
+   
+   /**Tests whether the query matches a keyword.
+   @param keyWord The keyword to test.
+   @return True if keyWord is neither before nor after the matches, false otherwise.
+   @pre none
+   @post Returns true if the query matches keyWord, false otherwise. */
+   bool matches(string_view keyWord) const;
+   
+private:
+   
+   //the kinds of query
+   enum Kind { EXACT, PREFIX, RANGE };
+   
+   /**Constructor for the KeyQuery class that accepts the kind of query and its bounds.
+   @param kind The kind of query.
+   @param first The keyword, the prefix, or the first keyword of the range.
+   @param last The last keyword of a range, unused otherwise. */
+   KeyQuery(Kind kind, const string& first, const string& last);
+   
+   Kind kind; //the kind of query
+   string first; //the keyword, the prefix, or the first keyword of the range
+   string last; //the last keyword of a range
+};
+
+#endif
@@ -0,0 +1,14 @@
+/*
+file name: KeyWalk.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the KeyWalk class. A KeyWalk visits the keywords of a concordance engine and their context lists one at a time in alphabetical order, walking the engine's own ordered structure instead of collecting the lists first. Each engine derives a walk of its own, and a RowCursor reads the rows of the lists a walk visits.
+*/
+
+#include "KeyWalk.h"
+
+/** The destructor for the KeyWalk class.
+Destroys the KeyWalk object when its lifetime ends. The engine is not changed. */
+KeyWalk::~KeyWalk()
+{
+}
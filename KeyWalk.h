@@ -0,0 +1,54 @@
+/*
+file name: KeyWalk.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the KeyWalk class. A KeyWalk visits the keywords of a concordance engine and their context lists one at a time in alphabetical order, walking the engine's own ordered structure instead of collecting the lists first. Each engine derives a walk of its own, and a RowCursor reads the rows of the lists a walk visits. A walk only ever holds its place in the engine, so it can be copied in time proportional to that place and not to the number of keywords.
+*/
+
+#ifndef KEYWALK_H
+#define KEYWALK_H
+
+#include <string_view>
+#include "ContextList.h"
+
+using namespace std;
+
+class KeyWalk
+{
+public:
+
+   /** The destructor for the KeyWalk class.
+   Destroys the KeyWalk object when its lifetime ends. The engine is not changed. */
+   virtual ~KeyWalk();
+
+   /**Makes a copy of the walk at the same keyword.
+   @return A new walk the caller must delete.
+   @pre none
+   @post The copy will visit the same keywords as this walk from the current one on. */
+   virtual KeyWalk* clone() const = 0;
+
+   /**Tests whether the walk is past the last keyword.
+   @return True if there are no keywords left, false otherwise.
+   @pre none
+   @post The walk is unchanged. */
+   virtual bool atEnd() const = 0;
+
+   /**Moves to the next keyword.
+   @pre The walk must not be past the last keyword.
+   @post The walk will be at the next keyword in alphabetical order, or past the last keyword. */
+   virtual void next() = 0;
+
+   /**Returns the current keyword.
+   @return The keyword.
+   @pre The walk must not be past the last keyword.
+   @post The keyword will be returned as a view, valid until the walk is moved or destroyed. */
+   virtual string_view getKey() const = 0;
+
+   /**Returns the context list of the current keyword.
+   @return The context list.
+   @pre The walk must not be past the last keyword.
+   @post The context list will be returned as a const reference, valid as long as the engine is not changed. */
+   virtual const ContextList& getContextList() const = 0;
+};
+
+#endif
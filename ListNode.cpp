@@ -2,104 +2,66 @@
 file name: Node.h
 author: Hall, Ashley
 date: 2019-Nov-23
-description: The implementation file for the ListNode class. Each ListNode contains the context, the 5 words before, the word itself, and the 5 words after the keyword, for a word in the corpus.
+description: The implementation file for the ListNode class. Each ListNode contains the context, the BEFORE words before, the word itself, and the AFTER words after the keyword, for a word in the corpus, and the number of the document the word was read from. A ContextList only stores the position of each of its keywords in the concordance's WordStream, and a ListNode is the context of one of them read back from the stream, to be printed or written to a spill file. The class is a template over the window, so each window has a context array of its own size and loops over it that the compiler unrolls. The words are stored as IDs from the concordance's Vocabulary and are only turned back into text when the context is printed.
 */
 
 #include "ListNode.h"
 
-/** Constructor for the ListNode class that accepts a context array as its argument. Initializes the context to the context array given and its next pointer to nullptr.
+#include <cstring>
+
+/** Constructor for the ListNode class that accepts a context array and a document number as its arguments. Initializes the context to the context array given and the document to the number given.
  @param theContext the context array
+ @param theDocument the number of the document the context was read from, 0 for a single corpus
  @pre theContext must be of type ListNode::contextArr
  */
-ListNode::ListNode(const contextArr& theContext) : context(theContext), next(nullptr)
+template <int BEFORE, int AFTER>
+ListNode<BEFORE, AFTER>::ListNode(const contextArr& theContext, uint32_t theDocument) : context(theContext), document(theDocument)
 {
 }
 
-/** Constructor for the ListNode class that accepts a context array and a next node pointer as arguments. Initializes the context to the context array given and its next pointer to the pointer given.
-@param theContext the context array
-@param nextNode the pointer to the next node
-@pre theContext and nextNode must be of type ListNode::contextArr and ListNode, respectively.
+/** Constructor for the ListNode class that accepts a word stream and the position of a keyword in it as arguments. Initializes the context to the words around the keyword and the document to the keyword's document.
+@param words The word stream the keyword was read into.
+@param position The position of the keyword in the stream.
+@pre The stream must hold the BEFORE words before the position and the AFTER words after it.
 */
-ListNode::ListNode(const contextArr& theContext, ListNode* nextNode) :
-   context(theContext), next(nextNode)
-{
-}
-
-/**Sets the data member next to the ListNode pointer given.
-@param nextNode The pointer that points to the next node.
-@pre: The argument must a pointer to a ListNode.
-@post next will store the memory address of the ListNode pointed to by nextNode.
- */
-void ListNode::setNext(ListNode* nextNode)
+template <int BEFORE, int AFTER>
+ListNode<BEFORE, AFTER>::ListNode(const WordStream& words, uint64_t position) : document(words.getDocument(position))
 {
-   next = nextNode;
+   //the context is the run of words centered on the keyword
+   memcpy(context.data(), words.getWords(position - BEFORE), sizeof(contextArr));
 }
 
 /**Returns the context of a ListNode
  @pre: none
  @post The context will be returned as a reference to a contextArr object. */
-const ListNode::contextArr& ListNode::getContext() const
+template <int BEFORE, int AFTER>
+const typename ListNode<BEFORE, AFTER>::contextArr& ListNode<BEFORE, AFTER>::getContext() const
 {
    return context;
 }
 
-/**Returns the next ListNode.
-@pre: none
-@post: The pointer to the next node will be returned.
-@return The pointer to the next node. */
-ListNode* ListNode::getNext() const
-{
-   return next;
-}
-
-/**Returns the context words before the keyword as a string of words separated by a space.
- @return Returns the context words before the keyword as a string.
- @pre none
- @post If there are no context words before the keyword an empty string will be returned. Otherwise, a string containing each context word before the keyword separated by a space will be returned.
- */
-string ListNode::getPreKeyContext() const
-{
-   string preKey = "";
-   //traverse the context array, stop before keyword (index = 5)
-   for (int i = 0; i < 5; i++)
-   {
-      //don't add space if at end of array
-      if ( i == 4 )
-         preKey = preKey + context.at(i);
-      //add context word with space in between
-      else
-         preKey = preKey + context.at(i) + " ";
-   }
-   return preKey;
-}
-
-/**Returns the context words after the keyword as a string of words separated by a space.
-@return Returns the context words after the keyword as a string.
-@pre none
-@post If there are no context words after the keyword an empty string will be returned. Otherwise, a string containing each context word after the keyword separated by a space will be returned.
-*/
-string ListNode::getPostKeyContext() const
+/**Returns the number of the document the context was read from.
+ @pre: none
+ @post The document number will be returned, 0 if the context was read from a single corpus. */
+template <int BEFORE, int AFTER>
+uint32_t ListNode<BEFORE, AFTER>::getDocument() const
 {
-   string postKey = "";
-   //traverse the context array after the keyword (index = 5)
-   for (int i = 6; i < 11; i++)
-   {
-      if ( i == 10 )
-         //don't add space if at end of array
-         postKey = postKey + context.at(i);
-      else
-         //add context word with space in between
-         postKey = postKey + context.at(i) + " ";
-   }
-   return postKey;
+   return document;
 }
 
 /**Returns the keyword as a string.
+ @param vocab The Vocabulary the context word IDs were interned in.
  @return Returns the keyword as a string.
- @pre none
+ @pre vocab must be the Vocabulary used to build the context.
  @post The keyword will be returned as a string.
  */
-string ListNode::getKey() const
+template <int BEFORE, int AFTER>
+const string& ListNode<BEFORE, AFTER>::getKey(const Vocabulary& vocab) const
 {
-   return context.at(5);
+   return vocab.getWord(context[KEY_INDEX]);
 }
+
+//compile the ListNode of every window
+#define INSTANTIATE(BEFORE, AFTER) template class ListNode<BEFORE, AFTER>;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
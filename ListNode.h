@@ -2,7 +2,7 @@
 file name: Node.h
 author: Hall, Ashley
 date: 2019-Nov-23
-description: The header file for the ListNode class. Each ListNode contains the context, the 5 words before, the word itself, and the 5 words after the keyword, for a word in the corpus. 
+description: The header file for the ListNode class. Each ListNode contains the context, the BEFORE words before, the word itself, and the AFTER words after the keyword, for a word in the corpus, and the number of the document the word was read from. A ContextList only stores the position of each of its keywords in the concordance's WordStream, and a ListNode is the context of one of them read back from the stream, to be printed or written to a spill file. The class is a template over the window, so each window has a context array of its own size and loops over it that the compiler unrolls. The words are stored as IDs from the concordance's Vocabulary and are only turned back into text when the context is printed.
 */
 
 #ifndef LISTNODE_H
@@ -10,75 +10,63 @@ description: The header file for the ListNode class. Each ListNode contains the
 
 #include <string>
 #include <array>
+#include <vector>
+#include <cstdint>
+#include "Vocabulary.h"
+#include "WordStream.h"
+#include "WindowSizes.h"
 
 using namespace std;
 
+template <int BEFORE, int AFTER>
 class ListNode
 {
-   
+   static_assert(BEFORE >= 1 && AFTER >= 1, "a window needs a word on each side of the keyword");
    
 public:
-   static const int NUM_WORDS = 11; //10 context words + 1 keyword
+   static const int WORDS_BEFORE = BEFORE; //context words before the keyword
+   static const int WORDS_AFTER = AFTER; //context words after the keyword
+   static const int KEY_INDEX = BEFORE; //index of the keyword in the context array
+   static const int NUM_WORDS = BEFORE + 1 + AFTER; //context words + 1 keyword
    
-   typedef array<string, NUM_WORDS> contextArr; //create alias type
+   typedef array<Vocabulary::wordId, NUM_WORDS> contextArr; //create alias type, IDs of the context words
    
-   /** Constructor for the ListNode class that accepts a context array as its argument. Initializes the context to the context array given and its next pointer to nullptr.
+   /** Constructor for the ListNode class that accepts a context array and a document number as its arguments. Initializes the context to the context array given and the document to the number given.
    @param theContext the context array
+   @param theDocument the number of the document the context was read from, 0 for a single corpus
    @pre theContext must be of type ListNode::contextArr
    */
-   ListNode(const contextArr& theContext);
+   ListNode(const contextArr& theContext, uint32_t theDocument = 0);
    
-   /** Constructor for the ListNode class that accepts a context array and a next node pointer as arguments. Initializes the context to the context array given and its next pointer to the pointer given.
-   @param theContext the context array
-   @param nextNode the pointer to the next node
-   @pre theContext and nextNode must be of type ListNode::contextArr and ListNode, respectively.
+   /** Constructor for the ListNode class that accepts a word stream and the position of a keyword in it as arguments. Initializes the context to the words around the keyword and the document to the keyword's document.
+   @param words The word stream the keyword was read into.
+   @param position The position of the keyword in the stream.
+   @pre The stream must hold the BEFORE words before the position and the AFTER words after it.
    */
-   ListNode(const contextArr& theContext, ListNode* nextNode);
-   
-   /**Sets the data member next to the ListNode pointer given.
-   @param nextNode The pointer that points to the next node.
-   @pre: The argument must a pointer to a ListNode.
-   @post next will store the memory address of the ListNode pointed to by nextNode.
-    */
-   void setNext(ListNode* nextNode);
+   ListNode(const WordStream& words, uint64_t position);
    
-   /**Returns the next ListNode.
-   @pre: none
-   @post: The pointer to the next node will be returned.
-   @return The pointer to the next node. */
-   ListNode* getNext() const;
- 
    /**Returns the context of a ListNode
    @pre: none
    @post The context will be returned as a reference to a contextArr object. */
    const contextArr& getContext() const;
    
-   /**Returns the context words before the keyword as a string of words separated by a space.
-   @return Returns the context words before the keyword as a string.
-   @pre none
-   @post If there are no context words before the keyword an empty string will be returned. Otherwise, a string containing each context word before the keyword separated by a space will be returned.
-   */
-   string getPreKeyContext() const;
-   
-   /**Returns the context words after the keyword as a string of words separated by a space.
-   @return Returns the context words after the keyword as a string.
-   @pre none
-   @post If there are no context words after the keyword an empty string will be returned. Otherwise, a string containing each context word after the keyword separated by a space will be returned.
-   */
-   string getPostKeyContext() const;
+   /**Returns the number of the document the context was read from.
+   @pre: none
+   @post The document number will be returned, 0 if the context was read from a single corpus. */
+   uint32_t getDocument() const;
    
    /**Returns the keyword as a string.
+   @param vocab The Vocabulary the context word IDs were interned in.
    @return Returns the keyword as a string.
-   @pre none
+   @pre vocab must be the Vocabulary used to build the context.
    @post The keyword will be returned as a string.
    */
-   string getKey() const;
+   const string& getKey(const Vocabulary& vocab) const;
    
 private:
    contextArr context; //the context for a word in the corpus
    
-   ListNode* next; //pointer to next ListNode
-
+   uint32_t document; //number of the document the context was read from, 0 for a single corpus
 };
 
 #endif
@@ -0,0 +1,107 @@
+/*
+file name: NodeArena.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the NodeArena class. A NodeArena is a bump allocator the concordance takes its TreeNodes and the blocks of its context lists from. Nodes are carved one after another out of large blocks, so a node costs a pointer increment instead of a call to new, and the blocks of a context list sit near each other in memory. Nodes are never freed one at a time: the blocks are all released at once when the arena is destroyed.
+*/
+
+#include "NodeArena.h"
+
+#include <cstdint>
+
+/** The default constructor for the NodeArena class.
+Constructs an arena with no blocks. */
+NodeArena::NodeArena() : cursor(nullptr), limit(nullptr), nextBlockBytes(FIRST_BLOCK_BYTES), blockBytes(0)
+{
+}
+
+/** The destructor for the NodeArena class.
+Releases every block when its lifetime ends. Destructors of the objects in the arena are not run. */
+NodeArena::~NodeArena()
+{
+   release();
+}
+
+/**Reserves memory in the arena.
+@param bytes The number of bytes needed.
+@param alignment The alignment needed, a power of 2 no larger than alignof(max_align_t).
+@return A pointer to the memory reserved.
+@pre none
+@post The memory will stay valid until the arena is released or destroyed. A new block is allocated if the current block is full. */
+void* NodeArena::allocate(size_t bytes, size_t alignment)
+{
+   //round the cursor up to the alignment
+   uintptr_t aligned = ((uintptr_t)cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+   
+   //the current block is full, blocks start at max_align_t alignment
+   if ( cursor == nullptr || aligned + bytes > (uintptr_t)limit )
+   {
+      addBlock(bytes);
+      aligned = (uintptr_t)cursor;
+   }
+   
+   cursor = (char*)(aligned + bytes);
+   return (void*)aligned;
+}
+
+/**Takes over every block of another arena.
+@param other The arena whose blocks are taken.
+@pre other must not be this arena.
+@post Objects created in other will stay valid until this arena is released or destroyed. other will be empty. */
+void NodeArena::adopt(NodeArena& other)
+{
+   //the adopted blocks are not reused, this arena keeps allocating from its own current block
+   blocks.insert(blocks.end(), other.blocks.begin(), other.blocks.end());
+   blockBytes += other.blockBytes;
+   
+   other.blocks.clear();
+   other.cursor = nullptr;
+   other.limit = nullptr;
+   other.nextBlockBytes = FIRST_BLOCK_BYTES;
+   other.blockBytes = 0;
+}
+
+/**Releases every block in the arena.
+@pre None of the objects in the arena are used again.
+@post The arena will be empty. */
+void NodeArena::release()
+{
+   for (size_t b = 0; b < blocks.size(); b++)
+      delete[] blocks[b];
+   blocks.clear();
+   cursor = nullptr;
+   limit = nullptr;
+   nextBlockBytes = FIRST_BLOCK_BYTES;
+   blockBytes = 0;
+}
+
+/**Returns the number of bytes allocated for the arena's blocks.
+@return The total size of the blocks.
+@pre none
+@post The size will be returned as a size_t. */
+size_t NodeArena::getBlockBytes() const
+{
+   return blockBytes;
+}
+
+/**Allocates a new block large enough for a request.
+@param bytes The size of the request the block must fit.
+@pre none
+@post The new block will be the current block. */
+void NodeArena::addBlock(size_t bytes)
+{
+   size_t size = nextBlockBytes;
+   while ( size < bytes )
+      size *= 2;
+   
+   //new[] returns memory aligned for any fundamental type
+   char* block = new char[size];
+   blocks.push_back(block);
+   cursor = block;
+   limit = block + size;
+   blockBytes += size;
+   
+   //grow the blocks geometrically so large corpora need few of them
+   if ( nextBlockBytes < MAX_BLOCK_BYTES )
+      nextBlockBytes *= 2;
+}
@@ -0,0 +1,87 @@
+/*
+file name: NodeArena.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the NodeArena class. A NodeArena is a bump allocator the concordance takes its TreeNodes and the blocks of its context lists from. Nodes are carved one after another out of large blocks, so a node costs a pointer increment instead of a call to new, and the blocks of a context list sit near each other in memory. Nodes are never freed one at a time: the blocks are all released at once when the arena is destroyed.
+*/
+
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+using namespace std;
+
+class NodeArena
+{
+public:
+   
+   static constexpr size_t FIRST_BLOCK_BYTES = 1 << 16; //size of the first block
+   static constexpr size_t MAX_BLOCK_BYTES = 1 << 22; //blocks double in size up to this
+   
+   /** The default constructor for the NodeArena class.
+   Constructs an arena with no blocks. */
+   NodeArena();
+   
+   /** The destructor for the NodeArena class.
+   Releases every block when its lifetime ends. Destructors of the objects in the arena are not run. */
+   virtual ~NodeArena();
+   
+   /**Reserves memory in the arena.
+   @param bytes The number of bytes needed.
+   @param alignment The alignment needed, a power of 2 no larger than alignof(max_align_t).
+   @return A pointer to the memory reserved.
+   @pre none
+   @post The memory will stay valid until the arena is released or destroyed. A new block is allocated if the current block is full. */
+   void* allocate(size_t bytes, size_t alignment);
+   
+   /**Constructs an object in the arena.
+   @param args The arguments passed on to the object's constructor.
+   @return A pointer to the new object.
+   @pre none
+   @post The object will stay valid until the arena is released or destroyed. Its destructor is never run by the arena, so it must either be trivially destructible or be destroyed by hand. */
+   template <class T, class... Args>
+   T* create(Args&&... args)
+   {
+      return new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+   }
+   
+   /**Takes over every block of another arena.
+   @param other The arena whose blocks are taken.
+   @pre other must not be this arena.
+   @post Objects created in other will stay valid until this arena is released or destroyed. other will be empty. */
+   void adopt(NodeArena& other);
+   
+   /**Releases every block in the arena.
+   @pre None of the objects in the arena are used again.
+   @post The arena will be empty. */
+   void release();
+   
+   /**Returns the number of bytes allocated for the arena's blocks.
+   @return The total size of the blocks.
+   @pre none
+   @post The size will be returned as a size_t. */
+   size_t getBlockBytes() const;
+   
+private:
+   //an arena owns its blocks, so it cannot be copied
+   NodeArena(const NodeArena&);
+   NodeArena& operator=(const NodeArena&);
+   
+   /**Allocates a new block large enough for a request.
+   @param bytes The size of the request the block must fit.
+   @pre none
+   @post The new block will be the current block. */
+   void addBlock(size_t bytes);
+   
+   vector<char*> blocks; //every block allocated, including adopted ones
+   char* cursor; //next free byte in the current block
+   char* limit; //one past the last byte of the current block
+   size_t nextBlockBytes; //size of the next block to allocate
+   size_t blockBytes; //total size of the blocks
+};
+
+#endif
@@ -0,0 +1,373 @@
+/*
+file name: Normalizer.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the Normalizer class. The Normalizer strips punctuation from a word and folds it to lowercase in a single pass. Words are read as UTF-8. Each ASCII byte is classified with lookup tables built at compile time, which match ispunct and tolower in the C locale, and every kernel stays on this fast path until it meets a byte of 0x80 or above. From there the rest of the word is decoded one code point at a time by the UTF-8 kernel, which drops the Unicode punctuation and applies the simple case folding, both from the Unicode class. Bytes that are not valid UTF-8 are kept as they are. On x86 processors words of 16 bytes or more are processed a block at a time with SSE2, or AVX2 when the processor supports it, and the blocks that contain no punctuation are stored without looking at each byte. Other processors use the scalar table-driven kernel.
+*/
+
+#include "Normalizer.h"
+
+#include <cstdint>
+#include <cstring>
+#include "Unicode.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NORMALIZER_X86 1
+#include <immintrin.h>
+#endif
+
+//lookup tables for the scalar kernel, indexed by the unsigned value of a byte
+struct ByteTables
+{
+   unsigned char lower[256]; //the byte folded to lowercase
+   unsigned char keep[256]; //1 if the byte is kept, 0 if it is punctuation
+};
+
+/**Builds the byte tables at compile time from the C locale's definitions of punctuation and uppercase.
+@return The filled in tables. */
+static constexpr ByteTables makeByteTables()
+{
+   ByteTables tables = {};
+   for (int c = 0; c < 256; c++)
+   {
+      bool punct = (c >= 0x21 && c <= 0x2F) || (c >= 0x3A && c <= 0x40) ||
+                   (c >= 0x5B && c <= 0x60) || (c >= 0x7B && c <= 0x7E);
+      bool upper = c >= 'A' && c <= 'Z';
+      tables.lower[c] = (unsigned char)(upper ? c + ('a' - 'A') : c);
+      tables.keep[c] = punct ? 0 : 1;
+   }
+   return tables;
+}
+
+static constexpr ByteTables BYTE_TABLES = makeByteTables();
+
+//words shorter than one SSE2 block always take the scalar kernel
+static const size_t BLOCK_SIZE = 16;
+
+//kernel used for words of at least BLOCK_SIZE bytes, chosen once when the program starts
+static const Normalizer::kernel longWordKernel = Normalizer::bestKernel();
+
+//the high bit of every byte of a 64-bit word, set in a byte of 0x80 or above
+static const uint64_t HIGH_BITS = 0x8080808080808080ULL;
+
+/**Finds the length of the run of ASCII bytes at the start of a word, checking 8 bytes at a time.
+@param src The first character of the word.
+@param len The length of the word.
+@return The index of the first byte of 0x80 or above, or len if there is none. */
+static size_t asciiPrefix(const char* src, size_t len)
+{
+   size_t i = 0;
+   for ( ; i + 8 <= len; i += 8)
+   {
+      uint64_t bytes;
+      memcpy(&bytes, src + i, 8);
+      if ( (bytes & HIGH_BITS) != 0 )
+         break;
+   }
+   while ( i < len && (unsigned char)src[i] < 0x80 )
+      i++;
+   return i;
+}
+
+/**Copies a word with its punctuation stripped and in lowercase, using the fastest kernel the processor supports.
+@param word The word to be reformatted.
+@param cleaned The string to store the reformatted word in.
+@pre word must not view cleaned.
+@post cleaned will contain the word stripped of punctuation and in lowercase. */
+void Normalizer::normalize(string_view word, string& cleaned)
+{
+   //the cleaned word is never longer than the word
+   cleaned.resize(word.length());
+   size_t length;
+   if ( word.length() < BLOCK_SIZE )
+      length = normalizeScalar(word.data(), word.length(), &cleaned[0]);
+   else
+      length = longWordKernel(word.data(), word.length(), &cleaned[0]);
+   cleaned.resize(length);
+}
+
+/**Strips a word of punctuation and makes it lowercase in place, using the fastest kernel the processor supports.
+@param word The word to be reformatted.
+@pre none
+@post The word will be stripped of punctuation and be lowercase. */
+void Normalizer::normalize(string& word)
+{
+   //every kernel only writes to bytes it has already read, so it can work in place
+   size_t length;
+   if ( word.length() < BLOCK_SIZE )
+      length = normalizeScalar(word.data(), word.length(), &word[0]);
+   else
+      length = longWordKernel(word.data(), word.length(), &word[0]);
+   word.resize(length);
+}
+
+/**Checks if a character is a punctuation symbol in the C locale.
+@param c The character to be checked.
+@return True if the character is punctuation, false otherwise.
+@pre none
+@post True will be returned if ispunct would return true for the character in the C locale. */
+bool Normalizer::isPunct(char c)
+{
+   return BYTE_TABLES.keep[(unsigned char)c] == 0;
+}
+
+/**Checks if a word is a single punctuation symbol, one ASCII character or one UTF-8 sequence.
+@param word The word to be checked.
+@return True if the word is one punctuation character, false otherwise.
+@pre none
+@post True will be returned if the word is an ASCII character that ispunct would accept in the C locale, or the UTF-8 sequence of a single code point in one of the Unicode punctuation categories. */
+bool Normalizer::isPunctSymbol(string_view word)
+{
+   if ( word.length() == 1 )
+      return isPunct(word[0]);
+   
+   //only a word that starts with a lead byte and is no longer than one sequence needs decoding
+   if ( word.length() < 2 || word.length() > Unicode::MAX_SEQUENCE_BYTES || (unsigned char)word[0] < 0xC0 )
+      return false;
+   uint32_t codePoint;
+   return Unicode::decode(word.data(), word.length(), codePoint) == word.length() && Unicode::isPunct(codePoint);
+}
+
+/**The scalar kernel, one table lookup per ASCII byte and no branches on the byte's class. Hands the rest of the word to the UTF-8 kernel at the first byte of 0x80 or above.
+@param src The first character of the word.
+@param len The length of the word.
+@param dst Where the cleaned word is written, it may be equal to src.
+@return The length of the cleaned word. */
+size_t Normalizer::normalizeScalar(const char* src, size_t len, char* dst)
+{
+   //the bytes before the first one of 0x80 or above take the fast path, in English text that is the whole word
+   size_t ascii = asciiPrefix(src, len);
+   size_t out = 0;
+   for (size_t i = 0; i < ascii; i++)
+   {
+      //always write the lowercase byte, only advance past it if it is kept
+      unsigned char c = (unsigned char)src[i];
+      dst[out] = (char)BYTE_TABLES.lower[c];
+      out += BYTE_TABLES.keep[c];
+   }
+   if ( ascii == len )
+      return out;
+   return out + normalizeUTF8(src + ascii, len - ascii, dst + out);
+}
+
+/**The UTF-8 kernel, decodes one code point at a time. Drops the code points that are punctuation and folds the rest to lowercase, copying bytes that are not valid UTF-8 as they are.
+@param src The first character of the word.
+@param len The length of the word.
+@param dst Where the cleaned word is written, it may be equal to src.
+@return The length of the cleaned word. */
+size_t Normalizer::normalizeUTF8(const char* src, size_t len, char* dst)
+{
+   size_t out = 0;
+   size_t i = 0;
+   while ( i < len )
+   {
+      unsigned char c = (unsigned char)src[i];
+      if ( c < 0x80 )
+      {
+         dst[out] = (char)BYTE_TABLES.lower[c];
+         out += BYTE_TABLES.keep[c];
+         i++;
+         continue;
+      }
+      
+      uint32_t codePoint;
+      size_t length = Unicode::decode(src + i, len - i, codePoint);
+      if ( length == 0 )
+      {
+         //not UTF-8, keep the byte the way the word had it
+         dst[out++] = (char)c;
+         i++;
+      }
+      else
+      {
+         //the folded sequence is never longer than the one read, so out stays at or behind i
+         if ( !Unicode::isPunct(codePoint) )
+            out += Unicode::encode(Unicode::fold(codePoint), dst + out);
+         i += length;
+      }
+   }
+   return out;
+}
+
+#ifdef NORMALIZER_X86
+
+//shuffle controls that move the kept bytes of an 8-byte group to the front, indexed by the group's keep mask
+struct CompactTable
+{
+   unsigned long long shuffle[256]; //byte j holds the index of the j-th kept byte
+   unsigned char count[256]; //number of kept bytes
+};
+
+/**Builds the compaction shuffle table at compile time.
+@return The filled in table. */
+static constexpr CompactTable makeCompactTable()
+{
+   CompactTable table = {};
+   for (int mask = 0; mask < 256; mask++)
+   {
+      int kept = 0;
+      for (int k = 0; k < 8; k++)
+      {
+         if ( (mask >> k) & 1 )
+         {
+            table.shuffle[mask] |= (unsigned long long)k << (8 * kept);
+            kept++;
+         }
+      }
+      table.count[mask] = (unsigned char)kept;
+   }
+   return table;
+}
+
+static constexpr CompactTable COMPACT_TABLE = makeCompactTable();
+
+/**The SSE2 kernel, processes 16 bytes of ASCII at a time until a block holds punctuation, and the rest of the word with the scalar kernel. Falls back to the scalar kernel where SSE2 is not available.
+@param src The first character of the word.
+@param len The length of the word.
+@param dst Where the cleaned word is written, it may be equal to src.
+@return The length of the cleaned word. */
+__attribute__((target("sse2")))
+size_t Normalizer::normalizeSSE2(const char* src, size_t len, char* dst)
+{
+   //bounds of the punctuation ranges and of the uppercase letters, exclusive on both sides
+   const __m128i punctLo1 = _mm_set1_epi8(0x20), punctHi1 = _mm_set1_epi8(0x30);
+   const __m128i punctLo2 = _mm_set1_epi8(0x39), punctHi2 = _mm_set1_epi8(0x41);
+   const __m128i punctLo3 = _mm_set1_epi8(0x5A), punctHi3 = _mm_set1_epi8(0x61);
+   const __m128i punctLo4 = _mm_set1_epi8(0x7A), punctHi4 = _mm_set1_epi8(0x7F);
+   const __m128i upperLo = _mm_set1_epi8(0x40), upperHi = _mm_set1_epi8(0x5B);
+   const __m128i caseBit = _mm_set1_epi8(0x20);
+   
+   size_t out = 0;
+   size_t i = 0;
+   for ( ; i + 16 <= len; i += 16)
+   {
+      __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+      
+      //a byte of 0x80 or above has its sign bit set, the rest of the word is decoded as UTF-8
+      if ( _mm_movemask_epi8(v) != 0 )
+         return out + normalizeUTF8(src + i, len - i, dst + out);
+      
+      //classify all 16 bytes at once
+      __m128i punct = _mm_or_si128(
+         _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi8(v, punctLo1), _mm_cmplt_epi8(v, punctHi1)),
+                      _mm_and_si128(_mm_cmpgt_epi8(v, punctLo2), _mm_cmplt_epi8(v, punctHi2))),
+         _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi8(v, punctLo3), _mm_cmplt_epi8(v, punctHi3)),
+                      _mm_and_si128(_mm_cmpgt_epi8(v, punctLo4), _mm_cmplt_epi8(v, punctHi4))));
+      
+      //SSE2 has no byte shuffle to drop punctuation with, so from the first block that has any the rest of the word is left to the scalar kernel
+      if ( _mm_movemask_epi8(punct) != 0 )
+         return out + normalizeScalar(src + i, len - i, dst + out);
+      
+      //no punctuation, lowercase and store the whole block
+      __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, upperLo), _mm_cmplt_epi8(v, upperHi));
+      _mm_storeu_si128((__m128i*)(dst + out), _mm_or_si128(v, _mm_and_si128(upper, caseBit)));
+      out += 16;
+   }
+   
+   //finish the bytes that do not fill a block
+   return out + normalizeScalar(src + i, len - i, dst + out);
+}
+
+/**The AVX2 kernel, processes 32 bytes of ASCII at a time.
+@param src The first character of the word.
+@param len The length of the word.
+@param dst Where the cleaned word is written, it may be equal to src.
+@return The length of the cleaned word.
+@pre hasAVX2() must be true. */
+__attribute__((target("avx2")))
+size_t Normalizer::normalizeAVX2(const char* src, size_t len, char* dst)
+{
+   //bounds of the punctuation ranges and of the uppercase letters, exclusive on both sides
+   const __m256i punctLo1 = _mm256_set1_epi8(0x20), punctHi1 = _mm256_set1_epi8(0x30);
+   const __m256i punctLo2 = _mm256_set1_epi8(0x39), punctHi2 = _mm256_set1_epi8(0x41);
+   const __m256i punctLo3 = _mm256_set1_epi8(0x5A), punctHi3 = _mm256_set1_epi8(0x61);
+   const __m256i punctLo4 = _mm256_set1_epi8(0x7A), punctHi4 = _mm256_set1_epi8(0x7F);
+   const __m256i upperLo = _mm256_set1_epi8(0x40), upperHi = _mm256_set1_epi8(0x5B);
+   const __m256i caseBit = _mm256_set1_epi8(0x20);
+   
+   size_t out = 0;
+   size_t i = 0;
+   for ( ; i + 32 <= len; i += 32)
+   {
+      __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+      
+      //a byte of 0x80 or above has its sign bit set, the rest of the word is decoded as UTF-8
+      if ( _mm256_movemask_epi8(v) != 0 )
+         return out + normalizeUTF8(src + i, len - i, dst + out);
+      
+      //classify all 32 bytes at once
+      __m256i punct = _mm256_or_si256(
+         _mm256_or_si256(_mm256_and_si256(_mm256_cmpgt_epi8(v, punctLo1), _mm256_cmpgt_epi8(punctHi1, v)),
+                         _mm256_and_si256(_mm256_cmpgt_epi8(v, punctLo2), _mm256_cmpgt_epi8(punctHi2, v))),
+         _mm256_or_si256(_mm256_and_si256(_mm256_cmpgt_epi8(v, punctLo3), _mm256_cmpgt_epi8(punctHi3, v)),
+                         _mm256_and_si256(_mm256_cmpgt_epi8(v, punctLo4), _mm256_cmpgt_epi8(punctHi4, v))));
+      __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, upperLo), _mm256_cmpgt_epi8(upperHi, v));
+      __m256i lowered = _mm256_or_si256(v, _mm256_and_si256(upper, caseBit));
+      
+      unsigned int punctMask = (unsigned int)_mm256_movemask_epi8(punct);
+      
+      //compact each 8-byte group with a shuffle looked up from its keep mask
+      //this is done even for groups without punctuation, so there is no branch to mispredict
+      alignas(32) char block[32];
+      _mm256_store_si256((__m256i*)block, lowered);
+      for (int g = 0; g < 32; g += 8)
+      {
+         unsigned int keepMask = ~(punctMask >> g) & 0xFF;
+         __m128i group = _mm_loadl_epi64((const __m128i*)(block + g));
+         __m128i control = _mm_loadl_epi64((const __m128i*)&COMPACT_TABLE.shuffle[keepMask]);
+         _mm_storel_epi64((__m128i*)(dst + out), _mm_shuffle_epi8(group, control));
+         out += COMPACT_TABLE.count[keepMask];
+      }
+   }
+   
+   //finish the remaining bytes with 16-byte blocks and then one byte at a time
+   return out + normalizeSSE2(src + i, len - i, dst + out);
+}
+
+/**Checks if the processor running the program supports AVX2.
+@return True if normalizeAVX2 can be used, false otherwise. */
+bool Normalizer::hasAVX2()
+{
+   //may run before the compiler's own initialization of the feature flags
+   __builtin_cpu_init();
+   return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+/**The SSE2 kernel, processes 16 bytes of ASCII at a time until a block holds punctuation, and the rest of the word with the scalar kernel. Falls back to the scalar kernel where SSE2 is not available.
+@param src The first character of the word.
+@param len The length of the word.
+@param dst Where the cleaned word is written, it may be equal to src.
+@return The length of the cleaned word. */
+size_t Normalizer::normalizeSSE2(const char* src, size_t len, char* dst)
+{
+   return normalizeScalar(src, len, dst);
+}
+
+/**The AVX2 kernel, processes 32 bytes of ASCII at a time.
+@param src The first character of the word.
+@param len The length of the word.
+@param dst Where the cleaned word is written, it may be equal to src.
+@return The length of the cleaned word.
+@pre hasAVX2() must be true. */
+size_t Normalizer::normalizeAVX2(const char* src, size_t len, char* dst)
+{
+   return normalizeScalar(src, len, dst);
+}
+
+/**Checks if the processor running the program supports AVX2.
+@return True if normalizeAVX2 can be used, false otherwise. */
+bool Normalizer::hasAVX2()
+{
+   return false;
+}
+
+#endif
+
+/**Returns the kernel normalize uses for words of 16 bytes or more.
+@return The AVX2 kernel if the processor supports it, otherwise the SSE2 kernel. */
+Normalizer::kernel Normalizer::bestKernel()
+{
+   return hasAVX2() ? normalizeAVX2 : normalizeSSE2;
+}
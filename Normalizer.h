@@ -0,0 +1,93 @@
+/*
+file name: Normalizer.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the Normalizer class. The Normalizer strips punctuation from a word and folds it to lowercase in a single pass. Words are read as UTF-8. Each ASCII byte is classified with lookup tables built at compile time, which match ispunct and tolower in the C locale, and every kernel stays on this fast path until it meets a byte of 0x80 or above. From there the rest of the word is decoded one code point at a time by the UTF-8 kernel, which drops the Unicode punctuation and applies the simple case folding, both from the Unicode class. Bytes that are not valid UTF-8 are kept as they are. On x86 processors words of 16 bytes or more are processed a block at a time with SSE2, or AVX2 when the processor supports it, and the blocks that contain no punctuation are stored without looking at each byte. Other processors use the scalar table-driven kernel.
+*/
+
+#ifndef NORMALIZER_H
+#define NORMALIZER_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+using namespace std;
+
+class Normalizer
+{
+public:
+   
+   /**Signature shared by the normalization kernels. Copies the characters of src that are not punctuation to dst in lowercase.
+   @param src The first character of the word.
+   @param len The length of the word.
+   @param dst Where the cleaned word is written, it may be equal to src but must not otherwise overlap it.
+   @return The length of the cleaned word. */
+   typedef size_t (*kernel)(const char* src, size_t len, char* dst);
+   
+   /**Copies a word with its punctuation stripped and in lowercase, using the fastest kernel the processor supports.
+   @param word The word to be reformatted.
+   @param cleaned The string to store the reformatted word in.
+   @pre word must not view cleaned.
+   @post cleaned will contain the word stripped of punctuation and in lowercase. */
+   void static normalize(string_view word, string& cleaned);
+   
+   /**Strips a word of punctuation and makes it lowercase in place, using the fastest kernel the processor supports.
+   @param word The word to be reformatted.
+   @pre none
+   @post The word will be stripped of punctuation and be lowercase. */
+   void static normalize(string& word);
+   
+   /**Checks if a character is a punctuation symbol in the C locale.
+   @param c The character to be checked.
+   @return True if the character is punctuation, false otherwise.
+   @pre none
+   @post True will be returned if ispunct would return true for the character in the C locale. */
+   bool static isPunct(char c);
+   
+   /**Checks if a word is a single punctuation symbol, one ASCII character or one UTF-8 sequence.
+   @param word The word to be checked.
+   @return True if the word is one punctuation character, false otherwise.
+   @pre none
+   @post True will be returned if the word is an ASCII character that ispunct would accept in the C locale, or the UTF-8 sequence of a single code point in one of the Unicode punctuation categories. */
+   bool static isPunctSymbol(string_view word);
+   
+   /**The scalar kernel, one table lookup per ASCII byte and no branches on the byte's class. Hands the rest of the word to the UTF-8 kernel at the first byte of 0x80 or above.
+   @param src The first character of the word.
+   @param len The length of the word.
+   @param dst Where the cleaned word is written, it may be equal to src.
+   @return The length of the cleaned word. */
+   size_t static normalizeScalar(const char* src, size_t len, char* dst);
+   
+   /**The UTF-8 kernel, decodes one code point at a time. Drops the code points that are punctuation and folds the rest to lowercase, copying bytes that are not valid UTF-8 as they are.
+   @param src The first character of the word.
+   @param len The length of the word.
+   @param dst Where the cleaned word is written, it may be equal to src.
+   @return The length of the cleaned word. */
+   size_t static normalizeUTF8(const char* src, size_t len, char* dst);
+   
+   /**The SSE2 kernel, processes 16 bytes of ASCII at a time until a block holds punctuation, and the rest of the word with the scalar kernel. Falls back to the scalar kernel where SSE2 is not available.
+   @param src The first character of the word.
+   @param len The length of the word.
+   @param dst Where the cleaned word is written, it may be equal to src.
+   @return The length of the cleaned word. */
+   size_t static normalizeSSE2(const char* src, size_t len, char* dst);
+   
+   /**The AVX2 kernel, processes 32 bytes of ASCII at a time.
+   @param src The first character of the word.
+   @param len The length of the word.
+   @param dst Where the cleaned word is written, it may be equal to src.
+   @return The length of the cleaned word.
+   @pre hasAVX2() must be true. */
+   size_t static normalizeAVX2(const char* src, size_t len, char* dst);
+   
+   /**Checks if the processor running the program supports AVX2.
+   @return True if normalizeAVX2 can be used, false otherwise. */
+   bool static hasAVX2();
+   
+   /**Returns the kernel normalize uses for words of 16 bytes or more.
+   @return The AVX2 kernel if the processor supports it, otherwise the SSE2 kernel. */
+   kernel static bestKernel();
+};
+
+#endif
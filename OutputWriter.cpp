@@ -0,0 +1,274 @@
+/*
+file name: OutputWriter.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the OutputWriter class. An OutputWriter formats the rows of the concordance straight into a large byte buffer and writes the buffer to a file descriptor with a few large write calls. Each row has the same KWIC layout that setw produced: the words before the keyword right justified in the first column, the keyword centered in the second, and the words after it left justified in the third. A concordance read from several documents puts the document number of each row in a column in front of them. The words are copied out of the Vocabulary and the padding is filled in place, so no strings are built for a row and the stream is not flushed after every line. The rows are formatted by templates over the window, so the words of each column are copied with loops of a fixed length.
+*/
+
+#include "OutputWriter.h"
+
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+/** Constructor for the OutputWriter class that accepts the file descriptor to write to.
+Constructs an OutputWriter with an empty buffer and no column widths.
+@param fileDescriptor The file descriptor the rows are written to, standard output by default.
+@pre The file descriptor must be open for writing. */
+OutputWriter::OutputWriter(int fileDescriptor) : buffer(BUFFER_BYTES), used(0), fd(fileDescriptor), failed(false), bytesWritten(0), hold(false),
+   preKeyWidth(0), keyWidth(0), postKeyWidth(0), numDocuments(0), documentWidth(0)
+{
+}
+
+/** The destructor for the OutputWriter class.
+Writes out anything left in the buffer when its lifetime ends. */
+OutputWriter::~OutputWriter()
+{
+   flush();
+}
+
+/**Sets the widths of the three columns from the maximum lengths in the concordance.
+@param preKeyLen The total length of the longest run of words before a keyword.
+@param keyLen The length of the longest keyword.
+@param postKeyLen The total length of the longest run of words after a keyword.
+@pre The lengths must be of type int.
+@post The columns will be preKeyLen + 40, keyLen + 10, and postKeyLen + 40 characters wide. */
+void OutputWriter::setColumns(int preKeyLen, int keyLen, int postKeyLen)
+{
+   preKeyWidth = preKeyLen + 40;
+   keyWidth = keyLen + 10;
+   postKeyWidth = postKeyLen + 40;
+}
+
+/**Sets the width of the column of document numbers in front of the rows.
+@param numDocuments The highest document number of the concordance, 0 if it was read from a single corpus.
+@pre none
+@post If numDocuments is 0 the rows have no document column. Otherwise each row starts with its document number, right justified in a column as wide as numDocuments, and a space. */
+void OutputWriter::setDocumentColumn(uint32_t numDocuments)
+{
+   this->numDocuments = numDocuments;
+   documentWidth = 0;
+   for (uint32_t left = numDocuments; left != 0; left /= 10)
+      documentWidth++;
+}
+
+/**Returns the highest document number the document column was set for.
+@return The number given to setDocumentColumn, 0 if the rows have no document column.
+@pre none
+@post The number will be returned as a uint32_t. */
+uint32_t OutputWriter::getDocumentColumn() const
+{
+   return numDocuments;
+}
+
+/**Formats one row of the concordance into the buffer.
+@param context The context array of the row, with the keyword at index BEFORE.
+@param vocab The Vocabulary the context word IDs were interned in.
+@param document The number of the document the row was read from, written only if there is a document column.
+@pre The columns must have been set. vocab must be the Vocabulary used to build the context.
+@post The row will be in the buffer, ending in a newline, laid out the same as the words before the keyword in a right justified setw field, the keyword centered in a setw field, and the words after it in a left justified setw field. The buffer is written out if it is full. */
+template <int BEFORE, int AFTER>
+void OutputWriter::writeRow(const typename ListNode<BEFORE, AFTER>::contextArr& context, const Vocabulary& vocab, uint32_t document)
+{
+   rowWords<BEFORE, AFTER> words;
+   for (int i = 0; i < ListNode<BEFORE, AFTER>::NUM_WORDS; i++)
+      words[i] = vocab.getWord(context[i]);
+   writeRow<BEFORE, AFTER>(words, document);
+}
+
+/**Formats one row of the concordance into the buffer from its words.
+@param words The words of the row, with the keyword at index BEFORE and empty views where there is no word.
+@param document The number of the document the row was read from, written only if there is a document column.
+@pre The columns must have been set.
+@post The row will be in the buffer, laid out the same as a row written from a context array. The buffer is written out if it is full. */
+template <int BEFORE, int AFTER>
+void OutputWriter::writeRow(const rowWords<BEFORE, AFTER>& words, uint32_t document)
+{
+   //lengths of the words before and after the keyword, with the spaces between them
+   int preKeyLen = BEFORE - 1;
+   int postKeyLen = AFTER - 1;
+   for (int i = 0; i < BEFORE; i++)
+      preKeyLen += (int)words[i].length();
+   for (int i = BEFORE + 1; i < BEFORE + 1 + AFTER; i++)
+      postKeyLen += (int)words[i].length();
+   string_view keyWord = words[BEFORE];
+   int keyLen = (int)keyWord.length();
+   
+   //the keyword gets half the spare room after it and the rest before it, as the padded keyword did
+   int padAfter = max(0, (keyWidth - keyLen) / 2);
+   int padBefore = max(0, keyWidth - padAfter - keyLen);
+   
+   //setw pads short fields and never cuts long ones
+   int prePad = max(0, preKeyWidth - preKeyLen);
+   int postPad = max(0, postKeyWidth - postKeyLen);
+   
+   //the document column and the space after it, if the rows have one
+   int documentLen = documentWidth == 0 ? 0 : documentWidth + 1;
+   
+   char* out = reserve((size_t)(documentLen + prePad + preKeyLen + padBefore + keyLen + padAfter + postKeyLen + postPad + 1));
+   
+   //document number, right justified
+   if ( documentLen != 0 )
+   {
+      char* digit = out + documentWidth;
+      *digit = ' ';
+      do
+      {
+         *--digit = (char)('0' + document % 10);
+         document /= 10;
+      } while ( document != 0 && digit != out );
+      memset(out, ' ', (size_t)(digit - out));
+      out += documentLen;
+   }
+   
+   //first column, right justified
+   memset(out, ' ', (size_t)prePad);
+   out = copyWords<BEFORE>(out + prePad, words.data());
+   
+   //second column, keyword centered
+   memset(out, ' ', (size_t)padBefore);
+   out += padBefore;
+   memcpy(out, keyWord.data(), (size_t)keyLen);
+   out += keyLen;
+   memset(out, ' ', (size_t)padAfter);
+   out += padAfter;
+   
+   //third column, left justified
+   out = copyWords<AFTER>(out, words.data() + BEFORE + 1);
+   memset(out, ' ', (size_t)postPad);
+   out += postPad;
+   *out++ = '\n';
+   
+   used = (size_t)(out - buffer.data());
+}
+
+/**Copies text into the buffer as it is.
+@param text The text to be written.
+@pre none
+@post The text will be in the buffer. The buffer is written out if it is full. */
+void OutputWriter::writeText(string_view text)
+{
+   char* out = reserve(text.length());
+   memcpy(out, text.data(), text.length());
+   used += text.length();
+}
+
+/**Writes everything in the buffer to the file descriptor.
+@return True if every byte written so far reached the file descriptor, false if a write failed.
+@pre none
+@post The buffer will be empty. After a failed write, later output is discarded. */
+bool OutputWriter::flush()
+{
+   const char* next = buffer.data();
+   size_t left = used;
+   
+   //write may take fewer bytes than asked for, keep going until the buffer is empty
+   while ( !failed && left > 0 )
+   {
+      ssize_t written = ::write(fd, next, left);
+      if ( written < 0 )
+      {
+         //interrupted before anything was written, try again
+         if ( errno == EINTR )
+            continue;
+         failed = true;
+      }
+      else
+      {
+         next += written;
+         left -= (size_t)written;
+         bytesWritten += (uint64_t)written;
+      }
+   }
+   
+   used = 0;
+   return !failed;
+}
+
+/**Holds the output in the buffer instead of writing it out when the buffer is full.
+@param holding True to hold the output, false to write it out whenever the buffer is full.
+@pre none
+@post While held, the buffer grows as needed and nothing is written until flush is called, so output formatted on several threads can be written in order. */
+void OutputWriter::setHold(bool holding)
+{
+   hold = holding;
+}
+
+/**Returns the file descriptor the writer writes to.
+@return The file descriptor.
+@pre none
+@post The file descriptor will be returned as an int. */
+int OutputWriter::getFileDescriptor() const
+{
+   return fd;
+}
+
+/**Returns the number of bytes written to the file descriptor.
+@return The bytes written by flushes of this writer, and those added with addBytesWritten.
+@pre none
+@post The number of bytes will be returned as a uint64_t. */
+uint64_t OutputWriter::getBytesWritten() const
+{
+   return bytesWritten;
+}
+
+/**Counts bytes another writer wrote to the same file descriptor on this writer's behalf.
+@param bytes The number of bytes.
+@pre none
+@post getBytesWritten will include the bytes. */
+void OutputWriter::addBytesWritten(uint64_t bytes)
+{
+   bytesWritten += bytes;
+}
+
+/**Makes room in the buffer.
+@param bytes The number of bytes needed.
+@return A pointer to the first free byte of the buffer.
+@pre none
+@post At least bytes bytes will be free after the returned pointer. If there was not enough room, the buffer is written out first, unless it is held, and grown if it is still too small. */
+char* OutputWriter::reserve(size_t bytes)
+{
+   if ( used + bytes > buffer.size() )
+   {
+      //held output stays in the buffer, which doubles to make room
+      if ( hold )
+         buffer.resize(max(buffer.size() * 2, used + bytes));
+      else
+      {
+         flush();
+         
+         //a single row longer than the whole buffer
+         if ( bytes > buffer.size() )
+            buffer.resize(bytes);
+      }
+   }
+   return buffer.data() + used;
+}
+
+/**Copies a run of the words of a row, separated by single spaces.
+@param out Where to copy the words to.
+@param words The first word of the run.
+@return One past the last character copied.
+@pre out must have room for the COUNT words and the spaces between them.
+@post The COUNT words will be copied to out, with a space between each pair. */
+template <int COUNT>
+char* OutputWriter::copyWords(char* out, const string_view* words)
+{
+   for (int i = 0; i < COUNT; i++)
+   {
+      //no space before the first word
+      if ( i != 0 )
+         *out++ = ' ';
+      
+      memcpy(out, words[i].data(), words[i].length());
+      out += words[i].length();
+   }
+   return out;
+}
+
+//compile the rows of every window
+#define INSTANTIATE(BEFORE, AFTER) \
+   template void OutputWriter::writeRow<BEFORE, AFTER>(const ListNode<BEFORE, AFTER>::contextArr&, const Vocabulary&, uint32_t); \
+   template void OutputWriter::writeRow<BEFORE, AFTER>(const rowWords<BEFORE, AFTER>&, uint32_t);
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
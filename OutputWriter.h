@@ -0,0 +1,147 @@
+/*
+file name: OutputWriter.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the OutputWriter class. An OutputWriter formats the rows of the concordance straight into a large byte buffer and writes the buffer to a file descriptor with a few large write calls. Each row has the same KWIC layout that setw produced: the words before the keyword right justified in the first column, the keyword centered in the second, and the words after it left justified in the third. A concordance read from several documents puts the document number of each row in a column in front of them. The words are copied out of the Vocabulary and the padding is filled in place, so no strings are built for a row and the stream is not flushed after every line. The rows are formatted by templates over the window, so the words of each column are copied with loops of a fixed length.
+*/
+
+#ifndef OUTPUTWRITER_H
+#define OUTPUTWRITER_H
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <unistd.h>
+#include "ListNode.h"
+
+using namespace std;
+
+class OutputWriter
+{
+public:
+   
+   static constexpr size_t BUFFER_BYTES = 1 << 20; //the buffer is written out once it holds this many bytes
+   
+   //the words of a row, with the keyword at index BEFORE
+   template <int BEFORE, int AFTER>
+   using rowWords = array<string_view, ListNode<BEFORE, AFTER>::NUM_WORDS>;
+   
+   /** Constructor for the OutputWriter class that accepts the file descriptor to write to.
+   Constructs an OutputWriter with an empty buffer and no column widths.
+   @param fileDescriptor The file descriptor the rows are written to, standard output by default.
+   @pre The file descriptor must be open for writing. */
+   OutputWriter(int fileDescriptor = STDOUT_FILENO);
+   
+   /** The destructor for the OutputWriter class.
+   Writes out anything left in the buffer when its lifetime ends. */
+   virtual ~OutputWriter();
+   
+   /**Sets the widths of the three columns from the maximum lengths in the concordance.
+   @param preKeyLen The total length of the longest run of words before a keyword.
+   @param keyLen The length of the longest keyword.
+   @param postKeyLen The total length of the longest run of words after a keyword.
+   @pre The lengths must be of type int.
+   @post The columns will be preKeyLen + 40, keyLen + 10, and postKeyLen + 40 characters wide. */
+   void setColumns(int preKeyLen, int keyLen, int postKeyLen);
+   
+   /**Sets the width of the column of document numbers in front of the rows.
+   @param numDocuments The highest document number of the concordance, 0 if it was read from a single corpus.
+   @pre none
+   @post If numDocuments is 0 the rows have no document column. Otherwise each row starts with its document number, right justified in a column as wide as numDocuments, and a space. */
+   void setDocumentColumn(uint32_t numDocuments);
+   
+   /**Returns the highest document number the document column was set for.
+   @return The number given to setDocumentColumn, 0 if the rows have no document column.
+   @pre none
+   @post The number will be returned as a uint32_t. */
+   uint32_t getDocumentColumn() const;
+   
+   /**Formats one row of the concordance into the buffer.
+   @param context The context array of the row, with the keyword at index BEFORE.
+   @param vocab The Vocabulary the context word IDs were interned in.
+   @param document The number of the document the row was read from, written only if there is a document column.
+   @pre The columns must have been set. vocab must be the Vocabulary used to build the context.
+   @post The row will be in the buffer, ending in a newline, laid out the same as the words before the keyword in a right justified setw field, the keyword centered in a setw field, and the words after it in a left justified setw field. The buffer is written out if it is full. */
+   template <int BEFORE, int AFTER>
+   void writeRow(const typename ListNode<BEFORE, AFTER>::contextArr& context, const Vocabulary& vocab, uint32_t document = 0);
+   
+   /**Formats one row of the concordance into the buffer from its words.
+   @param words The words of the row, with the keyword at index BEFORE and empty views where there is no word.
+   @param document The number of the document the row was read from, written only if there is a document column.
+   @pre The columns must have been set.
+   @post The row will be in the buffer, laid out the same as a row written from a context array. The buffer is written out if it is full. */
+   template <int BEFORE, int AFTER>
+   void writeRow(const rowWords<BEFORE, AFTER>& words, uint32_t document = 0);
+   
+   /**Copies text into the buffer as it is.
+   @param text The text to be written.
+   @pre none
+   @post The text will be in the buffer. The buffer is written out if it is full. */
+   void writeText(string_view text);
+   
+   /**Writes everything in the buffer to the file descriptor.
+   @return True if every byte written so far reached the file descriptor, false if a write failed.
+   @pre none
+   @post The buffer will be empty. After a failed write, later output is discarded. */
+   bool flush();
+   
+   /**Holds the output in the buffer instead of writing it out when the buffer is full.
+   @param holding True to hold the output, false to write it out whenever the buffer is full.
+   @pre none
+   @post While held, the buffer grows as needed and nothing is written until flush is called, so output formatted on several threads can be written in order. */
+   void setHold(bool holding);
+   
+   /**Returns the file descriptor the writer writes to.
+   @return The file descriptor.
+   @pre none
+   @post The file descriptor will be returned as an int. */
+   int getFileDescriptor() const;
+   
+   /**Returns the number of bytes written to the file descriptor.
+   @return The bytes written by flushes of this writer, and those added with addBytesWritten.
+   @pre none
+   @post The number of bytes will be returned as a uint64_t. */
+   uint64_t getBytesWritten() const;
+   
+   /**Counts bytes another writer wrote to the same file descriptor on this writer's behalf.
+   @param bytes The number of bytes.
+   @pre none
+   @post getBytesWritten will include the bytes. */
+   void addBytesWritten(uint64_t bytes);
+   
+private:
+   //a writer owns its buffer, so it cannot be copied
+   OutputWriter(const OutputWriter&);
+   OutputWriter& operator=(const OutputWriter&);
+   
+   /**Makes room in the buffer.
+   @param bytes The number of bytes needed.
+   @return A pointer to the first free byte of the buffer.
+   @pre none
+   @post At least bytes bytes will be free after the returned pointer. If there was not enough room, the buffer is written out first, unless it is held, and grown if it is still too small. */
+   char* reserve(size_t bytes);
+   
+   /**Copies a run of the words of a row, separated by single spaces.
+   @param out Where to copy the words to.
+   @param words The first word of the run.
+   @return One past the last character copied.
+   @pre out must have room for the COUNT words and the spaces between them.
+   @post The COUNT words will be copied to out, with a space between each pair. */
+   template <int COUNT>
+   char static* copyWords(char* out, const string_view* words);
+   
+   vector<char> buffer; //the rows formatted so far
+   size_t used; //number of bytes of the buffer in use
+   int fd; //file descriptor the buffer is written to
+   bool failed; //true once a write has failed
+   uint64_t bytesWritten; //number of bytes that reached the file descriptor
+   bool hold; //true if the buffer grows instead of being written out when it is full
+   int preKeyWidth; //width of the column of words before the keyword
+   int keyWidth; //width of the keyword column
+   int postKeyWidth; //width of the column of words after the keyword
+   uint32_t numDocuments; //highest document number, 0 for no document column
+   int documentWidth; //width of the document column, without the space after it
+};
+
+#endif
@@ -0,0 +1,200 @@
+/*
+file name: ParallelIngester.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the ParallelIngester class. A ParallelIngester builds a concordance from a corpus on several threads. The corpus is split into chunks at word boundaries and each chunk is read into its own HashConcordance, starting as many words early as there are before each keyword and stopping as many late as there are after it, so the contexts of the words at the edges of a chunk are the same as in a single-threaded run. The partial concordances are then merged into the target concordance in corpus order: the words of each chunk are appended to the target's word stream, and the context lists follow them, so each keyword's contexts stay in the order they appear in the corpus.
+*/
+
+#include "ParallelIngester.h"
+
+#include <deque>
+#include <thread>
+#include "CorpusReader.h"
+#include "TaskRunner.h"
+
+/** Constructor for the ParallelIngester class.
+@param threads The number of threads to read the corpus on.
+@pre threads must be at least 1. */
+ParallelIngester::ParallelIngester(int threads) : numThreads(threads)
+{
+}
+
+/**Adds every word of a corpus, with its context, to a concordance.
+@param corpus The text of the corpus.
+@param target The concordance the words are added to.
+@pre target must be empty, with its stop words already set.
+@post target will contain the same keywords, contexts, and maximum lengths as if each word of the corpus had been added to it in order on a single thread. */
+template <int BEFORE, int AFTER>
+void ParallelIngester::ingest(string_view corpus, WindowedConcordance<BEFORE, AFTER>& target) const
+{
+   //a few chunks per thread, but none smaller than MIN_CHUNK_BYTES
+   size_t numChunks = min((size_t)numThreads * CHUNKS_PER_THREAD, corpus.length() / MIN_CHUNK_BYTES + 1);
+   vector<string_view> chunks;
+   splitChunks(corpus, (int)numChunks, chunks);
+   
+   //read each chunk into its own concordance, in parallel
+   deque<HashConcordance<BEFORE, AFTER>> partials(chunks.size());
+   vector<pair<uint64_t, uint64_t>> keys(chunks.size());
+   TaskRunner::run(numThreads, chunks.size(), [&](size_t c)
+   {
+      ingestChunk<BEFORE, AFTER>(corpus, chunks[c], partials[c], keys[c]);
+   });
+   
+   //give every word a single ID in the target's Vocabulary, the Vocabulary is not thread safe
+   vector<vector<Vocabulary::wordId>> newIds(partials.size());
+   for (size_t c = 0; c < partials.size(); c++)
+      newIds[c] = target.mapVocabulary(partials[c].getVocabulary());
+   
+   //make room for the words of each chunk in the target's word stream, in corpus order, which lays the chunks out as one text
+   uint64_t numWords = 0;
+   for (size_t c = 0; c < partials.size(); c++)
+      numWords += keys[c].second - keys[c].first;
+   target.reserveWords(numWords + 2 * WindowedConcordance<BEFORE, AFTER>::PADDING);
+   vector<int64_t> shifts(partials.size());
+   target.startText();
+   for (size_t c = 0; c < partials.size(); c++)
+      shifts[c] = target.placeWords(partials[c], keys[c].first, keys[c].second);
+   target.endText();
+   
+   //the chunks fill rooms of their own, so their words are put in the target's IDs in parallel
+   TaskRunner::run(numThreads, partials.size(), [&](size_t c)
+   {
+      target.remapWords(partials[c], keys[c].first, keys[c].second, shifts[c], newIds[c]);
+   });
+   
+   //move the context lists after the words, in corpus order, which keeps each keyword's contexts in order
+   for (size_t c = 0; c < partials.size(); c++)
+      partials[c].moveContextsInto(target, shifts[c]);
+}
+
+/**Returns the number of threads the hardware can run at once.
+@return The number of hardware threads, or 1 if it is not known.
+@pre none
+@post The number of hardware threads will be returned as an int. */
+int ParallelIngester::hardwareThreads()
+{
+   unsigned int threads = thread::hardware_concurrency();
+   return threads == 0 ? 1 : (int)threads;
+}
+
+/**Splits a corpus into chunks that start at the beginning of a word.
+@param corpus The text of the corpus.
+@param numChunks The number of chunks to split the corpus into.
+@param chunks The vector to store the chunks in.
+@pre numChunks must be at least 1.
+@post chunks will cover the corpus in order with no gaps. Each chunk but the first starts at the first character of a word, so no word is split between chunks. Some chunks may be empty if the corpus has very long words. */
+void ParallelIngester::splitChunks(string_view corpus, int numChunks, vector<string_view>& chunks)
+{
+   const char* begin = corpus.data();
+   const char* end = begin + corpus.length();
+   const char* chunkStart = begin;
+   
+   chunks.clear();
+   for (int c = 1; c <= numChunks; c++)
+   {
+      //aim for an equal share of the bytes, then move forward to the start of the next word
+      const char* chunkEnd = c == numChunks ? end : max(chunkStart, begin + corpus.length() / numChunks * c);
+      while ( chunkEnd != end && chunkEnd != begin && !CorpusReader::isSpace(chunkEnd[-1]) )
+         chunkEnd++;
+      while ( chunkEnd != end && CorpusReader::isSpace(*chunkEnd) )
+         chunkEnd++;
+      
+      chunks.push_back(string_view(chunkStart, (size_t)(chunkEnd - chunkStart)));
+      chunkStart = chunkEnd;
+   }
+}
+
+/**Finds where the words that make up the pre-key context of a chunk's first word begin.
+@param corpus The text of the corpus.
+@param chunkStart The first character of the chunk.
+@param wordsBefore The number of context words before a keyword.
+@return The first character of the wordsBefore-th word before the chunk that is not a punctuation symbol, or the beginning of the corpus if there are fewer.
+@pre chunkStart must point into the corpus.
+@post The words between the returned position and chunkStart will be the words before the chunk, with lone punctuation symbols included. */
+const char* ParallelIngester::findLeadIn(string_view corpus, const char* chunkStart, int wordsBefore)
+{
+   const char* begin = corpus.data();
+   const char* leadIn = chunkStart;
+   int numWords = 0;
+   
+   //walk back one word at a time
+   while ( numWords < wordsBefore )
+   {
+      while ( leadIn != begin && CorpusReader::isSpace(leadIn[-1]) )
+         leadIn--;
+      if ( leadIn == begin )
+         break;
+      
+      const char* wordEnd = leadIn;
+      while ( leadIn != begin && !CorpusReader::isSpace(leadIn[-1]) )
+         leadIn--;
+      
+      //lone punctuation symbols are not part of any context
+      if ( !Concordance::isPunct(string_view(leadIn, (size_t)(wordEnd - leadIn))) )
+         numWords++;
+   }
+   return leadIn;
+}
+
+/**Reads one chunk of a corpus into a concordance of its own.
+@param corpus The text of the corpus.
+@param chunk The chunk to be read.
+@param partial The concordance to add the chunk's words to.
+@param keys Set to the positions in partial's word stream of the chunk's first word and one past its last word.
+@pre chunk must be one of the chunks made by splitChunks. partial must be empty and exclude no stop words.
+@post partial will contain every word that starts in the chunk as a keyword, with the same context as in the whole corpus. Its word stream holds the chunk's words between the positions in keys, after the words before the chunk and followed by the words after it that make up their contexts. Its maximum lengths will cover those keywords. */
+template <int BEFORE, int AFTER>
+void ParallelIngester::ingestChunk(string_view corpus, string_view chunk, HashConcordance<BEFORE, AFTER>& partial, pair<uint64_t, uint64_t>& keys)
+{
+   const char* chunkStart = chunk.data();
+   const char* chunkEnd = chunkStart + chunk.length();
+   const char* corpusEnd = corpus.data() + corpus.length();
+   
+   //read from the lead-in words before the chunk to the end of the corpus, stopping once the lead-out words are read
+   const char* leadIn = findLeadIn(corpus, chunkStart, BEFORE);
+   CorpusReader reader;
+   reader.openText(string_view(leadIn, (size_t)(corpusEnd - leadIn)));
+   
+   //the empty words before the lead-in stand for the start of the corpus, if the lead-in is short
+   partial.startText();
+   string_view word;
+   
+   keys = make_pair(0, 0);
+   int numLeadOut = 0; //words read after the chunk
+   
+   while ( reader.nextWord(word) )
+   {
+      //lone punctuation symbols are skipped, as in a single-threaded run
+      if ( Concordance::isPunct(word) )
+         continue;
+      
+      //the words after the chunk that complete its last contexts have been read
+      if ( word.data() >= chunkEnd && numLeadOut == AFTER )
+         break;
+      
+      uint64_t position = partial.appendWord(word);
+      
+      //words before the chunk are only context for its first keywords
+      if ( word.data() < chunkStart )
+         continue;
+      
+      //words after the chunk complete the contexts of its last keywords, but are never keywords here
+      if ( word.data() >= chunkEnd )
+         numLeadOut++;
+      else if ( keys.second == 0 )
+         keys = make_pair(position, position + 1);
+      else
+         keys.second = position + 1;
+   }
+   
+   //the empty words after the lead-out stand for the end of the corpus, if the lead-out is short
+   partial.endText();
+   for (uint64_t position = keys.first; position < keys.second; position++)
+      partial.add(position);
+}
+
+//compile the ingestion of every window
+#define INSTANTIATE(BEFORE, AFTER) \
+   template void ParallelIngester::ingest<BEFORE, AFTER>(string_view, WindowedConcordance<BEFORE, AFTER>&) const;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
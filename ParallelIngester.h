@@ -0,0 +1,77 @@
+/*
+file name: ParallelIngester.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the ParallelIngester class. A ParallelIngester builds a concordance from a corpus on several threads. The corpus is split into chunks at word boundaries and each chunk is read into its own HashConcordance, starting as many words early as there are before each keyword and stopping as many late as there are after it, so the contexts of the words at the edges of a chunk are the same as in a single-threaded run. The partial concordances are then merged into the target concordance in corpus order: the words of each chunk are appended to the target's word stream, and the context lists follow them, so each keyword's contexts stay in the order they appear in the corpus.
+*/
+
+#ifndef PARALLELINGESTER_H
+#define PARALLELINGESTER_H
+
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "HashConcordance.h"
+
+using namespace std;
+
+class ParallelIngester
+{
+public:
+   
+   static constexpr size_t MIN_CHUNK_BYTES = 1 << 20; //chunks are at least this large, so small corpora are not split finely
+   static constexpr int CHUNKS_PER_THREAD = 4; //more chunks than threads, so a thread with a slow chunk does not hold up the rest
+   
+   /** Constructor for the ParallelIngester class.
+   @param threads The number of threads to read the corpus on.
+   @pre threads must be at least 1. */
+   ParallelIngester(int threads);
+   
+   /**Adds every word of a corpus, with its context, to a concordance.
+   @param corpus The text of the corpus.
+   @param target The concordance the words are added to.
+   @pre target must be empty, with its stop words already set.
+   @post target will contain the same keywords, contexts, and maximum lengths as if each word of the corpus had been added to it in order on a single thread. */
+   template <int BEFORE, int AFTER>
+   void ingest(string_view corpus, WindowedConcordance<BEFORE, AFTER>& target) const;
+   
+   /**Returns the number of threads the hardware can run at once.
+   @return The number of hardware threads, or 1 if it is not known.
+   @pre none
+   @post The number of hardware threads will be returned as an int. */
+   int static hardwareThreads();
+   
+private:
+   
+   /**Splits a corpus into chunks that start at the beginning of a word.
+   @param corpus The text of the corpus.
+   @param numChunks The number of chunks to split the corpus into.
+   @param chunks The vector to store the chunks in.
+   @pre numChunks must be at least 1.
+   @post chunks will cover the corpus in order with no gaps. Each chunk but the first starts at the first character of a word, so no word is split between chunks. Some chunks may be empty if the corpus has very long words. */
+   void static splitChunks(string_view corpus, int numChunks, vector<string_view>& chunks);
+   
+   /**Finds where the words that make up the pre-key context of a chunk's first word begin.
+   @param corpus The text of the corpus.
+   @param chunkStart The first character of the chunk.
+   @param wordsBefore The number of context words before a keyword.
+   @return The first character of the wordsBefore-th word before the chunk that is not a punctuation symbol, or the beginning of the corpus if there are fewer.
+   @pre chunkStart must point into the corpus.
+   @post The words between the returned position and chunkStart will be the words before the chunk, with lone punctuation symbols included. */
+   const char static* findLeadIn(string_view corpus, const char* chunkStart, int wordsBefore);
+   
+   /**Reads one chunk of a corpus into a concordance of its own.
+   @param corpus The text of the corpus.
+   @param chunk The chunk to be read.
+   @param partial The concordance to add the chunk's words to.
+   @param keys Set to the positions in partial's word stream of the chunk's first word and one past its last word.
+   @pre chunk must be one of the chunks made by splitChunks. partial must be empty and exclude no stop words.
+   @post partial will contain every word that starts in the chunk as a keyword, with the same context as in the whole corpus. Its word stream holds the chunk's words between the positions in keys, after the words before the chunk and followed by the words after it that make up their contexts. Its maximum lengths will cover those keywords. */
+   template <int BEFORE, int AFTER>
+   void static ingestChunk(string_view corpus, string_view chunk, HashConcordance<BEFORE, AFTER>& partial, pair<uint64_t, uint64_t>& keys);
+   
+   int numThreads; //number of threads to read the corpus on
+};
+
+#endif
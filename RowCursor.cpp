@@ -0,0 +1,215 @@
+/*
+file name: RowCursor.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the RowCursor class. A RowCursor is a forward iterator over the rows of any concordance engine, a context of a keyword at a time, in the order they are printed: alphabetical by keyword, and in corpus order within a keyword. It visits the keywords with the KeyWalk of the engine, which walks the engine's own ordered structure, and reads the positions of each keyword's list with a ContextList::Reader and the context of each position from the word stream. It holds the walk's place in the engine and one row, never the lists of every keyword nor the rows of a whole list, so copying it costs no more than copying the walk: the path down a tree or a trie, or an index into the hash engine's sorted entries. It is a template over the window of the concordance's contexts.
+*/
+
+#include "RowCursor.h"
+
+using namespace std;
+
+/** The default constructor for the RowCursor class.
+Constructs a cursor past the last row of any concordance. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER>::RowCursor() : walk(nullptr), words(nullptr), list(nullptr), position(0), row{string_view(), {}, 0}
+{
+}
+
+/** Constructor for the RowCursor class that accepts the walk over the keywords to visit and the word stream their contexts are read from.
+Moves to the first row of the first keyword with a context.
+@param walk The walk over the keywords, which the cursor takes over and deletes.
+@param words The WordStream the positions in the context lists point into.
+@pre The engine the walk visits and the word stream must not change or be destroyed while the cursor is used. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER>::RowCursor(KeyWalk* walk, const WordStream* words)
+   : walk(walk), words(words), list(nullptr), position(0), row{string_view(), {}, 0}
+{
+   findRow();
+}
+
+/**The copy constructor for the RowCursor class.
+Makes a copy of the cursor at the same row, with a copy of its walk.
+@param cursor The cursor to be copied. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER>::RowCursor(const RowCursor& cursor)
+   : walk(cursor.walk == nullptr ? nullptr : cursor.walk->clone()), words(cursor.words), list(cursor.list),
+     reader(cursor.reader), position(cursor.position), row(cursor.row)
+{
+   //the keyword may be held by the walk, so view the copy's
+   if ( list != nullptr )
+      row.keyWord = walk->getKey();
+}
+
+/**The move constructor for the RowCursor class.
+Takes the walk of the cursor supplied as the argument without copying it.
+@param cursor The cursor to be moved. It will be past the last row. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER>::RowCursor(RowCursor&& cursor) noexcept
+   : walk(cursor.walk), words(cursor.words), list(cursor.list),
+     reader(cursor.reader), position(cursor.position), row(cursor.row)
+{
+   cursor.walk = nullptr;
+   cursor.list = nullptr;
+}
+
+/** Overloaded assignment operator for the RowCursor class.
+@param rhs The cursor on the right side of the assignment operator.
+@return The cursor on the left side.
+@post The cursor on the left side will be at the same row as the one on the right, with a copy of its walk. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER>& RowCursor<BEFORE, AFTER>::operator=(const RowCursor& rhs)
+{
+   if ( this != &rhs )
+   {
+      RowCursor copy(rhs);
+      swap(walk, copy.walk);
+      words = copy.words;
+      list = copy.list;
+      reader = copy.reader;
+      position = copy.position;
+      row = copy.row;
+   }
+   return *this;
+}
+
+/** The destructor for the RowCursor class.
+Deletes the walk when its lifetime ends. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER>::~RowCursor()
+{
+   delete walk;
+}
+
+/**Tests whether the cursor is past the last row.
+@return True if there are no rows left, false otherwise.
+@pre none
+@post The cursor is unchanged. */
+template <int BEFORE, int AFTER>
+bool RowCursor<BEFORE, AFTER>::atEnd() const
+{
+   return list == nullptr;
+}
+
+/**Returns the current row.
+@return The keyword and context of the row.
+@pre The cursor must not be past the last row.
+@post The row will be returned as a const reference, valid until the cursor is moved. */
+template <int BEFORE, int AFTER>
+const typename RowCursor<BEFORE, AFTER>::Row& RowCursor<BEFORE, AFTER>::operator*() const
+{
+   return row;
+}
+
+/**Returns the current row.
+@return A pointer to the keyword and context of the row.
+@pre The cursor must not be past the last row.
+@post The row will be returned as a const pointer, valid until the cursor is moved. */
+template <int BEFORE, int AFTER>
+const typename RowCursor<BEFORE, AFTER>::Row* RowCursor<BEFORE, AFTER>::operator->() const
+{
+   return &row;
+}
+
+/**Moves to the next row.
+@return The cursor.
+@pre The cursor must not be past the last row.
+@post The cursor will be at the next context of the keyword, or at the first context of the next keyword, or past the last row. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER>& RowCursor<BEFORE, AFTER>::operator++()
+{
+   //still in the same keyword's context list
+   if ( reader.next(position) )
+      readRow();
+   else
+      nextKey();
+   return *this;
+}
+
+/**Moves to the next row.
+@return A copy of the cursor from before it was moved.
+@pre The cursor must not be past the last row.
+@post The cursor will be at the next row, or past the last row. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER> RowCursor<BEFORE, AFTER>::operator++(int)
+{
+   RowCursor before(*this);
+   ++(*this);
+   return before;
+}
+
+/**Moves to the first row of the next keyword, skipping the rest of the rows of the current one.
+@pre The cursor must not be past the last row.
+@post The cursor will be at the first context of the next keyword, or past the last row. */
+template <int BEFORE, int AFTER>
+void RowCursor<BEFORE, AFTER>::nextKey()
+{
+   walk->next();
+   findRow();
+}
+
+/**Returns the context list of the current keyword.
+@return The context list of the keyword of the current row.
+@pre The cursor must not be past the last row.
+@post The context list will be returned as a const reference. */
+template <int BEFORE, int AFTER>
+const ContextList& RowCursor<BEFORE, AFTER>::getContextList() const
+{
+   return *list;
+}
+
+/**Tests whether two cursors are at the same row.
+@param other The cursor to compare with.
+@return True if both are at the same row of the same context list, or both are past the last row. False otherwise. */
+template <int BEFORE, int AFTER>
+bool RowCursor<BEFORE, AFTER>::operator==(const RowCursor& other) const
+{
+   return list == other.list && (list == nullptr || position == other.position);
+}
+
+/**Tests whether two cursors are at different rows.
+@param other The cursor to compare with.
+@return True if the cursors are not at the same row, false otherwise. */
+template <int BEFORE, int AFTER>
+bool RowCursor<BEFORE, AFTER>::operator!=(const RowCursor& other) const
+{
+   return !(*this == other);
+}
+
+/**Moves to the first row of the walk's current keyword, or of the first keyword after it with a row.
+@pre none
+@post The cursor will be at the first context of a keyword, or past the last row if the walk is past its last keyword. */
+template <int BEFORE, int AFTER>
+void RowCursor<BEFORE, AFTER>::findRow()
+{
+   list = nullptr;
+   if ( walk == nullptr )
+      return;
+   for ( ; !walk->atEnd(); walk->next())
+   {
+      reader = ContextList::Reader(walk->getContextList());
+      if ( reader.next(position) )
+      {
+         list = &walk->getContextList();
+         row.keyWord = walk->getKey();
+         readRow();
+         return;
+      }
+   }
+}
+
+/**Reads the context of the current position into the row.
+@pre The cursor must not be past the last row.
+@post The row will hold the context and the document of the position. */
+template <int BEFORE, int AFTER>
+void RowCursor<BEFORE, AFTER>::readRow()
+{
+   ListNode<BEFORE, AFTER> context(*words, position);
+   row.context = context.getContext();
+   row.document = context.getDocument();
+}
+
+//compile the RowCursor of every window
+#define INSTANTIATE(BEFORE, AFTER) template class RowCursor<BEFORE, AFTER>;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
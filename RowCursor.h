@@ -0,0 +1,138 @@
+/*
+file name: RowCursor.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the RowCursor class. A RowCursor is a forward iterator over the rows of any concordance engine, a context of a keyword at a time, in the order they are printed: alphabetical by keyword, and in corpus order within a keyword. It visits the keywords with the KeyWalk of the engine, which walks the engine's own ordered structure, and reads the positions of each keyword's list with a ContextList::Reader and the context of each position from the word stream. It holds the walk's place in the engine and one row, never the lists of every keyword nor the rows of a whole list, so copying it costs no more than copying the walk: the path down a tree or a trie, or an index into the hash engine's sorted entries. It is a template over the window of the concordance's contexts.
+*/
+
+#ifndef ROWCURSOR_H
+#define ROWCURSOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include "KeyWalk.h"
+#include "ListNode.h"
+#include "WordStream.h"
+
+template <int BEFORE, int AFTER>
+class RowCursor
+{
+public:
+   
+   //a row of the concordance
+   struct Row
+   {
+      string_view keyWord; //the keyword of the row, a view of the engine's keyword or of the walk's copy of it
+      typename ListNode<BEFORE, AFTER>::contextArr context; //the context of the row, as IDs in the concordance's Vocabulary, with the keyword at index BEFORE
+      uint32_t document; //the number of the document the row was read from, 0 for a single corpus
+   };
+   
+   using iterator_category = forward_iterator_tag;
+   using value_type = Row;
+   using difference_type = ptrdiff_t;
+   using pointer = const Row*;
+   using reference = const Row&;
+   
+   /** The default constructor for the RowCursor class.
+   Constructs a cursor past the last row of any concordance. */
+   RowCursor();
+   
+   /** Constructor for the RowCursor class that accepts the walk over the keywords to visit and the word stream their contexts are read from.
+   Moves to the first row of the first keyword with a context.
+   @param walk The walk over the keywords, which the cursor takes over and deletes.
+   @param words The WordStream the positions in the context lists point into.
+   @pre The engine the walk visits and the word stream must not change or be destroyed while the cursor is used. */
+   RowCursor(KeyWalk* walk, const WordStream* words);
+   
+   /**The copy constructor for the RowCursor class.
+   Makes a copy of the cursor at the same row, with a copy of its walk.
+   @param cursor The cursor to be copied. */
+   RowCursor(const RowCursor& cursor);
+   
+   /**The move constructor for the RowCursor class.
+   Takes the walk of the cursor supplied as the argument without copying it.
+   @param cursor The cursor to be moved. It will be past the last row. */
+   RowCursor(RowCursor&& cursor) noexcept;
+   
+   /** Overloaded assignment operator for the RowCursor class.
+   @param rhs The cursor on the right side of the assignment operator.
+   @return The cursor on the left side.
+   @post The cursor on the left side will be at the same row as the one on the right, with a copy of its walk. */
+   RowCursor& operator=(const RowCursor& rhs);
+   
+   /** The destructor for the RowCursor class.
+   Deletes the walk when its lifetime ends. */
+   ~RowCursor();
+   
+   /**Tests whether the cursor is past the last row.
+   @return True if there are no rows left, false otherwise.
+   @pre none
+   @post The cursor is unchanged. */
+   bool atEnd() const;
+   
+   /**Returns the current row.
+   @return The keyword and context of the row.
+   @pre The cursor must not be past the last row.
+   @post The row will be returned as a const reference, valid until the cursor is moved. */
+   const Row& operator*() const;
+   
+   /**Returns the current row.
+   @return A pointer to the keyword and context of the row.
+   @pre The cursor must not be past the last row.
+   @post The row will be returned as a const pointer, valid until the cursor is moved. */
+   const Row* operator->() const;
+   
+   /**Moves to the next row.
+   @return The cursor.
+   @pre The cursor must not be past the last row.
+   @post The cursor will be at the next context of the keyword, or at the first context of the next keyword, or past the last row. */
+   RowCursor& operator++();
+   
+   /**Moves to the next row.
+   @return A copy of the cursor from before it was moved.
+   @pre The cursor must not be past the last row.
+   @post The cursor will be at the next row, or past the last row. */
+   RowCursor operator++(int);
+   
+   /**Moves to the first row of the next keyword, skipping the rest of the rows of the current one.
+   @pre The cursor must not be past the last row.
+   @post The cursor will be at the first context of the next keyword, or past the last row. */
+   void nextKey();
+   
+   /**Returns the context list of the current keyword.
+   @return The context list of the keyword of the current row.
+   @pre The cursor must not be past the last row.
+   @post The context list will be returned as a const reference. */
+   const ContextList& getContextList() const;
+   
+   /**Tests whether two cursors are at the same row.
+   @param other The cursor to compare with.
+   @return True if both are at the same row of the same context list, or both are past the last row. False otherwise. */
+   bool operator==(const RowCursor& other) const;
+   
+   /**Tests whether two cursors are at different rows.
+   @param other The cursor to compare with.
+   @return True if the cursors are not at the same row, false otherwise. */
+   bool operator!=(const RowCursor& other) const;
+   
+private:
+   /**Moves to the first row of the walk's current keyword, or of the first keyword after it with a row.
+   @pre none
+   @post The cursor will be at the first context of a keyword, or past the last row if the walk is past its last keyword. */
+   void findRow();
+   
+   /**Reads the context of the current position into the row.
+   @pre The cursor must not be past the last row.
+   @post The row will hold the context and the document of the position. */
+   void readRow();
+   
+   KeyWalk* walk; //the walk over the keywords, owned by the cursor, or nullptr for a default cursor
+   const WordStream* words; //the word stream the contexts are read from
+   const ContextList* list; //context list of the current row, nullptr past the last row
+   ContextList::Reader reader; //reads the positions of the current list
+   uint64_t position; //position of the current row in the word stream
+   Row row; //the current row
+};
+
+#endif
@@ -0,0 +1,248 @@
+/*
+file name: RunStats.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the RunStats class. A RunStats collects the wall and CPU time of each phase of a run and named counters such as the number of words read, and writes them as a JSON report. The stages of adding a keyword, cleaning it, checking it against the stop words and inserting it, happen once per word and take nanoseconds, so they are not timed on every word: one add in SAMPLE_INTERVAL is timed stage by stage and the totals are estimated from the samples. A concordance with no RunStats attached only checks for it once per word.
+*/
+
+#include "RunStats.h"
+
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+/** The default constructor for the RunStats class.
+Constructs a RunStats with no phases or counters, and measures the cost of reading the clock so it can be taken off the samples. */
+RunStats::RunStats()
+   : phaseCpuStart(0), numAdds(0), addsUntilSample(SAMPLE_INTERVAL), numSamples(0), sampledPhase(-1), clockSeconds(0)
+{
+   for (int s = 0; s < NUM_ADD_STAGES; s++)
+      sampleSeconds[s] = 0;
+
+   //the fastest of many back to back reads is the cost that is in every sampled stage
+   const int READS = 1000;
+   chrono::steady_clock::time_point last = chrono::steady_clock::now();
+   for (int r = 0; r < READS; r++)
+   {
+      chrono::steady_clock::time_point now = chrono::steady_clock::now();
+      double seconds = chrono::duration<double>(now - last).count();
+      if ( r == 0 || seconds < clockSeconds )
+         clockSeconds = seconds;
+      last = now;
+   }
+}
+
+/**Starts timing a phase of the run.
+@param name The name of the phase.
+@pre No other phase is being timed.
+@post The wall and CPU time of the phase will be measured from now until endPhase is called. */
+void RunStats::startPhase(const string& name)
+{
+   phaseName = name;
+   phaseCpuStart = cpuSeconds();
+   phaseStart = chrono::steady_clock::now();
+}
+
+/**Stops timing the current phase.
+@pre A phase is being timed.
+@post The phase will be in the report with its wall time and the CPU time of every thread of the process. */
+void RunStats::endPhase()
+{
+   double wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - phaseStart).count();
+   phases.push_back(Phase{phaseName, wallSeconds, cpuSeconds() - phaseCpuStart});
+   phaseName.clear();
+}
+
+/**Sets a counter of the report.
+@param name The name of the counter.
+@param value The value of the counter.
+@pre none
+@post The counter will be in the report, replacing a counter with the same name. Whole numbers are written without a fraction. */
+void RunStats::setCounter(const string& name, double value)
+{
+   for (size_t c = 0; c < counters.size(); c++)
+   {
+      if ( counters[c].first == name )
+      {
+         counters[c].second = value;
+         return;
+      }
+   }
+   counters.emplace_back(name, value);
+}
+
+/**Sets a text value of the report.
+@param name The name of the value.
+@param value The text.
+@pre none
+@post The value will be in the report, replacing a value with the same name. */
+void RunStats::setLabel(const string& name, const string& value)
+{
+   for (size_t l = 0; l < labels.size(); l++)
+   {
+      if ( labels[l].first == name )
+      {
+         labels[l].second = value;
+         return;
+      }
+   }
+   labels.emplace_back(name, value);
+}
+
+/**Records the times of the stages of a sampled add.
+@param start When the add started.
+@param ends When each stage ended, in the order of AddStage.
+@pre sampleAdd must have returned true for the add.
+@post The time of each stage, less the cost of reading the clock, will be added to its sampled total. */
+void RunStats::addSample(chrono::steady_clock::time_point start, const chrono::steady_clock::time_point ends[NUM_ADD_STAGES])
+{
+   //the samples are scaled up to the phase they were taken in
+   if ( sampledPhase < 0 && !phaseName.empty() )
+      sampledPhase = (int)phases.size();
+
+   chrono::steady_clock::time_point stageStart = start;
+   for (int s = 0; s < NUM_ADD_STAGES; s++)
+   {
+      sampleSeconds[s] += max(0.0, chrono::duration<double>(ends[s] - stageStart).count() - clockSeconds);
+      stageStart = ends[s];
+   }
+   numSamples++;
+}
+
+/**Returns the report as JSON.
+@return A JSON object with the labels, a "phases" object with wall_ms and cpu_ms for each phase, an "ingest_stages_ms" object with the estimated time of each stage of adding a keyword if any adds were sampled, and a "counters" object.
+@pre none
+@post The report will be returned as a string ending in a newline. */
+string RunStats::toJson() const
+{
+   string json = "{\n";
+   for (size_t l = 0; l < labels.size(); l++)
+   {
+      json += "  ";
+      appendString(json, labels[l].first);
+      json += ": ";
+      appendString(json, labels[l].second);
+      json += ",\n";
+   }
+
+   json += "  \"phases\": {";
+   for (size_t p = 0; p < phases.size(); p++)
+   {
+      json += p == 0 ? "\n    " : ",\n    ";
+      appendString(json, phases[p].name);
+      json += ": {\"wall_ms\": ";
+      appendNumber(json, phases[p].wallSeconds * 1e3);
+      json += ", \"cpu_ms\": ";
+      appendNumber(json, phases[p].cpuSeconds * 1e3);
+      json += "}";
+   }
+   json += phases.empty() ? "},\n" : "\n  },\n";
+
+   //the sampled stages scaled up to every add, what is left of the phase is reading and interning the words
+   if ( numSamples > 0 && sampledPhase >= 0 && sampledPhase < (int)phases.size() )
+   {
+      const char* STAGE_NAMES[NUM_ADD_STAGES] = { "normalize", "stop_word_filter", "insert" };
+      double scale = (double)numAdds / (double)numSamples;
+      double addSeconds = 0;
+      json += "  \"ingest_stages_ms\": {\n    \"estimated_from_samples\": ";
+      appendNumber(json, (double)numSamples);
+      for (int s = 0; s < NUM_ADD_STAGES; s++)
+      {
+         json += ",\n    \"";
+         json += STAGE_NAMES[s];
+         json += "\": ";
+         appendNumber(json, sampleSeconds[s] * scale * 1e3);
+         addSeconds += sampleSeconds[s] * scale;
+      }
+      json += ",\n    \"tokenize_and_intern\": ";
+      appendNumber(json, max(0.0, phases[sampledPhase].wallSeconds - addSeconds) * 1e3);
+      json += "\n  },\n";
+   }
+
+   json += "  \"counters\": {";
+   for (size_t c = 0; c < counters.size(); c++)
+   {
+      json += c == 0 ? "\n    " : ",\n    ";
+      appendString(json, counters[c].first);
+      json += ": ";
+      appendNumber(json, counters[c].second);
+   }
+   json += counters.empty() ? "}\n" : "\n  }\n";
+   json += "}\n";
+   return json;
+}
+
+/**Writes the report to a file, or to standard error.
+@param fileName The name of the file, or an empty string for standard error.
+@return True if the report was written, false otherwise.
+@pre none
+@post The report will be in the file, replacing anything in it before. */
+bool RunStats::write(const string& fileName) const
+{
+   string json = toJson();
+   if ( fileName.empty() )
+   {
+      cerr << json << flush;
+      return !cerr.fail();
+   }
+
+   ofstream out(fileName, ios::trunc);
+   out << json;
+   out.close();
+   return !out.fail();
+}
+
+/**Returns the CPU time the process has used.
+@return The CPU time of every thread of the process, in seconds. */
+double RunStats::cpuSeconds()
+{
+   timespec now;
+   if ( clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now) != 0 )
+      return 0;
+   return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+/**Appends a string to JSON text as a quoted JSON string.
+@param json The JSON text.
+@param text The string. */
+void RunStats::appendString(string& json, const string& text)
+{
+   json += '"';
+   for (size_t i = 0; i < text.length(); i++)
+   {
+      unsigned char c = (unsigned char)text[i];
+      if ( c == '"' || c == '\\' )
+      {
+         json += '\\';
+         json += (char)c;
+      }
+      else if ( c < 0x20 )
+      {
+         char escaped[8];
+         snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+         json += escaped;
+      }
+      else
+         json += (char)c;
+   }
+   json += '"';
+}
+
+/**Appends a number to JSON text.
+@param json The JSON text.
+@param value The number, written without a fraction if it is a whole number. */
+void RunStats::appendNumber(string& json, double value)
+{
+   char number[32];
+   if ( !isfinite(value) )
+      snprintf(number, sizeof(number), "null");
+   else if ( value == floor(value) && fabs(value) < 9007199254740992.0 )
+      snprintf(number, sizeof(number), "%.0f", value);
+   else
+      snprintf(number, sizeof(number), "%.3f", value);
+   json += number;
+}
@@ -0,0 +1,133 @@
+/*
+file name: RunStats.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the RunStats class. A RunStats collects the wall and CPU time of each phase of a run and named counters such as the number of words read, and writes them as a JSON report. The stages of adding a keyword, cleaning it, checking it against the stop words and inserting it, happen once per word and take nanoseconds, so they are not timed on every word: one add in SAMPLE_INTERVAL is timed stage by stage and the totals are estimated from the samples. A concordance with no RunStats attached only checks for it once per word.
+*/
+
+#ifndef RUNSTATS_H
+#define RUNSTATS_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+class RunStats
+{
+public:
+
+   static constexpr uint32_t SAMPLE_INTERVAL = 64; //one add in this many is timed stage by stage
+
+   //the stages of adding a keyword to a concordance
+   enum AddStage
+   {
+      NORMALIZE, //stripping punctuation and lowercasing
+      STOP_WORD_FILTER, //checking the stop words
+      INSERT, //finding or inserting the keyword and adding the context
+      NUM_ADD_STAGES
+   };
+
+   /** The default constructor for the RunStats class.
+   Constructs a RunStats with no phases or counters, and measures the cost of reading the clock so it can be taken off the samples. */
+   RunStats();
+
+   /**Starts timing a phase of the run.
+   @param name The name of the phase.
+   @pre No other phase is being timed.
+   @post The wall and CPU time of the phase will be measured from now until endPhase is called. */
+   void startPhase(const string& name);
+
+   /**Stops timing the current phase.
+   @pre A phase is being timed.
+   @post The phase will be in the report with its wall time and the CPU time of every thread of the process. */
+   void endPhase();
+
+   /**Sets a counter of the report.
+   @param name The name of the counter.
+   @param value The value of the counter.
+   @pre none
+   @post The counter will be in the report, replacing a counter with the same name. Whole numbers are written without a fraction. */
+   void setCounter(const string& name, double value);
+
+   /**Sets a text value of the report.
+   @param name The name of the value.
+   @param value The text.
+   @pre none
+   @post The value will be in the report, replacing a value with the same name. */
+   void setLabel(const string& name, const string& value);
+
+   /**Counts an add and tells whether it should be timed stage by stage.
+   @return True for one add in SAMPLE_INTERVAL, false otherwise.
+   @pre none
+   @post The add will be counted. */
+   bool sampleAdd()
+   {
+      numAdds++;
+      if ( --addsUntilSample != 0 )
+         return false;
+      addsUntilSample = SAMPLE_INTERVAL;
+      return true;
+   }
+
+   /**Records the times of the stages of a sampled add.
+   @param start When the add started.
+   @param ends When each stage ended, in the order of AddStage.
+   @pre sampleAdd must have returned true for the add.
+   @post The time of each stage, less the cost of reading the clock, will be added to its sampled total. */
+   void addSample(chrono::steady_clock::time_point start, const chrono::steady_clock::time_point ends[NUM_ADD_STAGES]);
+
+   /**Returns the report as JSON.
+   @return A JSON object with the labels, a "phases" object with wall_ms and cpu_ms for each phase, an "ingest_stages_ms" object with the estimated time of each stage of adding a keyword if any adds were sampled, and a "counters" object.
+   @pre none
+   @post The report will be returned as a string ending in a newline. */
+   string toJson() const;
+
+   /**Writes the report to a file, or to standard error.
+   @param fileName The name of the file, or an empty string for standard error.
+   @return True if the report was written, false otherwise.
+   @pre none
+   @post The report will be in the file, replacing anything in it before. */
+   bool write(const string& fileName) const;
+
+private:
+
+   //a phase of the run that has been timed
+   struct Phase
+   {
+      string name; //name of the phase
+      double wallSeconds; //time that passed during the phase
+      double cpuSeconds; //CPU time every thread of the process used during the phase
+   };
+
+   /**Returns the CPU time the process has used.
+   @return The CPU time of every thread of the process, in seconds. */
+   double static cpuSeconds();
+
+   /**Appends a string to JSON text as a quoted JSON string.
+   @param json The JSON text.
+   @param text The string. */
+   void static appendString(string& json, const string& text);
+
+   /**Appends a number to JSON text.
+   @param json The JSON text.
+   @param value The number, written without a fraction if it is a whole number. */
+   void static appendNumber(string& json, double value);
+
+   vector<Phase> phases; //the phases timed so far, in order
+   vector<pair<string, double>> counters; //the counters, in the order they were first set
+   vector<pair<string, string>> labels; //the text values, in the order they were first set
+   string phaseName; //name of the phase being timed
+   chrono::steady_clock::time_point phaseStart; //when the phase being timed started
+   double phaseCpuStart; //CPU time used when the phase being timed started
+   uint64_t numAdds; //adds counted by sampleAdd
+   uint32_t addsUntilSample; //adds left until the next sampled one
+   uint64_t numSamples; //adds timed stage by stage
+   int sampledPhase; //index in phases of the phase the samples were taken in, or -1
+   double sampleSeconds[NUM_ADD_STAGES]; //time of each stage over the sampled adds
+   double clockSeconds; //cost of reading the clock once
+};
+
+#endif
@@ -0,0 +1,370 @@
+/*
+file name: SpillConcordance.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the SpillConcordance class. The SpillConcordance class is a HashConcordance that keeps its memory within a fixed budget. Once the hash table and its contexts grow past the budget, the keywords are sorted and written with their contexts, in corpus order, to a run file in a temporary directory, and the table is emptied for the next part of the corpus. The concordance is printed by merging the run files and the last part still in memory, a keyword at a time, so the output is the same as the in-memory engines produce. The table holds the positions of the contexts in the word stream, so the contexts are read back from the stream into the run file, and the words before the next keyword's context are then discarded from the stream. It is a template over the window of its contexts, so the records of the run files are as long as the contexts of the window.
+*/
+
+#include "SpillConcordance.h"
+#include <queue>
+#include <cstdlib>
+#include <cmath>
+#include <unistd.h>
+#include "OutputWriter.h"
+
+using namespace std;
+
+/** Constructor for the SpillConcordance class that accepts the memory budget and the directory to spill to.
+Constructs an empty SpillConcordance object with no run files.
+@param memoryLimit The number of bytes the hash table, its contexts, and the word stream may use before they are spilled.
+@param spillDirectory The directory the run files are created in.
+@pre memoryLimit must be at least MIN_MEMORY_LIMIT. The directory must exist and be writable. */
+template <int BEFORE, int AFTER>
+SpillConcordance<BEFORE, AFTER>::SpillConcordance(size_t memoryLimit, const string& spillDirectory)
+   : HashConcordance<BEFORE, AFTER>(), memoryLimit(memoryLimit), spillDirectory(spillDirectory), numSpills(0)
+{
+}
+
+/** The destructor for the SpillConcordance class.
+Destroys the SpillConcordance object, closing its run files, which are deleted by the system as they are closed.*/
+template <int BEFORE, int AFTER>
+SpillConcordance<BEFORE, AFTER>::~SpillConcordance()
+{
+   for (size_t r = 0; r < runs.size(); r++)
+      fclose(runs[r].file);
+}
+
+/** Tests whether the concordance is empty.
+@return True if no keywords have been added, false otherwise.
+@pre none
+@post Returns true if there are no keywords in memory or in the run files, false otherwise.*/
+template <int BEFORE, int AFTER>
+bool SpillConcordance<BEFORE, AFTER>::isEmpty() const
+{
+   return runs.empty() && HashConcordance<BEFORE, AFTER>::isEmpty();
+}
+
+/** Returns the directory run files are created in when none is given.
+@return The directory named by the TMPDIR environment variable, or /tmp if it is not set.
+@pre none
+@post The directory will be returned as a string. */
+template <int BEFORE, int AFTER>
+string SpillConcordance<BEFORE, AFTER>::defaultSpillDirectory()
+{
+   const char* tmpDir = getenv("TMPDIR");
+   if ( tmpDir != nullptr && *tmpDir != '\0' )
+      return tmpDir;
+   return "/tmp";
+}
+
+/**Adds the counters of the concordance to a report.
+@param runStats The RunStats the counters are set in.
+@pre none
+@post The report will hold the counters of a HashConcordance, the number of times the table was spilled, and the number of runs left after merging. Once something was spilled the number of keywords is not known until the runs are merged, so it is null. */
+template <int BEFORE, int AFTER>
+void SpillConcordance<BEFORE, AFTER>::collectStats(RunStats& runStats) const
+{
+   //the keywords in the runs are only counted when they are merged for printing
+   HashConcordance<BEFORE, AFTER>::collectStats(runStats);
+   if ( !runs.empty() )
+      runStats.setCounter("distinct_keys", NAN);
+   runStats.setCounter("spills", (double)numSpills);
+   runStats.setCounter("spill_runs", (double)runs.size());
+}
+
+/**Finds the context list of a keyword, first spilling the hash table to a run file if it has grown past the memory budget.
+@param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+@return The keyword's context list.
+@pre The keyword must not be a stop word.
+@post The keyword will be in the table. */
+template <int BEFORE, int AFTER>
+ContextList& SpillConcordance<BEFORE, AFTER>::findOrInsert(const string& keyWord)
+{
+   //the lists of the table are only ever extended from here, so it is safe to empty it
+   if ( tableBytes() > memoryLimit && !HashConcordance<BEFORE, AFTER>::isEmpty() )
+      spill();
+   return HashConcordance<BEFORE, AFTER>::findOrInsert(keyWord);
+}
+
+/** Writes the rows of every keyword in alphabetical order, merging the run files with the keywords still in memory.
+@param writer The OutputWriter to write the rows to, with its columns set.
+@param threads The number of threads to format the rows on, used only if nothing was spilled.
+@pre threads must be at least 1.
+@post The rows of every keyword will be written in alphabetical order, and in corpus order within a keyword. */
+template <int BEFORE, int AFTER>
+void SpillConcordance<BEFORE, AFTER>::writeRows(OutputWriter& writer, int threads) const
+{
+   //nothing was spilled, the whole concordance is in memory
+   if ( runs.empty() )
+   {
+      HashConcordance<BEFORE, AFTER>::writeRows(writer, threads);
+      return;
+   }
+
+   //the keywords in memory come last in the corpus, so they are merged after every run
+   vector<const Entry*> batch;
+   sortedEntries(batch);
+   mergeRuns(0, &batch,
+             [](const string&, uint64_t) {},
+             [&](const typename ListNode<BEFORE, AFTER>::contextArr& context, uint32_t document) { writer.writeRow<BEFORE, AFTER>(context, vocabulary, document); });
+}
+
+/** Writes the rows of the keywords a query matches in alphabetical order, merging the run files with the keywords still in memory.
+@param writer The OutputWriter to write the rows to, with its columns set.
+@param query The keywords to write.
+@pre none
+@post The rows of every matching keyword will be written in alphabetical order, and in corpus order within a keyword. Once something was spilled, every run file is read, since the runs have no directory of their keywords. */
+template <int BEFORE, int AFTER>
+void SpillConcordance<BEFORE, AFTER>::writeMatchingRows(OutputWriter& writer, const KeyQuery& query) const
+{
+   if ( runs.empty() )
+   {
+      HashConcordance<BEFORE, AFTER>::writeMatchingRows(writer, query);
+      return;
+   }
+   
+   vector<const Entry*> batch;
+   sortedEntries(batch);
+   bool matching = false;
+   mergeRuns(0, &batch,
+             [&](const string& keyWord, uint64_t) { matching = query.matches(keyWord); },
+             [&](const typename ListNode<BEFORE, AFTER>::contextArr& context, uint32_t document)
+             {
+                if ( matching )
+                   writer.writeRow<BEFORE, AFTER>(context, vocabulary, document);
+             });
+}
+
+/**Writes the hash table to a new run file and empties it.
+@pre The table must not be empty. The keyword at keyPosition is being added.
+@post The keywords and contexts will be in the last run file, and the table will be empty. The word stream will only hold the words from the context of the keyword at keyPosition on. If MERGE_FAN_IN runs of the same level end the list of runs, they will be merged into one. */
+template <int BEFORE, int AFTER>
+void SpillConcordance<BEFORE, AFTER>::spill()
+{
+   vector<const Entry*> sorted;
+   sortedEntries(sorted);
+
+   //write a record for each keyword, its contexts are already in corpus order
+   FILE* file = createRunFile();
+   for (size_t e = 0; e < sorted.size(); e++)
+   {
+      uint32_t keyLen = (uint32_t)sorted[e]->keyWord.length();
+      uint64_t count = sorted[e]->contextList.size();
+      writeBytes(file, &keyLen, sizeof(keyLen));
+      writeBytes(file, sorted[e]->keyWord.data(), keyLen);
+      writeBytes(file, &count, sizeof(count));
+      ContextList::Reader reader(sorted[e]->contextList);
+      uint64_t position;
+      while ( reader.next(position) )
+      {
+         ListNode<BEFORE, AFTER> context(words, position);
+         uint32_t document = context.getDocument();
+         writeBytes(file, context.getContext().data(), sizeof(typename ListNode<BEFORE, AFTER>::contextArr));
+         writeBytes(file, &document, sizeof(document));
+      }
+   }
+   runs.push_back(Run{file, 0});
+   numSpills++;
+   clearTable();
+   
+   //the keywords from the one being added on are all that is left to add, so only their contexts are still needed
+   words.discardBefore(keyPosition - BEFORE);
+
+   //merge the newest runs once there are enough of the same level, like carrying in a counter,
+   //so each context is copied only a logarithmic number of times and few files stay open
+   while ( runs.size() >= MERGE_FAN_IN
+          && runs[runs.size() - MERGE_FAN_IN].level == runs.back().level )
+   {
+      size_t firstRun = runs.size() - MERGE_FAN_IN;
+      FILE* merged = createRunFile();
+      mergeRuns(firstRun, nullptr,
+                [&](const string& keyWord, uint64_t count)
+                {
+                   uint32_t keyLen = (uint32_t)keyWord.length();
+                   writeBytes(merged, &keyLen, sizeof(keyLen));
+                   writeBytes(merged, keyWord.data(), keyLen);
+                   writeBytes(merged, &count, sizeof(count));
+                },
+                [&](const typename ListNode<BEFORE, AFTER>::contextArr& context, uint32_t document)
+                {
+                   writeBytes(merged, context.data(), sizeof(typename ListNode<BEFORE, AFTER>::contextArr));
+                   writeBytes(merged, &document, sizeof(document));
+                });
+
+      int level = runs.back().level + 1;
+      for (size_t r = firstRun; r < runs.size(); r++)
+         fclose(runs[r].file);
+      runs.resize(firstRun);
+      runs.push_back(Run{merged, level});
+   }
+}
+
+/**Merges runs, and optionally the keywords in memory, a keyword at a time.
+@param firstRun The index of the first run merged, every run after it is merged too.
+@param batch The entries in memory in alphabetical order, merged after every run, or nullptr for none.
+@param onKey Called with each keyword and its total number of contexts before its contexts.
+@param onContext Called with each context of the keyword and its document number, in corpus order.
+@pre The runs must be in corpus order.
+@post Every record of the runs will have been read. */
+template <int BEFORE, int AFTER>
+template <class KeyFn, class ContextFn>
+void SpillConcordance<BEFORE, AFTER>::mergeRuns(size_t firstRun, const vector<const Entry*>* batch, KeyFn onKey, ContextFn onContext) const
+{
+   //source s is run firstRun + s, the batch is the source after the last run
+   size_t numRuns = runs.size() - firstRun;
+   vector<uint64_t> counts(numRuns + 1, 0);
+   size_t nextEntry = 0;
+
+   for (size_t s = 0; s < numRuns; s++)
+   {
+      if ( fflush(runs[firstRun + s].file) != 0 )
+      {
+         cerr << "Could not write spill file." << endl;
+         exit( EXIT_FAILURE );
+      }
+      rewind(runs[firstRun + s].file);
+   }
+
+   //the next keyword of each source, smallest first, ties go to the earlier source
+   typedef pair<string, size_t> Head;
+   priority_queue<Head, vector<Head>, greater<Head>> heads;
+
+   //reads the next keyword of a source and queues it, unless the source is used up
+   auto advance = [&](size_t s)
+   {
+      if ( s < numRuns )
+      {
+         FILE* file = runs[firstRun + s].file;
+         uint32_t keyLen;
+         if ( !readBytes(file, &keyLen, sizeof(keyLen)) )
+            return;
+         string keyWord(keyLen, '\0');
+         if ( !readBytes(file, &keyWord[0], keyLen) || !readBytes(file, &counts[s], sizeof(uint64_t)) )
+         {
+            cerr << "Spill file is truncated." << endl;
+            exit( EXIT_FAILURE );
+         }
+         heads.emplace(move(keyWord), s);
+      }
+      else if ( batch != nullptr && nextEntry < batch->size() )
+      {
+         counts[s] = (*batch)[nextEntry]->contextList.size();
+         heads.emplace((*batch)[nextEntry]->keyWord, s);
+         nextEntry++;
+      }
+   };
+
+   for (size_t s = 0; s <= numRuns; s++)
+      advance(s);
+
+   vector<size_t> group;
+   typename ListNode<BEFORE, AFTER>::contextArr context;
+   uint32_t document;
+   while ( !heads.empty() )
+   {
+      //take every source whose next keyword is the smallest, in corpus order
+      string keyWord = heads.top().first;
+      uint64_t total = 0;
+      group.clear();
+      while ( !heads.empty() && heads.top().first == keyWord )
+      {
+         group.push_back(heads.top().second);
+         total += counts[heads.top().second];
+         heads.pop();
+      }
+
+      onKey(keyWord, total);
+      for (size_t g = 0; g < group.size(); g++)
+      {
+         size_t s = group[g];
+         if ( s < numRuns )
+         {
+            for (uint64_t c = 0; c < counts[s]; c++)
+            {
+               if ( !readBytes(runs[firstRun + s].file, context.data(), sizeof(context))
+                   || !readBytes(runs[firstRun + s].file, &document, sizeof(document)) )
+               {
+                  cerr << "Spill file is truncated." << endl;
+                  exit( EXIT_FAILURE );
+               }
+               onContext(context, document);
+            }
+         }
+         else
+         {
+            //the batch entry was taken when it was queued
+            ContextList::Reader reader((*batch)[nextEntry - 1]->contextList);
+            uint64_t position;
+            while ( reader.next(position) )
+            {
+               ListNode<BEFORE, AFTER> fromStream(words, position);
+               onContext(fromStream.getContext(), fromStream.getDocument());
+            }
+         }
+         advance(s);
+      }
+   }
+}
+
+/**Creates an empty run file in the spill directory.
+@return The file, opened for reading and writing.
+@pre none
+@post The file will already be unlinked, so it is deleted when it is closed. The program exits if it cannot be created. */
+template <int BEFORE, int AFTER>
+FILE* SpillConcordance<BEFORE, AFTER>::createRunFile() const
+{
+   string path = spillDirectory + "/concordance-XXXXXX";
+   int fd = mkstemp(&path[0]);
+   FILE* file = fd < 0 ? nullptr : fdopen(fd, "w+b");
+   if ( file == nullptr )
+   {
+      cerr << "Could not create a spill file in " << spillDirectory << "." << endl;
+      exit( EXIT_FAILURE );
+   }
+
+   //the file stays reachable through its descriptor only
+   unlink(path.c_str());
+   setvbuf(file, nullptr, _IOFBF, RUN_BUFFER_BYTES);
+   return file;
+}
+
+/**Writes bytes to a run file.
+@param file The run file.
+@param data The bytes to write.
+@param bytes The number of bytes.
+@pre none
+@post The bytes will be written. The program exits if they cannot be. */
+template <int BEFORE, int AFTER>
+void SpillConcordance<BEFORE, AFTER>::writeBytes(FILE* file, const void* data, size_t bytes)
+{
+   if ( fwrite(data, 1, bytes, file) != bytes )
+   {
+      cerr << "Could not write spill file." << endl;
+      exit( EXIT_FAILURE );
+   }
+}
+
+/**Reads bytes from a run file.
+@param file The run file.
+@param data The memory to read into.
+@param bytes The number of bytes.
+@return True if the bytes were read, false if the end of the file was reached first.
+@pre none
+@post The program exits if the file cannot be read. */
+template <int BEFORE, int AFTER>
+bool SpillConcordance<BEFORE, AFTER>::readBytes(FILE* file, void* data, size_t bytes)
+{
+   if ( fread(data, 1, bytes, file) == bytes )
+      return true;
+   if ( ferror(file) )
+   {
+      cerr << "Could not read spill file." << endl;
+      exit( EXIT_FAILURE );
+   }
+   return false;
+}
+
+//compile the SpillConcordance of every window
+#define INSTANTIATE(BEFORE, AFTER) template class SpillConcordance<BEFORE, AFTER>;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
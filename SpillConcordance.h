@@ -0,0 +1,140 @@
+/*
+file name: SpillConcordance.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the SpillConcordance class. The SpillConcordance class is a HashConcordance that keeps its memory within a fixed budget. Once the hash table and its contexts grow past the budget, the keywords are sorted and written with their contexts, in corpus order, to a run file in a temporary directory, and the table is emptied for the next part of the corpus. The concordance is printed by merging the run files and the last part still in memory, a keyword at a time, so the output is the same as the in-memory engines produce. The table holds the positions of the contexts in the word stream, so the contexts are read back from the stream into the run file, and the words before the next keyword's context are then discarded from the stream. It is a template over the window of its contexts, so the records of the run files are as long as the contexts of the window.
+*/
+
+#ifndef SPILLCONCORDANCE_H
+#define SPILLCONCORDANCE_H
+
+#include <cstdio>
+#include <cstdint>
+#include "HashConcordance.h"
+
+template <int BEFORE, int AFTER>
+class SpillConcordance : public HashConcordance<BEFORE, AFTER>
+{
+
+public:
+
+   static constexpr size_t MIN_MEMORY_LIMIT = 1 << 20; //smallest memory budget allowed
+   static constexpr size_t RUN_BUFFER_BYTES = 1 << 18; //size of the stdio buffer of each run file
+   static constexpr size_t MERGE_FAN_IN = 16; //number of runs of the same level merged into one run of the next level
+
+   /** Constructor for the SpillConcordance class that accepts the memory budget and the directory to spill to.
+   Constructs an empty SpillConcordance object with no run files.
+   @param memoryLimit The number of bytes the hash table, its contexts, and the word stream may use before they are spilled.
+   @param spillDirectory The directory the run files are created in.
+   @pre memoryLimit must be at least MIN_MEMORY_LIMIT. The directory must exist and be writable. */
+   SpillConcordance(size_t memoryLimit, const string& spillDirectory);
+
+   /** The destructor for the SpillConcordance class.
+   Destroys the SpillConcordance object, closing its run files, which are deleted by the system as they are closed.*/
+   virtual ~SpillConcordance();
+
+   /** Tests whether the concordance is empty.
+   @return True if no keywords have been added, false otherwise.
+   @pre none
+   @post Returns true if there are no keywords in memory or in the run files, false otherwise.*/
+   bool isEmpty() const override;
+
+   /** Returns the directory run files are created in when none is given.
+   @return The directory named by the TMPDIR environment variable, or /tmp if it is not set.
+   @pre none
+   @post The directory will be returned as a string. */
+   string static defaultSpillDirectory();
+   
+   /**Adds the counters of the concordance to a report.
+   @param runStats The RunStats the counters are set in.
+   @pre none
+   @post The report will hold the counters of a HashConcordance, the number of times the table was spilled, and the number of runs left after merging. Once something was spilled the number of keywords is not known until the runs are merged, so it is null. */
+   void collectStats(RunStats& runStats) const override;
+
+protected:
+   /**Finds the context list of a keyword, first spilling the hash table to a run file if it has grown past the memory budget.
+   @param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+   @return The keyword's context list.
+   @pre The keyword must not be a stop word.
+   @post The keyword will be in the table. */
+   ContextList& findOrInsert(const string& keyWord) override;
+
+   /** Writes the rows of every keyword in alphabetical order, merging the run files with the keywords still in memory.
+   @param writer The OutputWriter to write the rows to, with its columns set.
+   @param threads The number of threads to format the rows on, used only if nothing was spilled.
+   @pre threads must be at least 1.
+   @post The rows of every keyword will be written in alphabetical order, and in corpus order within a keyword. */
+   void writeRows(OutputWriter& writer, int threads) const override;
+   
+   /** Writes the rows of the keywords a query matches in alphabetical order, merging the run files with the keywords still in memory.
+   @param writer The OutputWriter to write the rows to, with its columns set.
+   @param query The keywords to write.
+   @pre none
+   @post The rows of every matching keyword will be written in alphabetical order, and in corpus order within a keyword. Once something was spilled, every run file is read, since the runs have no directory of their keywords. */
+   void writeMatchingRows(OutputWriter& writer, const KeyQuery& query) const override;
+
+private:
+   using typename HashConcordance<BEFORE, AFTER>::Entry;
+   using HashConcordance<BEFORE, AFTER>::vocabulary;
+   using HashConcordance<BEFORE, AFTER>::words;
+   using HashConcordance<BEFORE, AFTER>::keyPosition;
+   using HashConcordance<BEFORE, AFTER>::sortedEntries;
+   using HashConcordance<BEFORE, AFTER>::clearTable;
+   using HashConcordance<BEFORE, AFTER>::tableBytes;
+
+   //a temporary file holding a sorted part of the concordance, one record per keyword: the keyword's length, the keyword, the number of contexts, and the contexts, each followed by its document number
+   struct Run
+   {
+      FILE* file; //the file, already unlinked from the directory
+      int level; //0 for a spilled table, one more than the runs it was merged from otherwise
+   };
+
+   //a spill concordance owns its run files, so it cannot be copied
+   SpillConcordance(const SpillConcordance&);
+   SpillConcordance& operator=(const SpillConcordance&);
+
+   /**Writes the hash table to a new run file and empties it.
+   @pre The table must not be empty. The keyword at keyPosition is being added.
+   @post The keywords and contexts will be in the last run file, and the table will be empty. The word stream will only hold the words from the context of the keyword at keyPosition on. If MERGE_FAN_IN runs of the same level end the list of runs, they will be merged into one. */
+   void spill();
+
+   /**Merges runs, and optionally the keywords in memory, a keyword at a time.
+   @param firstRun The index of the first run merged, every run after it is merged too.
+   @param batch The entries in memory in alphabetical order, merged after every run, or nullptr for none.
+   @param onKey Called with each keyword and its total number of contexts before its contexts.
+   @param onContext Called with each context of the keyword and its document number, in corpus order.
+   @pre The runs must be in corpus order.
+   @post Every record of the runs will have been read. */
+   template <class KeyFn, class ContextFn>
+   void mergeRuns(size_t firstRun, const vector<const Entry*>* batch, KeyFn onKey, ContextFn onContext) const;
+
+   /**Creates an empty run file in the spill directory.
+   @return The file, opened for reading and writing.
+   @pre none
+   @post The file will already be unlinked, so it is deleted when it is closed. The program exits if it cannot be created. */
+   FILE* createRunFile() const;
+
+   /**Writes bytes to a run file.
+   @param file The run file.
+   @param data The bytes to write.
+   @param bytes The number of bytes.
+   @pre none
+   @post The bytes will be written. The program exits if they cannot be. */
+   void static writeBytes(FILE* file, const void* data, size_t bytes);
+
+   /**Reads bytes from a run file.
+   @param file The run file.
+   @param data The memory to read into.
+   @param bytes The number of bytes.
+   @return True if the bytes were read, false if the end of the file was reached first.
+   @pre none
+   @post The program exits if the file cannot be read. */
+   bool static readBytes(FILE* file, void* data, size_t bytes);
+
+   size_t memoryLimit; //bytes the table and its contexts may use before being spilled
+   string spillDirectory; //directory the run files are created in
+   vector<Run> runs; //the run files in corpus order
+   uint64_t numSpills; //number of times the table was spilled
+};
+
+#endif
@@ -0,0 +1,266 @@
+/*
+file name: StopWordSet.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the StopWordSet class. A StopWordSet holds the stop words excluded from the concordance in an open-addressing hash table, so checking a keyword costs one hash and usually a single probe, however long the stop word list is. Large sets are also given a Bloom filter that rejects most keywords that are not stop words without touching the table. The set can instead use a built-in list of common English stop words whose hash table is generated at compile time, so no file has to be read.
+*/
+
+#include "StopWordSet.h"
+
+//the built-in stop words, already stripped of punctuation and lowercase
+static constexpr string_view BUILT_IN_WORDS[] =
+{
+   "a", "about", "above", "after", "again", "against", "all", "am", "an", "and",
+   "any", "are", "as", "at", "be", "because", "been", "before", "being", "below",
+   "between", "both", "but", "by", "can", "cant", "could", "did", "didnt", "do",
+   "does", "doesnt", "doing", "dont", "down", "during", "each", "few", "for", "from",
+   "further", "had", "has", "have", "having", "he", "her", "here", "hers", "herself",
+   "him", "himself", "his", "how", "i", "if", "in", "into", "is", "isnt",
+   "it", "its", "itself", "just", "me", "more", "most", "my", "myself", "no",
+   "nor", "not", "now", "of", "off", "on", "once", "only", "or", "other",
+   "our", "ours", "ourselves", "out", "over", "own", "same", "she", "should", "so",
+   "some", "such", "than", "that", "the", "their", "theirs", "them", "themselves", "then",
+   "there", "these", "they", "this", "those", "through", "to", "too", "under", "until",
+   "up", "very", "was", "wasnt", "we", "were", "what", "when", "where", "which",
+   "while", "who", "whom", "why", "will", "with", "would", "you", "your", "yours",
+   "yourself", "yourselves"
+};
+
+static constexpr size_t NUM_BUILT_IN_WORDS = sizeof(BUILT_IN_WORDS) / sizeof(BUILT_IN_WORDS[0]);
+static constexpr size_t BUILT_IN_SLOTS = 512; //power of 2, keeps the built-in table under half full
+
+static_assert(NUM_BUILT_IN_WORDS * 2 <= BUILT_IN_SLOTS, "built-in stop word table is too full");
+
+//open-addressing table for the built-in words, each slot is a word index plus 1, or 0 if empty
+struct BuiltInTable
+{
+   uint16_t slots[BUILT_IN_SLOTS];
+};
+
+/**Builds the hash table for the built-in stop words at compile time.
+@return The filled in table. */
+static constexpr BuiltInTable makeBuiltInTable()
+{
+   BuiltInTable table = {};
+   for (size_t w = 0; w < NUM_BUILT_IN_WORDS; w++)
+   {
+      size_t i = StopWordSet::hashWord(BUILT_IN_WORDS[w]) & (BUILT_IN_SLOTS - 1);
+      while ( table.slots[i] != 0 )
+         i = (i + 1) & (BUILT_IN_SLOTS - 1);
+      table.slots[i] = (uint16_t)(w + 1);
+   }
+   return table;
+}
+
+static constexpr BuiltInTable BUILT_IN_TABLE = makeBuiltInTable();
+
+/** The default constructor for the StopWordSet class.
+Constructs an empty StopWordSet. */
+StopWordSet::StopWordSet() : builtIn(false), bloomSetting(-1)
+{
+}
+
+/**Adds a stop word to the set.
+@param word The stop word, already stripped of punctuation and lowercase.
+@return True if the word was added, false if it was already in the set.
+@pre word must be of type string_view.
+@post The word will be in the set. If the set was using the built-in list, the built-in words are copied into the set first. */
+bool StopWordSet::insert(string_view word)
+{
+   //words are being added to the built-in list, so it needs its own copy
+   if ( builtIn )
+   {
+      builtIn = false;
+      for (size_t w = 0; w < NUM_BUILT_IN_WORDS; w++)
+         words.emplace_back(BUILT_IN_WORDS[w]);
+      rebuild();
+   }
+   
+   if ( contains(word) )
+      return false;
+   
+   words.emplace_back(word);
+   
+   //grow the table once it is half full, or add the filter once the set is large enough
+   bool wantBloom = bloomSetting == 1 || (bloomSetting == -1 && (int)words.size() > BLOOM_THRESHOLD);
+   if ( words.size() * 2 > slots.size() || wantBloom != !bloom.empty() )
+      rebuild();
+   else
+   {
+      uint64_t hash = hashWord(word);
+      size_t mask = slots.size() - 1;
+      size_t i = hash & mask;
+      while ( slots[i] != 0 )
+         i = (i + 1) & mask;
+      slots[i] = (uint32_t)words.size();
+      
+      if ( !bloom.empty() )
+      {
+         size_t first, second;
+         bloomBits(hash, first, second);
+         bloom[first >> 6] |= 1ULL << (first & 63);
+         bloom[second >> 6] |= 1ULL << (second & 63);
+      }
+   }
+   return true;
+}
+
+/**Checks if a word is in the set.
+@param word The word to be checked, stripped of punctuation and lowercase.
+@return True if the word is a stop word, false otherwise.
+@pre word must be of type string_view.
+@post True will be returned if the word is in the set, otherwise false will be returned. */
+bool StopWordSet::contains(string_view word) const
+{
+   uint64_t hash = hashWord(word);
+   
+   //built-in list, probe the table generated at compile time
+   if ( builtIn )
+   {
+      for (size_t i = hash & (BUILT_IN_SLOTS - 1); BUILT_IN_TABLE.slots[i] != 0; i = (i + 1) & (BUILT_IN_SLOTS - 1))
+      {
+         if ( BUILT_IN_WORDS[BUILT_IN_TABLE.slots[i] - 1] == word )
+            return true;
+      }
+      return false;
+   }
+   
+   //the set is empty
+   if ( slots.empty() )
+      return false;
+   
+   //a word missing either Bloom bit is certainly not in the set
+   if ( !bloom.empty() )
+   {
+      size_t first, second;
+      bloomBits(hash, first, second);
+      if ( !((bloom[first >> 6] >> (first & 63)) & (bloom[second >> 6] >> (second & 63)) & 1) )
+         return false;
+   }
+   
+   //probe linearly until the word or an empty slot is found
+   size_t mask = slots.size() - 1;
+   for (size_t i = hash & mask; slots[i] != 0; i = (i + 1) & mask)
+   {
+      if ( words[slots[i] - 1] == word )
+         return true;
+   }
+   return false;
+}
+
+/**Replaces the contents of the set with the built-in list of stop words.
+@pre none
+@post The set will contain the built-in stop words. Their hash table was built at compile time, so nothing is allocated. */
+void StopWordSet::useBuiltInList()
+{
+   clear();
+   builtIn = true;
+}
+
+/**Turns the Bloom filter in front of the hash table on or off.
+@param enabled True to check the Bloom filter before the table.
+@pre none
+@post contains will consult the Bloom filter first if enabled is true. By default the filter is enabled once the set holds more than BLOOM_THRESHOLD words. */
+void StopWordSet::setBloomFilter(bool enabled)
+{
+   bloomSetting = enabled ? 1 : 0;
+   if ( !words.empty() )
+      rebuild();
+}
+
+/**Empties the set.
+@pre none
+@post The set will contain no words. */
+void StopWordSet::clear()
+{
+   words.clear();
+   slots.clear();
+   bloom.clear();
+   builtIn = false;
+}
+
+/**Returns the number of stop words in the set.
+@return The number of stop words.
+@pre none
+@post The number of stop words will be returned as an int. */
+int StopWordSet::size() const
+{
+   return builtIn ? (int)NUM_BUILT_IN_WORDS : (int)words.size();
+}
+
+/**Returns a stop word of the set.
+@param index The position of the word in the set, in the order the words were added, or of the built-in list.
+@return The stop word.
+@pre index must be less than size().
+@post The word will be returned as a string_view. */
+string_view StopWordSet::getWord(size_t index) const
+{
+   return builtIn ? BUILT_IN_WORDS[index] : string_view(words[index]);
+}
+
+/**Returns the number of words in the built-in list.
+@return The number of built-in stop words.
+@pre none
+@post The number of built-in stop words will be returned as a size_t. */
+size_t StopWordSet::getNumBuiltInWords()
+{
+   return NUM_BUILT_IN_WORDS;
+}
+
+/**Returns a word of the built-in list.
+@param index The position of the word in the list.
+@return The built-in stop word.
+@pre index must be less than getNumBuiltInWords().
+@post The word will be returned as a string_view. */
+string_view StopWordSet::getBuiltInWord(size_t index)
+{
+   return BUILT_IN_WORDS[index];
+}
+
+/**Rebuilds the hash table, and the Bloom filter if it is enabled, from the words in the set.
+@pre none
+@post Every word can be found by probing from its hash. The table is at most half full. */
+void StopWordSet::rebuild()
+{
+   //smallest power of 2 that keeps the table at most half full
+   size_t numSlots = 16;
+   while ( numSlots < words.size() * 2 )
+      numSlots *= 2;
+   slots.assign(numSlots, 0);
+   
+   //about 16 bits per word keeps false positives with 2 bits per word under 2%
+   bool wantBloom = bloomSetting == 1 || (bloomSetting == -1 && (int)words.size() > BLOOM_THRESHOLD);
+   bloom.clear();
+   if ( wantBloom )
+      bloom.assign(numSlots * 8 / 64, 0);
+   
+   for (size_t w = 0; w < words.size(); w++)
+   {
+      uint64_t hash = hashWord(words[w]);
+      size_t i = hash & (numSlots - 1);
+      while ( slots[i] != 0 )
+         i = (i + 1) & (numSlots - 1);
+      slots[i] = (uint32_t)(w + 1);
+      
+      if ( wantBloom )
+      {
+         size_t first, second;
+         bloomBits(hash, first, second);
+         bloom[first >> 6] |= 1ULL << (first & 63);
+         bloom[second >> 6] |= 1ULL << (second & 63);
+      }
+   }
+}
+
+/**Returns the two bit positions a hash sets in the Bloom filter.
+@param hash The hash of the word.
+@param first The first bit position.
+@param second The second bit position. */
+void StopWordSet::bloomBits(uint64_t hash, size_t& first, size_t& second) const
+{
+   size_t numBits = bloom.size() * 64;
+   
+   //the table uses the low bits, so the filter takes its bits from the top half and from a remix
+   first = (size_t)(hash >> 32) & (numBits - 1);
+   second = (size_t)((hash * 0x9E3779B97F4A7C15ULL) >> 40) & (numBits - 1);
+}
@@ -0,0 +1,118 @@
+/*
+file name: StopWordSet.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the StopWordSet class. A StopWordSet holds the stop words excluded from the concordance in an open-addressing hash table, so checking a keyword costs one hash and usually a single probe, however long the stop word list is. Large sets are also given a Bloom filter that rejects most keywords that are not stop words without touching the table. The set can instead use a built-in list of common English stop words whose hash table is generated at compile time, so no file has to be read.
+*/
+
+#ifndef STOPWORDSET_H
+#define STOPWORDSET_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+class StopWordSet
+{
+public:
+   
+   /** The default constructor for the StopWordSet class.
+   Constructs an empty StopWordSet. */
+   StopWordSet();
+   
+   /**Adds a stop word to the set.
+   @param word The stop word, already stripped of punctuation and lowercase.
+   @return True if the word was added, false if it was already in the set.
+   @pre word must be of type string_view.
+   @post The word will be in the set. If the set was using the built-in list, the built-in words are copied into the set first. */
+   bool insert(string_view word);
+   
+   /**Checks if a word is in the set.
+   @param word The word to be checked, stripped of punctuation and lowercase.
+   @return True if the word is a stop word, false otherwise.
+   @pre word must be of type string_view.
+   @post True will be returned if the word is in the set, otherwise false will be returned. */
+   bool contains(string_view word) const;
+   
+   /**Replaces the contents of the set with the built-in list of stop words.
+   @pre none
+   @post The set will contain the built-in stop words. Their hash table was built at compile time, so nothing is allocated. */
+   void useBuiltInList();
+   
+   /**Turns the Bloom filter in front of the hash table on or off.
+   @param enabled True to check the Bloom filter before the table.
+   @pre none
+   @post contains will consult the Bloom filter first if enabled is true. By default the filter is enabled once the set holds more than BLOOM_THRESHOLD words. */
+   void setBloomFilter(bool enabled);
+   
+   /**Empties the set.
+   @pre none
+   @post The set will contain no words. */
+   void clear();
+   
+   /**Returns the number of stop words in the set.
+   @return The number of stop words.
+   @pre none
+   @post The number of stop words will be returned as an int. */
+   int size() const;
+   
+   /**Returns a stop word of the set.
+   @param index The position of the word in the set, in the order the words were added, or of the built-in list.
+   @return The stop word.
+   @pre index must be less than size().
+   @post The word will be returned as a string_view. */
+   string_view getWord(size_t index) const;
+   
+   /**Returns the number of words in the built-in list.
+   @return The number of built-in stop words.
+   @pre none
+   @post The number of built-in stop words will be returned as a size_t. */
+   size_t static getNumBuiltInWords();
+   
+   /**Returns a word of the built-in list.
+   @param index The position of the word in the list.
+   @return The built-in stop word.
+   @pre index must be less than getNumBuiltInWords().
+   @post The word will be returned as a string_view. */
+   string_view static getBuiltInWord(size_t index);
+   
+   /**Hashes a word with 64-bit FNV-1a. Usable at compile time.
+   @param word The word to be hashed.
+   @return The hash of the word. */
+   static constexpr uint64_t hashWord(string_view word)
+   {
+      uint64_t hash = 14695981039346656037ULL;
+      for (size_t i = 0; i < word.length(); i++)
+      {
+         hash ^= (unsigned char)word[i];
+         hash *= 1099511628211ULL;
+      }
+      return hash;
+   }
+   
+   static const int BLOOM_THRESHOLD = 256; //sets larger than this get a Bloom filter unless it was turned off
+   
+private:
+   
+   /**Rebuilds the hash table, and the Bloom filter if it is enabled, from the words in the set.
+   @pre none
+   @post Every word can be found by probing from its hash. The table is at most half full. */
+   void rebuild();
+   
+   /**Returns the two bit positions a hash sets in the Bloom filter.
+   @param hash The hash of the word.
+   @param first The first bit position.
+   @param second The second bit position. */
+   void bloomBits(uint64_t hash, size_t& first, size_t& second) const;
+   
+   vector<string> words; //the stop words, indexed by their slot values minus 1
+   vector<uint32_t> slots; //the open-addressing table, each slot is a word index plus 1, or 0 if empty
+   vector<uint64_t> bloom; //bits of the Bloom filter, empty if the filter is not in use
+   bool builtIn; //true if the set is using the built-in list instead of words and slots
+   int bloomSetting; //1 if the filter was turned on, 0 if it was turned off, -1 to decide by size
+};
+
+#endif
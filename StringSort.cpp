@@ -0,0 +1,118 @@
+/*
+file name: StringSort.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the StringSort class. The StringSort class sorts keywords with a multikey quicksort, a three-way quicksort on one byte of the keys at a time. The keys that share the pivot byte are sorted on the next byte, so a prefix that many keys share is read once per key at each depth instead of again by every comparison, as with std::sort and operator<. Each key is sorted as a pointer to its bytes, its length and the index of its owner, so sorting reads the bytes of the keys and never the objects that hold them. The order is the order of operator< on strings: bytes compare as unsigned, and a key comes before every longer key it is a prefix of. Runs of a few keys are finished with an insertion sort.
+*/
+
+#include "StringSort.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**Makes the Key of a string.
+@param key The string to be sorted.
+@param index The index of the string's owner.
+@return The Key, which views the bytes of key.
+@pre key must be shorter than 4 GB, and its bytes must not move or change until the Key is sorted. */
+StringSort::Key StringSort::makeKey(string_view key, size_t index)
+{
+   return Key{key.data(), (uint32_t)key.length(), (uint32_t)index};
+}
+
+/**Sorts keys in the order of operator< on their strings.
+@param keys The keys to be sorted.
+@pre none
+@post keys will be in alphabetical order by byte. The order of equal keys is unspecified. */
+void StringSort::sort(vector<Key>& keys)
+{
+   multikeySort(keys.data(), keys.size(), 0);
+}
+
+/**Returns the byte of a key at a depth.
+@param key The key.
+@param depth The index of the byte.
+@return The byte as an unsigned value, or -1 past the end of the key, so a shorter key comes first. */
+int StringSort::byteAt(const Key& key, size_t depth)
+{
+   return depth < key.length ? (unsigned char)key.data[depth] : -1;
+}
+
+/**Sorts a run of keys that are equal in their first depth bytes.
+@param keys The first key of the run.
+@param count The number of keys in the run.
+@param depth The number of bytes the keys are known to share.
+@pre Every key in the run must have at least depth bytes, and the same first depth bytes.
+@post The run will be in alphabetical order. */
+void StringSort::multikeySort(Key* keys, size_t count, size_t depth)
+{
+   //the keys equal to the pivot move on to the next byte without recursing, so the depth of recursion is set by the smaller runs
+   while ( count > INSERTION_KEYS )
+   {
+      //the median of the first, middle and last bytes keeps sorted and reversed runs from splitting badly
+      int first = byteAt(keys[0], depth);
+      int middle = byteAt(keys[count / 2], depth);
+      int last = byteAt(keys[count - 1], depth);
+      int pivot = max(min(first, middle), min(max(first, middle), last));
+
+      //split the run into the keys below, equal to and above the pivot at this depth
+      size_t below = 0;
+      size_t k = 0;
+      size_t above = count;
+      while ( k < above )
+      {
+         int b = byteAt(keys[k], depth);
+         if ( b < pivot )
+            swap(keys[below++], keys[k++]);
+         else if ( b > pivot )
+            swap(keys[k], keys[--above]);
+         else
+            k++;
+      }
+
+      multikeySort(keys, below, depth);
+      multikeySort(keys + above, count - above, depth);
+
+      //keys that ended at this depth are all equal
+      if ( pivot < 0 )
+         return;
+      keys += below;
+      count = above - below;
+      depth++;
+   }
+   insertionSort(keys, count, depth);
+}
+
+/**Sorts a short run of keys that are equal in their first depth bytes by inserting each one in turn.
+@param keys The first key of the run.
+@param count The number of keys in the run.
+@param depth The number of bytes the keys are known to share, which are not compared again.
+@pre Every key in the run must have at least depth bytes, and the same first depth bytes.
+@post The run will be in alphabetical order. */
+void StringSort::insertionSort(Key* keys, size_t count, size_t depth)
+{
+   for (size_t i = 1; i < count; i++)
+   {
+      Key key = keys[i];
+      size_t j = i;
+      while ( j > 0 && lessFrom(key, keys[j - 1], depth) )
+      {
+         keys[j] = keys[j - 1];
+         j--;
+      }
+      keys[j] = key;
+   }
+}
+
+/**Checks if one key comes before another, comparing from a depth on.
+@param a The first key.
+@param b The second key.
+@param depth The number of bytes the keys are known to share.
+@return True if a comes before b, false otherwise. */
+bool StringSort::lessFrom(const Key& a, const Key& b, size_t depth)
+{
+   //memcmp compares bytes as unsigned, as operator< on strings does
+   size_t shorter = min(a.length, b.length) - depth;
+   int order = shorter == 0 ? 0 : memcmp(a.data + depth, b.data + depth, shorter);
+   return order < 0 || ( order == 0 && a.length < b.length );
+}
@@ -0,0 +1,77 @@
+/*
+file name: StringSort.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the StringSort class. The StringSort class sorts keywords with a multikey quicksort, a three-way quicksort on one byte of the keys at a time. The keys that share the pivot byte are sorted on the next byte, so a prefix that many keys share is read once per key at each depth instead of again by every comparison, as with std::sort and operator<. Each key is sorted as a pointer to its bytes, its length and the index of its owner, so sorting reads the bytes of the keys and never the objects that hold them. The order is the order of operator< on strings: bytes compare as unsigned, and a key comes before every longer key it is a prefix of. Runs of a few keys are finished with an insertion sort.
+*/
+
+#ifndef STRINGSORT_H
+#define STRINGSORT_H
+
+#include <vector>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+class StringSort
+{
+public:
+
+   //a key to be sorted and the index of whatever holds it
+   struct Key
+   {
+      const char* data; //the bytes of the key
+      uint32_t length; //the number of bytes in the key
+      uint32_t index; //the index of the key's owner, for the caller
+   };
+
+   static constexpr size_t INSERTION_KEYS = 16; //runs of this many keys or fewer are finished with an insertion sort
+
+   /**Makes the Key of a string.
+   @param key The string to be sorted.
+   @param index The index of the string's owner.
+   @return The Key, which views the bytes of key.
+   @pre key must be shorter than 4 GB, and its bytes must not move or change until the Key is sorted. */
+   Key static makeKey(string_view key, size_t index);
+
+   /**Sorts keys in the order of operator< on their strings.
+   @param keys The keys to be sorted.
+   @pre none
+   @post keys will be in alphabetical order by byte. The order of equal keys is unspecified. */
+   void static sort(vector<Key>& keys);
+
+private:
+
+   /**Returns the byte of a key at a depth.
+   @param key The key.
+   @param depth The index of the byte.
+   @return The byte as an unsigned value, or -1 past the end of the key, so a shorter key comes first. */
+   int static byteAt(const Key& key, size_t depth);
+
+   /**Sorts a run of keys that are equal in their first depth bytes.
+   @param keys The first key of the run.
+   @param count The number of keys in the run.
+   @param depth The number of bytes the keys are known to share.
+   @pre Every key in the run must have at least depth bytes, and the same first depth bytes.
+   @post The run will be in alphabetical order. */
+   void static multikeySort(Key* keys, size_t count, size_t depth);
+
+   /**Sorts a short run of keys that are equal in their first depth bytes by inserting each one in turn.
+   @param keys The first key of the run.
+   @param count The number of keys in the run.
+   @param depth The number of bytes the keys are known to share, which are not compared again.
+   @pre Every key in the run must have at least depth bytes, and the same first depth bytes.
+   @post The run will be in alphabetical order. */
+   void static insertionSort(Key* keys, size_t count, size_t depth);
+
+   /**Checks if one key comes before another, comparing from a depth on.
+   @param a The first key.
+   @param b The second key.
+   @param depth The number of bytes the keys are known to share.
+   @return True if a comes before b, false otherwise. */
+   bool static lessFrom(const Key& a, const Key& b, size_t depth);
+};
+
+#endif
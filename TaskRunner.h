@@ -0,0 +1,29 @@
+/*
+file name: TaskRunner.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the TaskRunner class. A TaskRunner runs a numbered set of independent tasks on a fixed number of threads. Threads take the next task number from a shared counter as they finish their last task, so a slow task does not hold up the rest. The calling thread takes part, so running on 1 thread starts no threads at all.
+*/
+
+#ifndef TASKRUNNER_H
+#define TASKRUNNER_H
+
+#include <cstddef>
+#include <functional>
+
+using namespace std;
+
+class TaskRunner
+{
+public:
+   
+   /**Runs a task for each index on a number of threads.
+   @param threads The number of threads to run the tasks on.
+   @param numTasks The number of tasks.
+   @param task The task to run, given the index of the task.
+   @pre threads must be at least 1.
+   @post The task will have been run once for each index from 0 to numTasks - 1. Threads take the next index as they finish their last one, so indices are started in increasing order. */
+   void static run(int threads, size_t numTasks, const function<void(size_t)>& task);
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*
+file name: TreeIterator.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the TreeIterator class. A TreeIterator is a forward iterator over the rows of a BinarySearchTree, a keyword and one of its contexts, in the order they are printed: alphabetical by keyword, and in corpus order within a keyword. Instead of recursing, it keeps the path of TreeNodes still to be visited on an explicit stack, so it holds no more than the height of the tree and finds the first row after walking a single path down the tree. A TreeIterator may be given a KeyQuery, in which case it skips the subtrees that hold no matches and stops after the last match. It is a template over the window of the tree's contexts.
+*/
+
+#include "TreeIterator.h"
+
+using namespace std;
+
+/** The default constructor for the TreeIterator class.
+Constructs an iterator past the last row of any tree. */
+template <int BEFORE, int AFTER>
+TreeIterator<BEFORE, AFTER>::TreeIterator() : words(nullptr), list(nullptr), position(0), row{string_view(), {}, 0}
+{
+}
+
+/** Constructor for the TreeIterator class that accepts the root of a tree, the word stream its contexts are read from, and the keywords to visit.
+Walks down to the first row of the tree, or of the first keyword the query matches.
+@param root The TreeNode pointer pointing to the root node of the tree, or nullptr.
+@param words The WordStream the positions in the tree's context lists point into.
+@param query The keywords to visit, or nullptr to visit every keyword.
+@pre The tree, the word stream, and the query if given, must not change or be destroyed while the iterator is used. */
+template <int BEFORE, int AFTER>
+TreeIterator<BEFORE, AFTER>::TreeIterator(const TreeNode* root, const WordStream* words, const KeyQuery* query) : walk(root, query), words(words), list(nullptr), position(0), row{string_view(), {}, 0}
+{
+   findRow();
+}
+
+/**Returns the current row.
+@return The keyword and context of the row.
+@pre The iterator must not be past the last row.
+@post The row will be returned as a const reference, valid until the iterator is moved. */
+template <int BEFORE, int AFTER>
+const typename TreeIterator<BEFORE, AFTER>::Row& TreeIterator<BEFORE, AFTER>::operator*() const
+{
+   return row;
+}
+
+/**Returns the current row.
+@return A pointer to the keyword and context of the row.
+@pre The iterator must not be past the last row.
+@post The row will be returned as a const pointer, valid until the iterator is moved. */
+template <int BEFORE, int AFTER>
+const typename TreeIterator<BEFORE, AFTER>::Row* TreeIterator<BEFORE, AFTER>::operator->() const
+{
+   return &row;
+}
+
+/**Moves to the next row.
+@return The iterator.
+@pre The iterator must not be past the last row.
+@post The iterator will be at the next context of the keyword, or at the first context of the next keyword, or past the last row. */
+template <int BEFORE, int AFTER>
+TreeIterator<BEFORE, AFTER>& TreeIterator<BEFORE, AFTER>::operator++()
+{
+   //still in the same keyword's context list
+   if ( reader.next(position) )
+      readRow();
+   else
+      nextKey();
+   return *this;
+}
+
+/**Moves to the next row.
+@return A copy of the iterator from before it was moved.
+@pre The iterator must not be past the last row.
+@post The iterator will be at the next row, or past the last row. */
+template <int BEFORE, int AFTER>
+TreeIterator<BEFORE, AFTER> TreeIterator<BEFORE, AFTER>::operator++(int)
+{
+   TreeIterator before(*this);
+   ++(*this);
+   return before;
+}
+
+/**Moves to the first row of the next keyword, skipping the rest of the rows of the current one.
+@pre The iterator must not be past the last row.
+@post The iterator will be at the first context of the next keyword, or past the last row. */
+template <int BEFORE, int AFTER>
+void TreeIterator<BEFORE, AFTER>::nextKey()
+{
+   walk.next();
+   findRow();
+}
+
+/**Returns the context list of the current keyword.
+@return The context list of the keyword of the current row.
+@pre The iterator must not be past the last row.
+@post The context list will be returned as a const reference. */
+template <int BEFORE, int AFTER>
+const ContextList& TreeIterator<BEFORE, AFTER>::getContextList() const
+{
+   return *list;
+}
+
+/**Tests whether two iterators are at the same row.
+@param other The iterator to compare with.
+@return True if both are at the same row, or both are past the last row. False otherwise. */
+template <int BEFORE, int AFTER>
+bool TreeIterator<BEFORE, AFTER>::operator==(const TreeIterator& other) const
+{
+   return list == other.list && (list == nullptr || position == other.position);
+}
+
+/**Tests whether two iterators are at different rows.
+@param other The iterator to compare with.
+@return True if the iterators are not at the same row, false otherwise. */
+template <int BEFORE, int AFTER>
+bool TreeIterator<BEFORE, AFTER>::operator!=(const TreeIterator& other) const
+{
+   return !(*this == other);
+}
+
+/**Moves to the first row of the walk's current keyword, or of the first keyword after it with a row.
+@pre none
+@post The iterator will be at the first context of a keyword that matches, or past the last row if the walk is past its last keyword. */
+template <int BEFORE, int AFTER>
+void TreeIterator<BEFORE, AFTER>::findRow()
+{
+   for ( ; !walk.atEnd(); walk.next())
+   {
+      list = &walk.getContextList();
+      reader = ContextList::Reader(*list);
+      if ( reader.next(position) )
+      {
+         row.keyWord = walk.getKey();
+         readRow();
+         return;
+      }
+   }
+   list = nullptr;
+}
+
+/**Reads the context of the current position into the row.
+@pre The iterator must not be past the last row.
+@post The row will hold the context and the document of the position. */
+template <int BEFORE, int AFTER>
+void TreeIterator<BEFORE, AFTER>::readRow()
+{
+   ListNode<BEFORE, AFTER> context(*words, position);
+   row.context = context.getContext();
+   row.document = context.getDocument();
+}
+
+//compile the TreeIterator of every window
+#define INSTANTIATE(BEFORE, AFTER) template class TreeIterator<BEFORE, AFTER>;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
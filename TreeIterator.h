@@ -0,0 +1,110 @@
+/*
+file name: TreeIterator.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the TreeIterator class. A TreeIterator is a forward iterator over the rows of a BinarySearchTree, a keyword and one of its contexts, in the order they are printed: alphabetical by keyword, and in corpus order within a keyword. It visits the keywords with a TreeWalk, which keeps the path of TreeNodes still to be visited on an explicit stack, so it holds no more than the height of the tree and finds the first row after walking a single path down the tree. A TreeIterator may be given a KeyQuery, in which case it skips the subtrees that hold no matches and stops after the last match. It is a template over the window of the tree's contexts.
+*/
+
+#ifndef TREEITERATOR_H
+#define TREEITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include "TreeWalk.h"
+
+template <int BEFORE, int AFTER>
+class TreeIterator
+{
+public:
+   
+   //a row of the concordance
+   struct Row
+   {
+      string_view keyWord; //the keyword of the row, a view of its bytes in the tree
+      typename ListNode<BEFORE, AFTER>::contextArr context; //the context of the row, as IDs in the concordance's Vocabulary
+      uint32_t document; //the number of the document the row was read from, 0 for a single corpus
+   };
+   
+   using iterator_category = forward_iterator_tag;
+   using value_type = Row;
+   using difference_type = ptrdiff_t;
+   using pointer = const Row*;
+   using reference = const Row&;
+   
+   /** The default constructor for the TreeIterator class.
+   Constructs an iterator past the last row of any tree. */
+   TreeIterator();
+   
+   /** Constructor for the TreeIterator class that accepts the root of a tree, the word stream its contexts are read from, and the keywords to visit.
+   Walks down to the first row of the tree, or of the first keyword the query matches.
+   @param root The TreeNode pointer pointing to the root node of the tree, or nullptr.
+   @param words The WordStream the positions in the tree's context lists point into.
+   @param query The keywords to visit, or nullptr to visit every keyword.
+   @pre The tree, the word stream, and the query if given, must not change or be destroyed while the iterator is used. */
+   TreeIterator(const TreeNode* root, const WordStream* words, const KeyQuery* query = nullptr);
+   
+   /**Returns the current row.
+   @return The keyword and context of the row.
+   @pre The iterator must not be past the last row.
+   @post The row will be returned as a const reference, valid until the iterator is moved. */
+   const Row& operator*() const;
+   
+   /**Returns the current row.
+   @return A pointer to the keyword and context of the row.
+   @pre The iterator must not be past the last row.
+   @post The row will be returned as a const pointer, valid until the iterator is moved. */
+   const Row* operator->() const;
+   
+   /**Moves to the next row.
+   @return The iterator.
+   @pre The iterator must not be past the last row.
+   @post The iterator will be at the next context of the keyword, or at the first context of the next keyword, or past the last row. */
+   TreeIterator& operator++();
+   
+   /**Moves to the next row.
+   @return A copy of the iterator from before it was moved.
+   @pre The iterator must not be past the last row.
+   @post The iterator will be at the next row, or past the last row. */
+   TreeIterator operator++(int);
+   
+   /**Moves to the first row of the next keyword, skipping the rest of the rows of the current one.
+   @pre The iterator must not be past the last row.
+   @post The iterator will be at the first context of the next keyword, or past the last row. */
+   void nextKey();
+   
+   /**Returns the context list of the current keyword.
+   @return The context list of the keyword of the current row.
+   @pre The iterator must not be past the last row.
+   @post The context list will be returned as a const reference. */
+   const ContextList& getContextList() const;
+   
+   /**Tests whether two iterators are at the same row.
+   @param other The iterator to compare with.
+   @return True if both are at the same row, or both are past the last row. False otherwise. */
+   bool operator==(const TreeIterator& other) const;
+   
+   /**Tests whether two iterators are at different rows.
+   @param other The iterator to compare with.
+   @return True if the iterators are not at the same row, false otherwise. */
+   bool operator!=(const TreeIterator& other) const;
+   
+private:
+   /**Moves to the first row of the walk's current keyword, or of the first keyword after it with a row.
+   @pre none
+   @post The iterator will be at the first context of a keyword that matches, or past the last row if the walk is past its last keyword. */
+   void findRow();
+   
+   /**Reads the context of the current position into the row.
+   @pre The iterator must not be past the last row.
+   @post The row will hold the context and the document of the position. */
+   void readRow();
+   
+   TreeWalk walk; //the path down the tree to the current keyword
+   const WordStream* words; //the word stream the contexts are read from
+   const ContextList* list; //context list of the current row, nullptr past the last row
+   ContextList::Reader reader; //reads the positions of the current list
+   uint64_t position; //position of the current row in the word stream
+   Row row; //the current row
+};
+
+#endif
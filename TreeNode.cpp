@@ -2,53 +2,34 @@
 file name: Node.h
 author: Hall, Ashley
 date: 2019-Nov-23
-description: The implementation file for the ListNode class. Each TreeNode contains a word in the corpus and its list of contexts. The TreeNodes will serve as nodes in the BinarySearchTree class. 
+description: The implementation file for the ListNode class. Each TreeNode contains a word in the corpus and its list of contexts. The TreeNodes will serve as nodes in the BinarySearchTree class. A TreeNode is created in the tree's NodeArena together with the bytes of its keyword and the blocks of its context list, so it owns nothing the arena does not release and the tree never runs its destructor.
 */
 
+#include <cstring>
 #include "TreeNode.h"
 
 /**The default constructor for the TreeNode class.
  Initializes the leftChildPtr and rightChildPtr to nullptr.*/
-TreeNode::TreeNode() : leftChildPtr(nullptr), rightChildPtr(nullptr)
+TreeNode::TreeNode() : leftChildPtr(nullptr), rightChildPtr(nullptr), height(1)
 {
 }
 
-/**Constructor for the TreeNode class that accepts arguments for the keyWord and contextList.
- Initializes the keyWord and contextList to the given arguments. Initializes the leftChildPtr and rightChildPtr to nullptr.
- @param key A keyword in the corpus.
- @param list A list of contexts for the keyword.
- @pre key and list must be of type string and ContextList, respectively.
- */
-TreeNode::TreeNode(const string& key, const ContextList& list)
-   : keyWord(key), contextList(list), leftChildPtr(nullptr), rightChildPtr(nullptr)
-{
-}
-
-/**Constructor for the TreeNode class that accepts arguments for the keyWord, contextList, leftChildPtr, and rightChildPtr.
-Initializes the keyWord, contextList, leftChildPtr, and rightChildPtr to the given arguments.
+/**Constructor for the TreeNode class that accepts arguments for the keyWord and the arena it is created in.
+Copies the bytes of the keyWord into the arena and initializes the contextList to an empty list that creates its blocks in the arena. Initializes the leftChildPtr and rightChildPtr to nullptr.
 @param key A keyword in the corpus.
-@param list A list of contexts for the keyword.
-@param leftChild A TreeNode pointer to the left chlld.
-@param rightChild A TreeNode pointer to the right child.
-@pre key and list must be of type string and ContextList, respectively. leftChild and rightChild must be pointers to TreeNodes
+@param nodeArena The arena the keyword and the blocks of the context list are created in.
+@pre The arena must outlive the TreeNode.
+@post The TreeNode will own no memory outside the arena, so its destructor need not be run.
 */
-TreeNode::TreeNode(const string& key, const ContextList& list,
-                   TreeNode* leftChild, TreeNode* rightChild) :
-   keyWord(key), contextList(list),
-   leftChildPtr(leftChild), rightChildPtr(rightChild)
+TreeNode::TreeNode(string_view key, NodeArena& nodeArena)
+   : contextList(&nodeArena), leftChildPtr(nullptr), rightChildPtr(nullptr), height(1)
 {
+   //copy the keyword next to the node instead of into a string of its own
+   char* bytes = (char*)nodeArena.allocate(key.length(), 1);
+   memcpy(bytes, key.data(), key.length());
+   keyWord = string_view(bytes, key.length());
 }
        
-/**Sets the keyWord for the TreeNode to the given string.
- @param key The string to set the keyWord to.
- @pre key must be of type string.
- @post The keyWord will be set to the given string.
- */
-void TreeNode::setKey(const string& key)
-{
-   keyWord = key;
-}
-
 /**Sets the ContextList for the TreeNode to the given list.
 @param list The list to set the ContextList to.
 @pre list must be of type ContextList.
@@ -59,6 +40,16 @@ void TreeNode::setContextList(const ContextList& list)
    contextList = list;
 }
 
+/**Sets the ContextList for the TreeNode by moving the given list into it.
+@param list The list to set the ContextList to. It will be left empty.
+@pre list must be of type ContextList.
+@post The ContextList will hold the nodes of the given list, which are not copied.
+*/
+void TreeNode::setContextList(ContextList&& list)
+{
+   contextList = move(list);
+}
+
 /**Sets the left child for the TreeNode to the given TreeNode pointer.
 @param leftChild The TreeNode pointer to set the left child to.
 @pre leftChild must be a pointer to a TreeNode.
@@ -82,8 +73,8 @@ void TreeNode::setRightChild(TreeNode* rightChild)
 /**Returns the keyWord of the TreeNode.
  @return Returns the keyWord.
  @pre none
- @post The keyWord will be returned as a string. */
-const string& TreeNode::getKey() const
+ @post The keyWord will be returned as a view of its bytes in the arena. */
+string_view TreeNode::getKey() const
 {
    return keyWord;
 }
@@ -97,6 +88,15 @@ const ContextList& TreeNode::getContextList() const
    return contextList;
 }
 
+/**Returns the context list of the TreeNode so it can be modified.
+@return Returns the context list.
+@pre none
+@post The context list will be returned as a reference. */
+ContextList& TreeNode::getContextList()
+{
+   return contextList;
+}
+
 /**Returns the pointer to the left child of the TreeNode.
 @return Returns the left child TreeNode pointer.
 @pre none
@@ -115,11 +115,20 @@ TreeNode* TreeNode::getRightChild() const
    return rightChildPtr;
 }
 
-/**Adds a new context array to the context list stored in the TreeNode.
- @param context The context array to be added.
- @pre context must be of type ListNode::contextArr
- @post The context will be added to the end of the context list in the TreeNode. */
-void TreeNode::updateContextList(const ListNode::contextArr& context)
+/**Returns the height of the subtree rooted at the TreeNode.
+@return Returns the height of the subtree. A leaf has a height of 1.
+@pre none
+@post The height of the subtree rooted at the TreeNode will be returned. */
+int TreeNode::getHeight() const
+{
+   return height;
+}
+
+/**Sets the height of the subtree rooted at the TreeNode.
+@param newHeight The height of the subtree.
+@pre newHeight must be of type int and greater than 0.
+@post The height will be set to the given value. */
+void TreeNode::setHeight(int newHeight)
 {
-   contextList.add(context);
+   height = newHeight;
 }
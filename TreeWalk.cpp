@@ -0,0 +1,101 @@
+/*
+file name: TreeWalk.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the TreeWalk class. A TreeWalk is the KeyWalk of a BinarySearchTree: it visits the TreeNodes in alphabetical order of their keywords. Instead of recursing, it keeps the path of TreeNodes still to be visited on an explicit stack, so it holds no more than the height of the tree and finds the first keyword after walking a single path down the tree. A TreeWalk may be given a KeyQuery, in which case it skips the subtrees that hold no matches and stops after the last match.
+*/
+
+#include "TreeWalk.h"
+
+/** The default constructor for the TreeWalk class.
+Constructs a walk past the last keyword of any tree. */
+TreeWalk::TreeWalk() : query(nullptr)
+{
+}
+
+/** Constructor for the TreeWalk class that accepts the root of a tree and the keywords to visit.
+Walks down to the first keyword of the tree, or to the first keyword the query matches.
+@param root The TreeNode pointer pointing to the root node of the tree, or nullptr.
+@param query The keywords to visit, or nullptr to visit every keyword.
+@pre The tree, and the query if given, must not change or be destroyed while the walk is used. */
+TreeWalk::TreeWalk(const TreeNode* root, const KeyQuery* query) : query(query)
+{
+   pushLeft(root);
+   checkQuery();
+}
+
+/**Makes a copy of the walk at the same keyword.
+@return A new walk the caller must delete.
+@pre none
+@post The copy will hold a copy of the path, no longer than the height of the tree. */
+KeyWalk* TreeWalk::clone() const
+{
+   return new TreeWalk(*this);
+}
+
+/**Tests whether the walk is past the last keyword.
+@return True if there are no keywords left, false otherwise.
+@pre none
+@post The walk is unchanged. */
+bool TreeWalk::atEnd() const
+{
+   return path.empty();
+}
+
+/**Moves to the next keyword.
+@pre The walk must not be past the last keyword.
+@post The walk will be at the leftmost keyword of the current node's right subtree, or at the node above it on the stack, or past the last keyword. */
+void TreeWalk::next()
+{
+   //the keyword is done, its right subtree comes next and then the nodes below it on the stack
+   const TreeNode* done = path.back();
+   path.pop_back();
+   pushLeft(done->getRightChild());
+   checkQuery();
+}
+
+/**Returns the current keyword.
+@return The keyword.
+@pre The walk must not be past the last keyword.
+@post The keyword will be returned as a view of its bytes in the tree. */
+string_view TreeWalk::getKey() const
+{
+   return path.back()->getKey();
+}
+
+/**Returns the context list of the current keyword.
+@return The context list.
+@pre The walk must not be past the last keyword.
+@post The context list will be returned as a const reference. */
+const ContextList& TreeWalk::getContextList() const
+{
+   return path.back()->getContextList();
+}
+
+/**Pushes the path from a subtree's root down to its first keyword that is not before the query.
+@param treePtr The TreeNode pointer pointing to the root of the subtree.
+@pre treePtr must be a pointer to a TreeNode object or nullptr.
+@post Every node on the path that may match will be on the stack, the first keyword of the subtree on top. Nodes before the query are passed over to their right subtree. */
+void TreeWalk::pushLeft(const TreeNode* treePtr)
+{
+   while ( treePtr != nullptr )
+   {
+      //the node and its left subtree are before the matches, which can only be to the right
+      if ( query != nullptr && query->isBefore(treePtr->getKey()) )
+         treePtr = treePtr->getRightChild();
+      else
+      {
+         path.push_back(treePtr);
+         treePtr = treePtr->getLeftChild();
+      }
+   }
+}
+
+/**Ends the walk if the keyword on top of the stack is after the query.
+@pre none
+@post The stack will be empty if its top keyword is after the matches, since every keyword below it is too. */
+void TreeWalk::checkQuery()
+{
+   if ( query != nullptr && !path.empty() && query->isAfter(path.back()->getKey()) )
+      path.clear();
+}
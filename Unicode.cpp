@@ -0,0 +1,610 @@
+/*
+file name: Unicode.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the Unicode class. The Unicode class decodes and encodes UTF-8 and classifies code points for cleaning words: it folds a code point to lowercase with the simple case folding of the Unicode Character Database, and tells whether it is punctuation, one of the general categories Pc, Pd, Ps, Pe, Pi, Pf and Po. ASCII keeps the rules of ispunct and tolower in the C locale, so ASCII symbols such as $ and + are punctuation as well. The decoder looks up the length of a sequence from its lead byte in a table. The folding and the punctuation of the code points below 0x800, which cover the Latin, Greek, Cyrillic, Hebrew and Arabic letters, are read from a table built at compile time, and the rest from sorted tables of ranges with a binary search. A code point whose lowercase form takes more bytes in UTF-8 than it does, which is only true of U+023A and U+023E, is not folded, so a cleaned word is never longer than the word.
+ The tables of ranges are generated from the Unicode Character Database 14.0 by tools/gen_unicode_tables.py, with the unicodedata module of Python 3.11, by running from the repository root:
+ python3 tools/gen_unicode_tables.py Unicode.cpp
+*/
+
+#include "Unicode.h"
+
+//a run of punctuation code points, sorted by first
+struct PunctRange
+{
+   uint32_t first; //first code point of the run
+   uint32_t last; //last code point of the run
+};
+
+//a run of code points whose folding is the code point plus delta, sorted by first
+struct FoldRange
+{
+   uint32_t first; //first code point of the run
+   uint32_t last; //last code point of the run
+   int32_t delta; //added to a code point to fold it
+   uint32_t stride; //1 if every code point of the run is folded, 2 if only every other one from first is, the ones in between being lowercase already
+};
+
+//the punctuation categories of the Unicode Character Database 14.0, from U+0080 on
+static constexpr PunctRange PUNCT_RANGES[] =
+{
+   {0x00A1, 0x00A1},
+   {0x00A7, 0x00A7},
+   {0x00AB, 0x00AB},
+   {0x00B6, 0x00B7},
+   {0x00BB, 0x00BB},
+   {0x00BF, 0x00BF},
+   {0x037E, 0x037E},
+   {0x0387, 0x0387},
+   {0x055A, 0x055F},
+   {0x0589, 0x058A},
+   {0x05BE, 0x05BE},
+   {0x05C0, 0x05C0},
+   {0x05C3, 0x05C3},
+   {0x05C6, 0x05C6},
+   {0x05F3, 0x05F4},
+   {0x0609, 0x060A},
+   {0x060C, 0x060D},
+   {0x061B, 0x061B},
+   {0x061D, 0x061F},
+   {0x066A, 0x066D},
+   {0x06D4, 0x06D4},
+   {0x0700, 0x070D},
+   {0x07F7, 0x07F9},
+   {0x0830, 0x083E},
+   {0x085E, 0x085E},
+   {0x0964, 0x0965},
+   {0x0970, 0x0970},
+   {0x09FD, 0x09FD},
+   {0x0A76, 0x0A76},
+   {0x0AF0, 0x0AF0},
+   {0x0C77, 0x0C77},
+   {0x0C84, 0x0C84},
+   {0x0DF4, 0x0DF4},
+   {0x0E4F, 0x0E4F},
+   {0x0E5A, 0x0E5B},
+   {0x0F04, 0x0F12},
+   {0x0F14, 0x0F14},
+   {0x0F3A, 0x0F3D},
+   {0x0F85, 0x0F85},
+   {0x0FD0, 0x0FD4},
+   {0x0FD9, 0x0FDA},
+   {0x104A, 0x104F},
+   {0x10FB, 0x10FB},
+   {0x1360, 0x1368},
+   {0x1400, 0x1400},
+   {0x166E, 0x166E},
+   {0x169B, 0x169C},
+   {0x16EB, 0x16ED},
+   {0x1735, 0x1736},
+   {0x17D4, 0x17D6},
+   {0x17D8, 0x17DA},
+   {0x1800, 0x180A},
+   {0x1944, 0x1945},
+   {0x1A1E, 0x1A1F},
+   {0x1AA0, 0x1AA6},
+   {0x1AA8, 0x1AAD},
+   {0x1B5A, 0x1B60},
+   {0x1B7D, 0x1B7E},
+   {0x1BFC, 0x1BFF},
+   {0x1C3B, 0x1C3F},
+   {0x1C7E, 0x1C7F},
+   {0x1CC0, 0x1CC7},
+   {0x1CD3, 0x1CD3},
+   {0x2010, 0x2027},
+   {0x2030, 0x2043},
+   {0x2045, 0x2051},
+   {0x2053, 0x205E},
+   {0x207D, 0x207E},
+   {0x208D, 0x208E},
+   {0x2308, 0x230B},
+   {0x2329, 0x232A},
+   {0x2768, 0x2775},
+   {0x27C5, 0x27C6},
+   {0x27E6, 0x27EF},
+   {0x2983, 0x2998},
+   {0x29D8, 0x29DB},
+   {0x29FC, 0x29FD},
+   {0x2CF9, 0x2CFC},
+   {0x2CFE, 0x2CFF},
+   {0x2D70, 0x2D70},
+   {0x2E00, 0x2E2E},
+   {0x2E30, 0x2E4F},
+   {0x2E52, 0x2E5D},
+   {0x3001, 0x3003},
+   {0x3008, 0x3011},
+   {0x3014, 0x301F},
+   {0x3030, 0x3030},
+   {0x303D, 0x303D},
+   {0x30A0, 0x30A0},
+   {0x30FB, 0x30FB},
+   {0xA4FE, 0xA4FF},
+   {0xA60D, 0xA60F},
+   {0xA673, 0xA673},
+   {0xA67E, 0xA67E},
+   {0xA6F2, 0xA6F7},
+   {0xA874, 0xA877},
+   {0xA8CE, 0xA8CF},
+   {0xA8F8, 0xA8FA},
+   {0xA8FC, 0xA8FC},
+   {0xA92E, 0xA92F},
+   {0xA95F, 0xA95F},
+   {0xA9C1, 0xA9CD},
+   {0xA9DE, 0xA9DF},
+   {0xAA5C, 0xAA5F},
+   {0xAADE, 0xAADF},
+   {0xAAF0, 0xAAF1},
+   {0xABEB, 0xABEB},
+   {0xFD3E, 0xFD3F},
+   {0xFE10, 0xFE19},
+   {0xFE30, 0xFE52},
+   {0xFE54, 0xFE61},
+   {0xFE63, 0xFE63},
+   {0xFE68, 0xFE68},
+   {0xFE6A, 0xFE6B},
+   {0xFF01, 0xFF03},
+   {0xFF05, 0xFF0A},
+   {0xFF0C, 0xFF0F},
+   {0xFF1A, 0xFF1B},
+   {0xFF1F, 0xFF20},
+   {0xFF3B, 0xFF3D},
+   {0xFF3F, 0xFF3F},
+   {0xFF5B, 0xFF5B},
+   {0xFF5D, 0xFF5D},
+   {0xFF5F, 0xFF65},
+   {0x10100, 0x10102},
+   {0x1039F, 0x1039F},
+   {0x103D0, 0x103D0},
+   {0x1056F, 0x1056F},
+   {0x10857, 0x10857},
+   {0x1091F, 0x1091F},
+   {0x1093F, 0x1093F},
+   {0x10A50, 0x10A58},
+   {0x10A7F, 0x10A7F},
+   {0x10AF0, 0x10AF6},
+   {0x10B39, 0x10B3F},
+   {0x10B99, 0x10B9C},
+   {0x10EAD, 0x10EAD},
+   {0x10F55, 0x10F59},
+   {0x10F86, 0x10F89},
+   {0x11047, 0x1104D},
+   {0x110BB, 0x110BC},
+   {0x110BE, 0x110C1},
+   {0x11140, 0x11143},
+   {0x11174, 0x11175},
+   {0x111C5, 0x111C8},
+   {0x111CD, 0x111CD},
+   {0x111DB, 0x111DB},
+   {0x111DD, 0x111DF},
+   {0x11238, 0x1123D},
+   {0x112A9, 0x112A9},
+   {0x1144B, 0x1144F},
+   {0x1145A, 0x1145B},
+   {0x1145D, 0x1145D},
+   {0x114C6, 0x114C6},
+   {0x115C1, 0x115D7},
+   {0x11641, 0x11643},
+   {0x11660, 0x1166C},
+   {0x116B9, 0x116B9},
+   {0x1173C, 0x1173E},
+   {0x1183B, 0x1183B},
+   {0x11944, 0x11946},
+   {0x119E2, 0x119E2},
+   {0x11A3F, 0x11A46},
+   {0x11A9A, 0x11A9C},
+   {0x11A9E, 0x11AA2},
+   {0x11C41, 0x11C45},
+   {0x11C70, 0x11C71},
+   {0x11EF7, 0x11EF8},
+   {0x11FFF, 0x11FFF},
+   {0x12470, 0x12474},
+   {0x12FF1, 0x12FF2},
+   {0x16A6E, 0x16A6F},
+   {0x16AF5, 0x16AF5},
+   {0x16B37, 0x16B3B},
+   {0x16B44, 0x16B44},
+   {0x16E97, 0x16E9A},
+   {0x16FE2, 0x16FE2},
+   {0x1BC9F, 0x1BC9F},
+   {0x1DA87, 0x1DA8B},
+   {0x1E95E, 0x1E95F}
+};
+
+//the simple case folding of the Unicode Character Database 14.0, status C and S of CaseFolding.txt, from U+0080 on
+//U+023A and U+023E are left out, their lowercase forms take three bytes instead of two
+static constexpr FoldRange FOLD_RANGES[] =
+{
+   {0x00B5, 0x00B5, 775, 1},
+   {0x00C0, 0x00D6, 32, 1},
+   {0x00D8, 0x00DE, 32, 1},
+   {0x0100, 0x012E, 1, 2},
+   {0x0132, 0x0136, 1, 2},
+   {0x0139, 0x0147, 1, 2},
+   {0x014A, 0x0176, 1, 2},
+   {0x0178, 0x0178, -121, 1},
+   {0x0179, 0x017D, 1, 2},
+   {0x017F, 0x017F, -268, 1},
+   {0x0181, 0x0181, 210, 1},
+   {0x0182, 0x0184, 1, 2},
+   {0x0186, 0x0186, 206, 1},
+   {0x0187, 0x0187, 1, 1},
+   {0x0189, 0x018A, 205, 1},
+   {0x018B, 0x018B, 1, 1},
+   {0x018E, 0x018E, 79, 1},
+   {0x018F, 0x018F, 202, 1},
+   {0x0190, 0x0190, 203, 1},
+   {0x0191, 0x0191, 1, 1},
+   {0x0193, 0x0193, 205, 1},
+   {0x0194, 0x0194, 207, 1},
+   {0x0196, 0x0196, 211, 1},
+   {0x0197, 0x0197, 209, 1},
+   {0x0198, 0x0198, 1, 1},
+   {0x019C, 0x019C, 211, 1},
+   {0x019D, 0x019D, 213, 1},
+   {0x019F, 0x019F, 214, 1},
+   {0x01A0, 0x01A4, 1, 2},
+   {0x01A6, 0x01A6, 218, 1},
+   {0x01A7, 0x01A7, 1, 1},
+   {0x01A9, 0x01A9, 218, 1},
+   {0x01AC, 0x01AC, 1, 1},
+   {0x01AE, 0x01AE, 218, 1},
+   {0x01AF, 0x01AF, 1, 1},
+   {0x01B1, 0x01B2, 217, 1},
+   {0x01B3, 0x01B5, 1, 2},
+   {0x01B7, 0x01B7, 219, 1},
+   {0x01B8, 0x01B8, 1, 1},
+   {0x01BC, 0x01BC, 1, 1},
+   {0x01C4, 0x01C4, 2, 1},
+   {0x01C5, 0x01C5, 1, 1},
+   {0x01C7, 0x01C7, 2, 1},
+   {0x01C8, 0x01C8, 1, 1},
+   {0x01CA, 0x01CA, 2, 1},
+   {0x01CB, 0x01DB, 1, 2},
+   {0x01DE, 0x01EE, 1, 2},
+   {0x01F1, 0x01F1, 2, 1},
+   {0x01F2, 0x01F4, 1, 2},
+   {0x01F6, 0x01F6, -97, 1},
+   {0x01F7, 0x01F7, -56, 1},
+   {0x01F8, 0x021E, 1, 2},
+   {0x0220, 0x0220, -130, 1},
+   {0x0222, 0x0232, 1, 2},
+   {0x023B, 0x023B, 1, 1},
+   {0x023D, 0x023D, -163, 1},
+   {0x0241, 0x0241, 1, 1},
+   {0x0243, 0x0243, -195, 1},
+   {0x0244, 0x0244, 69, 1},
+   {0x0245, 0x0245, 71, 1},
+   {0x0246, 0x024E, 1, 2},
+   {0x0345, 0x0345, 116, 1},
+   {0x0370, 0x0372, 1, 2},
+   {0x0376, 0x0376, 1, 1},
+   {0x037F, 0x037F, 116, 1},
+   {0x0386, 0x0386, 38, 1},
+   {0x0388, 0x038A, 37, 1},
+   {0x038C, 0x038C, 64, 1},
+   {0x038E, 0x038F, 63, 1},
+   {0x0391, 0x03A1, 32, 1},
+   {0x03A3, 0x03AB, 32, 1},
+   {0x03C2, 0x03C2, 1, 1},
+   {0x03CF, 0x03CF, 8, 1},
+   {0x03D0, 0x03D0, -30, 1},
+   {0x03D1, 0x03D1, -25, 1},
+   {0x03D5, 0x03D5, -15, 1},
+   {0x03D6, 0x03D6, -22, 1},
+   {0x03D8, 0x03EE, 1, 2},
+   {0x03F0, 0x03F0, -54, 1},
+   {0x03F1, 0x03F1, -48, 1},
+   {0x03F4, 0x03F4, -60, 1},
+   {0x03F5, 0x03F5, -64, 1},
+   {0x03F7, 0x03F7, 1, 1},
+   {0x03F9, 0x03F9, -7, 1},
+   {0x03FA, 0x03FA, 1, 1},
+   {0x03FD, 0x03FF, -130, 1},
+   {0x0400, 0x040F, 80, 1},
+   {0x0410, 0x042F, 32, 1},
+   {0x0460, 0x0480, 1, 2},
+   {0x048A, 0x04BE, 1, 2},
+   {0x04C0, 0x04C0, 15, 1},
+   {0x04C1, 0x04CD, 1, 2},
+   {0x04D0, 0x052E, 1, 2},
+   {0x0531, 0x0556, 48, 1},
+   {0x10A0, 0x10C5, 7264, 1},
+   {0x10C7, 0x10C7, 7264, 1},
+   {0x10CD, 0x10CD, 7264, 1},
+   {0x13F8, 0x13FD, -8, 1},
+   {0x1C80, 0x1C80, -6222, 1},
+   {0x1C81, 0x1C81, -6221, 1},
+   {0x1C82, 0x1C82, -6212, 1},
+   {0x1C83, 0x1C84, -6210, 1},
+   {0x1C85, 0x1C85, -6211, 1},
+   {0x1C86, 0x1C86, -6204, 1},
+   {0x1C87, 0x1C87, -6180, 1},
+   {0x1C88, 0x1C88, 35267, 1},
+   {0x1C90, 0x1CBA, -3008, 1},
+   {0x1CBD, 0x1CBF, -3008, 1},
+   {0x1E00, 0x1E94, 1, 2},
+   {0x1E9B, 0x1E9B, -58, 1},
+   {0x1E9E, 0x1E9E, -7615, 1},
+   {0x1EA0, 0x1EFE, 1, 2},
+   {0x1F08, 0x1F0F, -8, 1},
+   {0x1F18, 0x1F1D, -8, 1},
+   {0x1F28, 0x1F2F, -8, 1},
+   {0x1F38, 0x1F3F, -8, 1},
+   {0x1F48, 0x1F4D, -8, 1},
+   {0x1F59, 0x1F5F, -8, 2},
+   {0x1F68, 0x1F6F, -8, 1},
+   {0x1F88, 0x1F8F, -8, 1},
+   {0x1F98, 0x1F9F, -8, 1},
+   {0x1FA8, 0x1FAF, -8, 1},
+   {0x1FB8, 0x1FB9, -8, 1},
+   {0x1FBA, 0x1FBB, -74, 1},
+   {0x1FBC, 0x1FBC, -9, 1},
+   {0x1FBE, 0x1FBE, -7173, 1},
+   {0x1FC8, 0x1FCB, -86, 1},
+   {0x1FCC, 0x1FCC, -9, 1},
+   {0x1FD8, 0x1FD9, -8, 1},
+   {0x1FDA, 0x1FDB, -100, 1},
+   {0x1FE8, 0x1FE9, -8, 1},
+   {0x1FEA, 0x1FEB, -112, 1},
+   {0x1FEC, 0x1FEC, -7, 1},
+   {0x1FF8, 0x1FF9, -128, 1},
+   {0x1FFA, 0x1FFB, -126, 1},
+   {0x1FFC, 0x1FFC, -9, 1},
+   {0x2126, 0x2126, -7517, 1},
+   {0x212A, 0x212A, -8383, 1},
+   {0x212B, 0x212B, -8262, 1},
+   {0x2132, 0x2132, 28, 1},
+   {0x2160, 0x216F, 16, 1},
+   {0x2183, 0x2183, 1, 1},
+   {0x24B6, 0x24CF, 26, 1},
+   {0x2C00, 0x2C2F, 48, 1},
+   {0x2C60, 0x2C60, 1, 1},
+   {0x2C62, 0x2C62, -10743, 1},
+   {0x2C63, 0x2C63, -3814, 1},
+   {0x2C64, 0x2C64, -10727, 1},
+   {0x2C67, 0x2C6B, 1, 2},
+   {0x2C6D, 0x2C6D, -10780, 1},
+   {0x2C6E, 0x2C6E, -10749, 1},
+   {0x2C6F, 0x2C6F, -10783, 1},
+   {0x2C70, 0x2C70, -10782, 1},
+   {0x2C72, 0x2C72, 1, 1},
+   {0x2C75, 0x2C75, 1, 1},
+   {0x2C7E, 0x2C7F, -10815, 1},
+   {0x2C80, 0x2CE2, 1, 2},
+   {0x2CEB, 0x2CED, 1, 2},
+   {0x2CF2, 0x2CF2, 1, 1},
+   {0xA640, 0xA66C, 1, 2},
+   {0xA680, 0xA69A, 1, 2},
+   {0xA722, 0xA72E, 1, 2},
+   {0xA732, 0xA76E, 1, 2},
+   {0xA779, 0xA77B, 1, 2},
+   {0xA77D, 0xA77D, -35332, 1},
+   {0xA77E, 0xA786, 1, 2},
+   {0xA78B, 0xA78B, 1, 1},
+   {0xA78D, 0xA78D, -42280, 1},
+   {0xA790, 0xA792, 1, 2},
+   {0xA796, 0xA7A8, 1, 2},
+   {0xA7AA, 0xA7AA, -42308, 1},
+   {0xA7AB, 0xA7AB, -42319, 1},
+   {0xA7AC, 0xA7AC, -42315, 1},
+   {0xA7AD, 0xA7AD, -42305, 1},
+   {0xA7AE, 0xA7AE, -42308, 1},
+   {0xA7B0, 0xA7B0, -42258, 1},
+   {0xA7B1, 0xA7B1, -42282, 1},
+   {0xA7B2, 0xA7B2, -42261, 1},
+   {0xA7B3, 0xA7B3, 928, 1},
+   {0xA7B4, 0xA7C2, 1, 2},
+   {0xA7C4, 0xA7C4, -48, 1},
+   {0xA7C5, 0xA7C5, -42307, 1},
+   {0xA7C6, 0xA7C6, -35384, 1},
+   {0xA7C7, 0xA7C9, 1, 2},
+   {0xA7D0, 0xA7D0, 1, 1},
+   {0xA7D6, 0xA7D8, 1, 2},
+   {0xA7F5, 0xA7F5, 1, 1},
+   {0xAB70, 0xABBF, -38864, 1},
+   {0xFF21, 0xFF3A, 32, 1},
+   {0x10400, 0x10427, 40, 1},
+   {0x104B0, 0x104D3, 40, 1},
+   {0x10570, 0x1057A, 39, 1},
+   {0x1057C, 0x1058A, 39, 1},
+   {0x1058C, 0x10592, 39, 1},
+   {0x10594, 0x10595, 39, 1},
+   {0x10C80, 0x10CB2, 64, 1},
+   {0x118A0, 0x118BF, 32, 1},
+   {0x16E40, 0x16E5F, 32, 1},
+   {0x1E900, 0x1E921, 34, 1}
+};
+
+static constexpr size_t NUM_PUNCT_RANGES = sizeof(PUNCT_RANGES) / sizeof(PUNCT_RANGES[0]);
+static constexpr size_t NUM_FOLD_RANGES = sizeof(FOLD_RANGES) / sizeof(FOLD_RANGES[0]);
+
+//code points below this take one or two bytes in UTF-8 and are classified with a direct table
+static constexpr uint32_t SMALL_CODE_POINTS = 0x800;
+
+//the folding and punctuation of every code point below SMALL_CODE_POINTS
+struct SmallTable
+{
+   uint16_t folded[SMALL_CODE_POINTS]; //the folded code point, 0 for punctuation
+};
+
+/**Builds the table of the code points below SMALL_CODE_POINTS at compile time, from the C locale for ASCII and from the ranges for the rest.
+@return The filled in table. */
+static constexpr SmallTable makeSmallTable()
+{
+   SmallTable table = {};
+   for (uint32_t c = 0; c < SMALL_CODE_POINTS; c++)
+      table.folded[c] = (uint16_t)c;
+   
+   //ASCII punctuation and uppercase as ispunct and tolower see them in the C locale
+   for (uint32_t c = 0; c < 0x80; c++)
+   {
+      bool punct = (c >= 0x21 && c <= 0x2F) || (c >= 0x3A && c <= 0x40) ||
+                   (c >= 0x5B && c <= 0x60) || (c >= 0x7B && c <= 0x7E);
+      if ( c >= 'A' && c <= 'Z' )
+         table.folded[c] = (uint16_t)(c + ('a' - 'A'));
+      else if ( punct )
+         table.folded[c] = 0;
+   }
+   
+   for (size_t r = 0; r < NUM_FOLD_RANGES && FOLD_RANGES[r].first < SMALL_CODE_POINTS; r++)
+   {
+      for (uint32_t c = FOLD_RANGES[r].first; c <= FOLD_RANGES[r].last && c < SMALL_CODE_POINTS; c += FOLD_RANGES[r].stride)
+         table.folded[c] = (uint16_t)(c + FOLD_RANGES[r].delta);
+   }
+   for (size_t r = 0; r < NUM_PUNCT_RANGES && PUNCT_RANGES[r].first < SMALL_CODE_POINTS; r++)
+   {
+      for (uint32_t c = PUNCT_RANGES[r].first; c <= PUNCT_RANGES[r].last && c < SMALL_CODE_POINTS; c++)
+         table.folded[c] = 0;
+   }
+   return table;
+}
+
+static constexpr SmallTable SMALL_TABLE = makeSmallTable();
+
+//the number of bytes of a UTF-8 sequence, indexed by its lead byte, 0 for a byte that cannot start one
+struct LeadTable
+{
+   unsigned char length[256]; //bytes in the sequence
+};
+
+/**Builds the lead byte table at compile time.
+@return The filled in table. */
+static constexpr LeadTable makeLeadTable()
+{
+   LeadTable table = {};
+   for (int b = 0; b < 256; b++)
+   {
+      //0xC0 and 0xC1 only start overlong sequences, 0xF5 and above only code points past the last
+      if ( b < 0x80 )
+         table.length[b] = 1;
+      else if ( b >= 0xC2 && b <= 0xDF )
+         table.length[b] = 2;
+      else if ( b >= 0xE0 && b <= 0xEF )
+         table.length[b] = 3;
+      else if ( b >= 0xF0 && b <= 0xF4 )
+         table.length[b] = 4;
+   }
+   return table;
+}
+
+static constexpr LeadTable LEAD_TABLE = makeLeadTable();
+
+//the bits of the lead byte that belong to the code point, and the smallest code point that needs the sequence, indexed by its length
+static constexpr unsigned char LEAD_MASKS[Unicode::MAX_SEQUENCE_BYTES + 1] = { 0, 0x7F, 0x1F, 0x0F, 0x07 };
+static constexpr uint32_t MIN_CODE_POINTS[Unicode::MAX_SEQUENCE_BYTES + 1] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+/**Decodes the UTF-8 sequence at the start of a run of bytes.
+@param src The first byte of the sequence.
+@param len The number of bytes that may be read.
+@param codePoint Set to the code point of the sequence.
+@return The number of bytes in the sequence, or 0 if the bytes are not a valid UTF-8 sequence.
+@pre len must be at least 1.
+@post If 0 is returned, codePoint is unchanged. Overlong sequences, surrogates, code points past MAX_CODE_POINT and truncated sequences are not valid. */
+size_t Unicode::decode(const char* src, size_t len, uint32_t& codePoint)
+{
+   const unsigned char* bytes = (const unsigned char*)src;
+   size_t length = LEAD_TABLE.length[bytes[0]];
+   if ( length == 0 || length > len )
+      return 0;
+   
+   uint32_t decoded = bytes[0] & LEAD_MASKS[length];
+   for (size_t k = 1; k < length; k++)
+   {
+      //every byte after the lead is 10xxxxxx
+      if ( (bytes[k] & 0xC0) != 0x80 )
+         return 0;
+      decoded = (decoded << 6) | (bytes[k] & 0x3F);
+   }
+   
+   if ( decoded < MIN_CODE_POINTS[length] || (decoded >= 0xD800 && decoded <= 0xDFFF) || decoded > MAX_CODE_POINT )
+      return 0;
+   codePoint = decoded;
+   return length;
+}
+
+/**Encodes a code point as UTF-8.
+@param codePoint The code point.
+@param dst Where the sequence is written.
+@return The number of bytes written.
+@pre codePoint must be at most MAX_CODE_POINT and not a surrogate. dst must have room for the sequence, at most MAX_SEQUENCE_BYTES bytes.
+@post The UTF-8 sequence of the code point will be at dst. */
+size_t Unicode::encode(uint32_t codePoint, char* dst)
+{
+   if ( codePoint < 0x80 )
+   {
+      dst[0] = (char)codePoint;
+      return 1;
+   }
+   if ( codePoint < 0x800 )
+   {
+      dst[0] = (char)(0xC0 | (codePoint >> 6));
+      dst[1] = (char)(0x80 | (codePoint & 0x3F));
+      return 2;
+   }
+   if ( codePoint < 0x10000 )
+   {
+      dst[0] = (char)(0xE0 | (codePoint >> 12));
+      dst[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+      dst[2] = (char)(0x80 | (codePoint & 0x3F));
+      return 3;
+   }
+   dst[0] = (char)(0xF0 | (codePoint >> 18));
+   dst[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+   dst[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+   dst[3] = (char)(0x80 | (codePoint & 0x3F));
+   return 4;
+}
+
+/**Folds a code point to lowercase.
+@param codePoint The code point.
+@return The simple case folding of the code point, or the code point itself if it has none.
+@pre codePoint must be at most MAX_CODE_POINT.
+@post The folded code point never takes more bytes in UTF-8 than codePoint. */
+uint32_t Unicode::fold(uint32_t codePoint)
+{
+   //punctuation is 0 in the small table, and is its own folding
+   if ( codePoint < SMALL_CODE_POINTS )
+      return SMALL_TABLE.folded[codePoint] != 0 ? SMALL_TABLE.folded[codePoint] : codePoint;
+   
+   //the last range that starts at or before the code point
+   size_t low = 0;
+   size_t high = NUM_FOLD_RANGES;
+   while ( low < high )
+   {
+      size_t mid = (low + high) / 2;
+      if ( FOLD_RANGES[mid].first <= codePoint )
+         low = mid + 1;
+      else
+         high = mid;
+   }
+   if ( low == 0 )
+      return codePoint;
+   const FoldRange& range = FOLD_RANGES[low - 1];
+   if ( codePoint > range.last || (codePoint - range.first) % range.stride != 0 )
+      return codePoint;
+   return (uint32_t)((int32_t)codePoint + range.delta);
+}
+
+/**Checks if a code point is punctuation.
+@param codePoint The code point.
+@return True if the code point is in one of the punctuation categories, or is ASCII punctuation in the C locale. False otherwise.
+@pre none
+@post The code point is unchanged. */
+bool Unicode::isPunct(uint32_t codePoint)
+{
+   if ( codePoint < SMALL_CODE_POINTS )
+      return SMALL_TABLE.folded[codePoint] == 0 && codePoint != 0;
+   
+   //the last range that starts at or before the code point
+   size_t low = 0;
+   size_t high = NUM_PUNCT_RANGES;
+   while ( low < high )
+   {
+      size_t mid = (low + high) / 2;
+      if ( PUNCT_RANGES[mid].first <= codePoint )
+         low = mid + 1;
+      else
+         high = mid;
+   }
+   return low != 0 && codePoint <= PUNCT_RANGES[low - 1].last;
+}
@@ -0,0 +1,55 @@
+/*
+file name: Unicode.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the Unicode class. The Unicode class decodes and encodes UTF-8 and classifies code points for cleaning words: it folds a code point to lowercase with the simple case folding of the Unicode Character Database, and tells whether it is punctuation, one of the general categories Pc, Pd, Ps, Pe, Pi, Pf and Po. ASCII keeps the rules of ispunct and tolower in the C locale, so ASCII symbols such as $ and + are punctuation as well. The decoder looks up the length of a sequence from its lead byte in a table. The folding and the punctuation of the code points below 0x800, which cover the Latin, Greek, Cyrillic, Hebrew and Arabic letters, are read from a table built at compile time, and the rest from sorted tables of ranges with a binary search. A code point whose lowercase form takes more bytes in UTF-8 than it does, which is only true of U+023A and U+023E, is not folded, so a cleaned word is never longer than the word.
+*/
+
+#ifndef UNICODE_H
+#define UNICODE_H
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+class Unicode
+{
+public:
+   
+   static constexpr uint32_t MAX_CODE_POINT = 0x10FFFF; //the last code point
+   static constexpr size_t MAX_SEQUENCE_BYTES = 4; //the longest UTF-8 sequence
+   
+   /**Decodes the UTF-8 sequence at the start of a run of bytes.
+   @param src The first byte of the sequence.
+   @param len The number of bytes that may be read.
+   @param codePoint Set to the code point of the sequence.
+   @return The number of bytes in the sequence, or 0 if the bytes are not a valid UTF-8 sequence.
+   @pre len must be at least 1.
+   @post If 0 is returned, codePoint is unchanged. Overlong sequences, surrogates, code points past MAX_CODE_POINT and truncated sequences are not valid. */
+   size_t static decode(const char* src, size_t len, uint32_t& codePoint);
+   
+   /**Encodes a code point as UTF-8.
+   @param codePoint The code point.
+   @param dst Where the sequence is written.
+   @return The number of bytes written.
+   @pre codePoint must be at most MAX_CODE_POINT and not a surrogate. dst must have room for the sequence, at most MAX_SEQUENCE_BYTES bytes.
+   @post The UTF-8 sequence of the code point will be at dst. */
+   size_t static encode(uint32_t codePoint, char* dst);
+   
+   /**Folds a code point to lowercase.
+   @param codePoint The code point.
+   @return The simple case folding of the code point, or the code point itself if it has none.
+   @pre codePoint must be at most MAX_CODE_POINT.
+   @post The folded code point never takes more bytes in UTF-8 than codePoint. */
+   uint32_t static fold(uint32_t codePoint);
+   
+   /**Checks if a code point is punctuation.
+   @param codePoint The code point.
+   @return True if the code point is in one of the punctuation categories, or is ASCII punctuation in the C locale. False otherwise.
+   @pre none
+   @post The code point is unchanged. */
+   bool static isPunct(uint32_t codePoint);
+};
+
+#endif
@@ -0,0 +1,101 @@
+/*
+file name: Vocabulary.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the Vocabulary class. The Vocabulary interns each distinct word in the corpus once and assigns it a dense 32-bit ID, so contexts can be stored as arrays of IDs instead of copies of the words. ID 0 is reserved for the empty string, which fills context slots before the first word and after the last word of the corpus. Words are looked up by string_view in an open-addressing hash table, so a word that has been seen before is never copied.
+*/
+
+#include "Vocabulary.h"
+
+/** The default constructor for the Vocabulary class.
+Constructs a Vocabulary containing only the empty string, which is assigned the ID EMPTY_WORD. */
+Vocabulary::Vocabulary() : slots(INITIAL_SLOTS, Slot{0, 0})
+{
+   //the empty string always has ID 0
+   intern("");
+}
+
+/**Returns the ID for a word, assigning the next unused ID if the word has not been seen before.
+@param word The word to be interned.
+@return The ID of the word.
+@pre word must be of type string_view.
+@post If the word was not in the Vocabulary, a copy of it will be stored and assigned the next ID. Otherwise the Vocabulary is unchanged. */
+Vocabulary::wordId Vocabulary::intern(string_view word)
+{
+   size_t wordHash = hasher(word);
+   size_t mask = slots.size() - 1;
+   
+   //probe linearly from the word's home slot
+   for (size_t i = wordHash & mask; ; i = (i + 1) & mask)
+   {
+      Slot& slot = slots[i];
+      
+      //empty slot, the word has not been seen before
+      if ( slot.word == 0 )
+      {
+         wordId id = (wordId)words.size();
+         words.emplace_back(word);
+         slot.hash = (uint32_t)wordHash;
+         slot.word = id + 1;
+         
+         //keep the table at most half full so probe sequences stay short
+         if ( words.size() * 2 > slots.size() )
+            grow();
+         return id;
+      }
+      
+      //only compare the strings when the stored hash bits match
+      if ( slot.hash == (uint32_t)wordHash && words[slot.word - 1] == word )
+         return slot.word - 1;
+   }
+}
+
+/**Doubles the size of the hash table and places every word in its new slot.
+@pre none
+@post The table will be twice as large and every word can be found by probing from its hash. */
+void Vocabulary::grow()
+{
+   vector<Slot> newSlots(slots.size() * 2, Slot{0, 0});
+   size_t mask = newSlots.size() - 1;
+   
+   //rehash each word into the larger table
+   for (size_t id = 0; id < words.size(); id++)
+   {
+      size_t wordHash = hasher(words[id]);
+      size_t i = wordHash & mask;
+      while ( newSlots[i].word != 0 )
+         i = (i + 1) & mask;
+      newSlots[i].hash = (uint32_t)wordHash;
+      newSlots[i].word = (uint32_t)(id + 1);
+   }
+   slots.swap(newSlots);
+}
+
+/**Returns the word with the given ID.
+@param id The ID of the word.
+@return The word as a string.
+@pre id must have been returned by intern.
+@post The word will be returned as a string. */
+const string& Vocabulary::getWord(wordId id) const
+{
+   return words[id];
+}
+
+/**Returns the length of the word with the given ID.
+@param id The ID of the word.
+@return The length of the word.
+@pre id must have been returned by intern.
+@post The length of the word will be returned as an int. */
+int Vocabulary::getLength(wordId id) const
+{
+   return (int)words[id].length();
+}
+
+/**Returns the number of distinct words in the Vocabulary, including the empty string.
+@return The number of words in the Vocabulary.
+@pre none
+@post The number of words will be returned as an int. */
+int Vocabulary::size() const
+{
+   return (int)words.size();
+}
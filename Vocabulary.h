@@ -0,0 +1,80 @@
+/*
+file name: Vocabulary.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the Vocabulary class. The Vocabulary interns each distinct word in the corpus once and assigns it a dense 32-bit ID, so contexts can be stored as arrays of IDs instead of copies of the words. ID 0 is reserved for the empty string, which fills context slots before the first word and after the last word of the corpus. Words are looked up by string_view in an open-addressing hash table, so a word that has been seen before is never copied.
+*/
+
+#ifndef VOCABULARY_H
+#define VOCABULARY_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <cstdint>
+
+using namespace std;
+
+class Vocabulary
+{
+public:
+   
+   typedef uint32_t wordId; //create alias type for a word's ID
+   
+   static constexpr wordId EMPTY_WORD = 0; //ID of the empty string
+   
+   /** The default constructor for the Vocabulary class.
+   Constructs a Vocabulary containing only the empty string, which is assigned the ID EMPTY_WORD. */
+   Vocabulary();
+   
+   /**Returns the ID for a word, assigning the next unused ID if the word has not been seen before.
+   @param word The word to be interned.
+   @return The ID of the word.
+   @pre word must be of type string_view.
+   @post If the word was not in the Vocabulary, a copy of it will be stored and assigned the next ID. Otherwise the Vocabulary is unchanged. */
+   wordId intern(string_view word);
+   
+   /**Returns the word with the given ID.
+   @param id The ID of the word.
+   @return The word as a string.
+   @pre id must have been returned by intern.
+   @post The word will be returned as a string. */
+   const string& getWord(wordId id) const;
+   
+   /**Returns the length of the word with the given ID.
+   @param id The ID of the word.
+   @return The length of the word.
+   @pre id must have been returned by intern.
+   @post The length of the word will be returned as an int. */
+   int getLength(wordId id) const;
+   
+   /**Returns the number of distinct words in the Vocabulary, including the empty string.
+   @return The number of words in the Vocabulary.
+   @pre none
+   @post The number of words will be returned as an int. */
+   int size() const;
+   
+private:
+   
+   //a slot in the hash table, word is the word's ID plus 1 so that 0 marks an empty slot
+   struct Slot
+   {
+      uint32_t hash; //low bits of the word's hash, compared before the word itself
+      uint32_t word; //ID of the word plus 1, or 0 if the slot is empty
+   };
+   
+   static const size_t INITIAL_SLOTS = 1024; //size of a new table, must be a power of 2
+   
+   /**Doubles the size of the hash table and places every word in its new slot.
+   @pre none
+   @post The table will be twice as large and every word can be found by probing from its hash. */
+   void grow();
+   
+   deque<string> words; //the words, indexed by ID, a deque so the strings never move
+   vector<Slot> slots; //the open-addressing table, probed linearly
+   hash<string_view> hasher; //hash function for the words
+};
+
+#endif
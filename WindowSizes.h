@@ -0,0 +1,28 @@
+/*
+file name: WindowSizes.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The windows of context the program is compiled for. Every class that reads or formats the context of a keyword, a run of words around its position in the WordStream, is a template over the number of words before and after the keyword, so each window gets its own code with the loops over the context unrolled. The templates are instantiated for each window listed here, and the window is picked once from the command line, so reading the corpus pays nothing for the choice.
+*/
+
+#ifndef WINDOWSIZES_H
+#define WINDOWSIZES_H
+
+static constexpr int DEFAULT_WINDOW_WORDS = 5; //context words on each side of the keyword without --window
+
+//calls WINDOW(BEFORE, AFTER) for each window the program is compiled for, as words before and after the keyword
+#define FOR_EACH_WINDOW(WINDOW) WINDOW(3, 3) WINDOW(5, 5) WINDOW(10, 10)
+
+/**Tells whether the program is compiled for a window.
+@param wordsBefore The number of context words before the keyword.
+@param wordsAfter The number of context words after the keyword.
+@return True if the window is one of FOR_EACH_WINDOW, false otherwise. */
+inline bool isCompiledWindow(int wordsBefore, int wordsAfter)
+{
+#define MATCHES(BEFORE, AFTER) if ( wordsBefore == BEFORE && wordsAfter == AFTER ) return true;
+   FOR_EACH_WINDOW(MATCHES)
+#undef MATCHES
+   return false;
+}
+
+#endif
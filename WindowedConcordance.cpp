@@ -0,0 +1,383 @@
+/*
+file name: WindowedConcordance.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the WindowedConcordance class. The WindowedConcordance class is the base class of the concordance engines for one size of context, BEFORE words before the keyword and AFTER words after it. It reads the corpus into the word stream, adds the position of each keyword to its context list, keeps the maximum column lengths up to date, and writes the rows of the context lists in alphabetical order. Each text in the word stream is set off by PADDING empty words, so the context of every keyword is the run of words around its position. Since the window is a template parameter, the rows read back from the word stream, the loops over them and the row formatting all have a fixed size, and choosing a window costs nothing per word. Derived classes decide how the keywords and their context lists are indexed and how they are put in alphabetical order for printing. The rows of every engine can also be read one at a time through a RowCursor, which visits the keywords with the KeyWalk each derived class gives.
+*/
+
+#include "WindowedConcordance.h"
+
+#include <mutex>
+#include <condition_variable>
+#include "TaskRunner.h"
+#include "ParallelIngester.h"
+#include "BatchIngester.h"
+
+using namespace std;
+
+/** The default constructor for the WindowedConcordance class.
+Constructs an empty concordance with an empty word stream. */
+template <int BEFORE, int AFTER>
+WindowedConcordance<BEFORE, AFTER>::WindowedConcordance() : Concordance(), keyPosition(0)
+{
+}
+
+/** Returns the number of context words before each keyword.
+@return BEFORE. */
+template <int BEFORE, int AFTER>
+int WindowedConcordance<BEFORE, AFTER>::getWordsBefore() const
+{
+   return BEFORE;
+}
+
+/** Returns the number of context words after each keyword.
+@return AFTER. */
+template <int BEFORE, int AFTER>
+int WindowedConcordance<BEFORE, AFTER>::getWordsAfter() const
+{
+   return AFTER;
+}
+
+/**Adds every word of a corpus, with its context, to the concordance.
+@param reader The CorpusReader the corpus is open in.
+@param threads The number of threads to read the corpus on.
+@pre threads must be at least 1, and the concordance must be empty if it is more. The stop words must already be set.
+@post Every word of the corpus that is not a lone punctuation symbol will have been added as a keyword with its context, in corpus order. */
+template <int BEFORE, int AFTER>
+void WindowedConcordance<BEFORE, AFTER>::addCorpus(CorpusReader& reader, int threads)
+{
+   //split the corpus between the threads, each builds a partial concordance that is merged in corpus order
+   if ( threads > 1 )
+   {
+      ParallelIngester ingester(threads);
+      ingester.ingest(reader.getContents(), *this);
+      return;
+   }
+   
+   //position of the first word read that has not been added as a keyword yet
+   uint64_t nextKey = startText();
+   
+   //the word read from the corpus file, a view into the mapped file
+   string_view word;
+   
+   //read each string in the file
+   while ( reader.nextWord(word) )
+   {
+      //checks if word is a lone punctuation symbol
+      if ( isPunct(word) )
+         continue;
+      
+      //append the word to the stream, once AFTER words follow the next key its context is complete
+      if ( appendWord(word) - nextKey == AFTER )
+         add(nextKey++);
+   }
+   
+   //the empty words after the text complete the contexts of the last AFTER words, or every word if the corpus has AFTER words or fewer
+   uint64_t textEnd = words.getEnd();
+   endText();
+   while ( nextKey < textEnd )
+      add(nextKey++);
+}
+
+/**Adds every word of a list of documents, with its context, to the concordance, numbering the documents from 1 in the order given.
+@param documents The names of the document files.
+@param threads The number of threads to read the documents on.
+@param unreadable Set to the name of the first document that could not be opened.
+@return True if every document was read, false if one could not be opened.
+@pre threads must be at least 1, and the concordance must be empty if it is more. The stop words must already be set.
+@post Every word of each document that is not a lone punctuation symbol will have been added as a keyword with its context and the number of its document. No context reaches across the end of a document, and the contexts of a keyword are in document order, then in the order they appear in the document. */
+template <int BEFORE, int AFTER>
+bool WindowedConcordance<BEFORE, AFTER>::addDocuments(const vector<string>& documents, int threads, string& unreadable)
+{
+   BatchIngester ingester(threads);
+   return ingester.ingest(documents, *this, unreadable);
+}
+
+/**Starts a new text in the word stream, so no context reaches back into the text before it.
+@return The position the first word of the text will have.
+@pre none
+@post If the word stream is empty, PADDING empty words will have been appended to it. Otherwise the empty words after the last text already set it off. */
+template <int BEFORE, int AFTER>
+uint64_t WindowedConcordance<BEFORE, AFTER>::startText()
+{
+   if ( words.getEnd() == 0 )
+      words.appendEmpty(PADDING);
+   return words.getEnd();
+}
+
+/**Appends a word from the corpus to the word stream.
+@param word The word, as it appears in the corpus.
+@return The position of the word in the word stream.
+@pre word must not be a lone punctuation symbol.
+@post The word will be interned in the Vocabulary and appended to the word stream. It is not a keyword until its position is added. */
+template <int BEFORE, int AFTER>
+uint64_t WindowedConcordance<BEFORE, AFTER>::appendWord(string_view word)
+{
+   return words.append(internWord(word));
+}
+
+/**Ends the text being read into the word stream, so no context reaches past its last word.
+@pre none
+@post PADDING empty words will have been appended to the word stream. */
+template <int BEFORE, int AFTER>
+void WindowedConcordance<BEFORE, AFTER>::endText()
+{
+   words.appendEmpty(PADDING);
+}
+
+/**Adds the keyword at a position of the word stream to the concordance, or updates the keyword's context list with the position if the keyword has already been added.
+ @param position The position of the keyword in the word stream.
+ @return True if the keyword could be added to the concordance or the keyword already exists and the context list was updated. False otherwise
+ @pre The word stream must hold the BEFORE words before the position and the AFTER words after it. Keywords must be added in order of their positions.
+ @post If the addition was successful, the keyword, stripped of punctuation and lowercase, and the position will be added to the concordance. Or if the keyword already exists the context list will be updated with the position. If the context of the keyword contains the longest pre-key context, post-key context, and/or keyword, the maximum lengths for these values will be updated.*/
+template <int BEFORE, int AFTER>
+bool WindowedConcordance<BEFORE, AFTER>::add(uint64_t position)
+{
+   //a few of the adds are timed stage by stage when a report was asked for
+   if ( stats != nullptr && stats->sampleAdd() )
+   {
+      addSampled(position);
+      return true;
+   }
+   numKeywordsRead++;
+   keyPosition = position;
+   
+   //before adding keyword to the concordance, strip it of punctuation and make lowercase
+   removePunctAndLower(vocabulary.getWord(*words.getWords(position)), cleanedKey);
+   
+   //if no stop words are excluded, insert keyword into the concordance
+   if ( !stopWords )
+      findOrInsert(cleanedKey).add(position);
+   
+   //stop words are excluded so check if keyword is a stop word
+   //if not a stopward, insert keyword into the concordance
+   else if ( stopWords && !isStopWord(cleanedKey) )
+      findOrInsert(cleanedKey).add(position);
+   else
+      numStopWordHits++;
+   
+   //updates max lengths for the pre-key context, key, and post-key context
+   setMaxLengths(position);
+   
+   //keyword was successfully added or updated with new context
+   return true;
+}
+
+/**Moves a list of contexts to the end of a keyword's context list, adding the keyword first if it is not in the concordance yet.
+@param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+@param contexts The contexts of the keyword, as positions of another word stream that was appended to this concordance's.
+@param shift The number added to a position of the other word stream to give its position in this concordance's, as returned by placeWords.
+@pre The contexts must come after the keyword's existing contexts in the corpus.
+@post If the keyword is not a stop word, the contexts will be moved to the end of its context list, shifted, and contexts will be empty. If it is a stop word, contexts is left unchanged. */
+template <int BEFORE, int AFTER>
+void WindowedConcordance<BEFORE, AFTER>::appendContexts(const string& keyWord, ContextList& contexts, int64_t shift)
+{
+   numKeywordsRead += contexts.size();
+   if ( !stopWords || !isStopWord(keyWord) )
+      findOrInsert(keyWord).splice(contexts, shift);
+   else
+      numStopWordHits += contexts.size();
+}
+
+/** Updates the maximum lengths of the pre-key context length, the key length, and the post-key context length.
+@param position The position of the keyword in the word stream.
+@pre The word stream must hold the BEFORE words before the position and the AFTER words after it.
+@post If any of the lengths in the context of the keyword are greater than the current maximum lengths, the maximum length(s) will be updated with the appropriate length(s) in the context. If no lengths in the context are greater, the maximum lengths will remain the same.
+ */
+template <int BEFORE, int AFTER>
+void WindowedConcordance<BEFORE, AFTER>::setMaxLengths(uint64_t position)
+{
+   //the context is the run of words centered on the keyword, read in place
+   const Vocabulary::wordId* context = words.getWords(position - BEFORE);
+   
+   int preKeyLen = 0;
+   int keyLen = vocabulary.getLength(context[BEFORE]);
+   int postKeyLen = 0;
+   
+   //pre-key context words are in index 0 to BEFORE - 1
+   //finds total length of all pre-key context words in given array
+   for (int i = 0; i < BEFORE; i++)
+      preKeyLen += vocabulary.getLength(context[i]);
+   
+   //post-key context words are in the AFTER indices after the keyword
+   //finds the total length of all post-key context words in the given array
+   for (int i = BEFORE + 1; i < BEFORE + 1 + AFTER; i++)
+      postKeyLen += vocabulary.getLength(context[i]);
+   
+   //if any of the lengths in the given array are greater than the current max lengths
+   //update max lengths
+   maxPreKeyLen = preKeyLen > maxPreKeyLen ? preKeyLen : maxPreKeyLen;
+   maxKeyLen = keyLen > maxKeyLen ? keyLen : maxKeyLen;
+   maxPostKeyLen = postKeyLen > maxPostKeyLen ? postKeyLen : maxPostKeyLen;
+   
+}
+
+/**Returns a cursor at the first row of the concordance.
+@return A cursor over the rows in alphabetical order based on the keyword, and in corpus order within a keyword.
+@pre The concordance must not be changed while the cursor is used. The cursor only reads the context lists in memory, so a SpillConcordance that has spilled runs to disk must be printed with writeConcordance instead.
+@post The cursor will be at the first context of the first keyword, or at its end if the concordance is empty. The cursor walks the engine's own ordered structure with walkKeys, so no list is collected and no row is read before it is asked for. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER> WindowedConcordance<BEFORE, AFTER>::rowCursor() const
+{
+   return RowCursor<BEFORE, AFTER>(walkKeys(nullptr), &words);
+}
+
+/**Returns a cursor at the first row of the keywords a query matches.
+@param query The keywords to visit.
+@return A cursor over the rows of the matching keywords in alphabetical order, and in corpus order within a keyword.
+@pre The concordance must not be changed, and the query must not be destroyed, while the cursor is used. The cursor only reads the context lists in memory, so a SpillConcordance that has spilled runs to disk must be printed with writeMatches instead.
+@post The cursor will be at the first context of the first matching keyword, or at its end if nothing matches. */
+template <int BEFORE, int AFTER>
+RowCursor<BEFORE, AFTER> WindowedConcordance<BEFORE, AFTER>::matchingRowCursor(const KeyQuery& query) const
+{
+   return RowCursor<BEFORE, AFTER>(walkKeys(&query), &words);
+}
+
+/** Writes the rows of every keyword in alphabetical order, from the context lists in memory.
+@param writer The OutputWriter to write the rows to, with its columns set.
+@param threads The number of threads to format the rows on.
+@pre threads must be at least 1.
+@post The rows of every keyword will be written in alphabetical order, and in corpus order within a keyword. With more than one thread, the rows are split into ranges that are formatted in parallel and written to the writer's file descriptor strictly in order. */
+template <int BEFORE, int AFTER>
+void WindowedConcordance<BEFORE, AFTER>::writeRows(OutputWriter& writer, int threads) const
+{
+   vector<const ContextList*> lists;
+   sortedLists(lists);
+   
+   //one thread formats straight into the writer
+   if ( threads <= 1 )
+   {
+      for (size_t l = 0; l < lists.size(); l++)
+         lists[l]->writeFormatted<BEFORE, AFTER>(writer, vocabulary, words);
+      return;
+   }
+   
+   //split the rows into ranges of about the same size, several per thread
+   size_t numRows = 0;
+   for (size_t l = 0; l < lists.size(); l++)
+      numRows += lists[l]->size();
+   size_t rowsPerRange = max(MIN_RANGE_ROWS, numRows / ((size_t)threads * RANGES_PER_THREAD) + 1);
+   vector<OutputRange> ranges;
+   splitRanges(lists, rowsPerRange, ranges);
+   
+   //anything already in the writer comes before the ranges
+   writer.flush();
+   
+   //index of the range whose turn it is to be written
+   size_t nextRange = 0;
+   mutex turnMutex;
+   condition_variable turnChanged;
+   
+   //ranges are handed out in order, so every range before this one is already being formatted and its turn will come
+   TaskRunner::run(threads, ranges.size(), [&](size_t r)
+   {
+      OutputWriter rangeWriter(writer.getFileDescriptor());
+      rangeWriter.setHold(true);
+      rangeWriter.setColumns(maxPreKeyLen, maxKeyLen, maxPostKeyLen);
+      rangeWriter.setDocumentColumn(writer.getDocumentColumn());
+      
+      //format the range, moving on to the next list at the end of each one
+      size_t l = ranges[r].firstList;
+      ContextList::Reader reader = ranges[r].reader;
+      uint64_t position;
+      for (size_t row = 0; row < ranges[r].numRows; row++)
+      {
+         while ( !reader.next(position) )
+            reader = ContextList::Reader(*lists[++l]);
+         ListNode<BEFORE, AFTER> context(words, position);
+         rangeWriter.writeRow<BEFORE, AFTER>(context.getContext(), vocabulary, context.getDocument());
+      }
+      
+      //wait for the ranges before this one to be written, then write this one
+      unique_lock<mutex> lock(turnMutex);
+      turnChanged.wait(lock, [&]() { return nextRange == r; });
+      rangeWriter.flush();
+      writer.addBytesWritten(rangeWriter.getBytesWritten());
+      nextRange++;
+      turnChanged.notify_all();
+   });
+}
+
+/** Writes the rows of the keywords a query matches in alphabetical order, from the context lists in memory.
+@param writer The OutputWriter to write the rows to, with its columns set.
+@param query The keywords to write.
+@pre none
+@post The rows of every matching keyword will be written in alphabetical order, and in corpus order within a keyword. */
+template <int BEFORE, int AFTER>
+void WindowedConcordance<BEFORE, AFTER>::writeMatchingRows(OutputWriter& writer, const KeyQuery& query) const
+{
+   vector<const ContextList*> lists;
+   matchingLists(query, lists);
+   for (size_t l = 0; l < lists.size(); l++)
+      lists[l]->writeFormatted<BEFORE, AFTER>(writer, vocabulary, words);
+}
+
+/**Splits the rows of the concordance into ranges with about the same number of rows.
+@param lists The context lists in alphabetical order.
+@param rowsPerRange The number of rows in each range but the last.
+@param ranges The vector to store the ranges in.
+@pre rowsPerRange must be at least 1.
+@post ranges will cover every row in order. A long context list may be split between ranges. */
+template <int BEFORE, int AFTER>
+void WindowedConcordance<BEFORE, AFTER>::splitRanges(const vector<const ContextList*>& lists, size_t rowsPerRange, vector<OutputRange>& ranges)
+{
+   ranges.clear();
+   typedef ContextList::Reader Reader;
+   OutputRange range = {0, lists.empty() ? Reader() : Reader(*lists[0]), 0};
+   
+   for (size_t l = 0; l < lists.size(); l++)
+   {
+      Reader reader(*lists[l]);
+      size_t rowsLeft = lists[l]->size();
+      
+      //the rest of the list does not fit in the range, skip to where the range ends
+      while ( range.numRows + rowsLeft >= rowsPerRange )
+      {
+         size_t taken = rowsPerRange - range.numRows;
+         reader.skip(taken);
+         rowsLeft -= taken;
+         range.numRows = rowsPerRange;
+         ranges.push_back(range);
+         
+         //the next range starts after the rows taken, possibly at the end of this list
+         range = {l, reader, 0};
+      }
+      range.numRows += rowsLeft;
+   }
+   
+   if ( range.numRows > 0 )
+      ranges.push_back(range);
+}
+
+/**Adds the keyword at a position the same way add does, timing each stage into the attached RunStats.
+@param position The position of the keyword in the word stream.
+@pre A RunStats must be attached.
+@post The keyword and position will be added as by add, and the time of each stage will be recorded. */
+template <int BEFORE, int AFTER>
+void WindowedConcordance<BEFORE, AFTER>::addSampled(uint64_t position)
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   chrono::steady_clock::time_point ends[RunStats::NUM_ADD_STAGES];
+   numKeywordsRead++;
+   keyPosition = position;
+   
+   removePunctAndLower(vocabulary.getWord(*words.getWords(position)), cleanedKey);
+   ends[RunStats::NORMALIZE] = chrono::steady_clock::now();
+   
+   bool isStop = stopWords && isStopWord(cleanedKey);
+   ends[RunStats::STOP_WORD_FILTER] = chrono::steady_clock::now();
+   
+   if ( !isStop )
+      findOrInsert(cleanedKey).add(position);
+   else
+      numStopWordHits++;
+   setMaxLengths(position);
+   ends[RunStats::INSERT] = chrono::steady_clock::now();
+   
+   stats->addSample(start, ends);
+}
+
+//compile the WindowedConcordance of every window
+#define INSTANTIATE(BEFORE, AFTER) template class WindowedConcordance<BEFORE, AFTER>;
+FOR_EACH_WINDOW(INSTANTIATE)
+#undef INSTANTIATE
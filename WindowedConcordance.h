@@ -0,0 +1,176 @@
+/*
+file name: WindowedConcordance.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the WindowedConcordance class. The WindowedConcordance class is the base class of the concordance engines for one size of context, BEFORE words before the keyword and AFTER words after it. It reads the corpus into the word stream, adds the position of each keyword to its context list, keeps the maximum column lengths up to date, and writes the rows of the context lists in alphabetical order. Each text in the word stream is set off by PADDING empty words, so the context of every keyword is the run of words around its position. Since the window is a template parameter, the rows read back from the word stream, the loops over them and the row formatting all have a fixed size, and choosing a window costs nothing per word. Derived classes decide how the keywords and their context lists are indexed and how they are put in alphabetical order for printing. The rows of every engine can also be read one at a time through a RowCursor, which visits the keywords with the KeyWalk each derived class gives.
+*/
+
+#ifndef WINDOWEDCONCORDANCE_H
+#define WINDOWEDCONCORDANCE_H
+
+#include "Concordance.h"
+#include "RowCursor.h"
+
+template <int BEFORE, int AFTER>
+class WindowedConcordance : public Concordance
+{
+   
+public:
+   
+   typedef typename ListNode<BEFORE, AFTER>::contextArr contextArr; //the context of a keyword, with the keyword at index BEFORE
+   
+   static constexpr int PADDING = BEFORE > AFTER ? BEFORE : AFTER; //empty words between the texts of the word stream
+   
+   /** The default constructor for the WindowedConcordance class.
+   Constructs an empty concordance with an empty word stream. */
+   WindowedConcordance();
+   
+   /** Returns the number of context words before each keyword.
+   @return BEFORE. */
+   int getWordsBefore() const override;
+   
+   /** Returns the number of context words after each keyword.
+   @return AFTER. */
+   int getWordsAfter() const override;
+   
+   /**Adds every word of a corpus, with its context, to the concordance.
+   @param reader The CorpusReader the corpus is open in.
+   @param threads The number of threads to read the corpus on.
+   @pre threads must be at least 1, and the concordance must be empty if it is more. The stop words must already be set.
+   @post Every word of the corpus that is not a lone punctuation symbol will have been added as a keyword with its context, in corpus order. */
+   void addCorpus(CorpusReader& reader, int threads) override;
+   
+   /**Adds every word of a list of documents, with its context, to the concordance, numbering the documents from 1 in the order given.
+   @param documents The names of the document files.
+   @param threads The number of threads to read the documents on.
+   @param unreadable Set to the name of the first document that could not be opened.
+   @return True if every document was read, false if one could not be opened.
+   @pre threads must be at least 1, and the concordance must be empty if it is more. The stop words must already be set.
+   @post Every word of each document that is not a lone punctuation symbol will have been added as a keyword with its context and the number of its document. No context reaches across the end of a document, and the contexts of a keyword are in document order, then in the order they appear in the document. */
+   bool addDocuments(const vector<string>& documents, int threads, string& unreadable) override;
+   
+   /**Starts a new text in the word stream, so no context reaches back into the text before it.
+   @return The position the first word of the text will have.
+   @pre none
+   @post If the word stream is empty, PADDING empty words will have been appended to it. Otherwise the empty words after the last text already set it off. */
+   uint64_t startText();
+   
+   /**Appends a word from the corpus to the word stream.
+   @param word The word, as it appears in the corpus.
+   @return The position of the word in the word stream.
+   @pre word must not be a lone punctuation symbol.
+   @post The word will be interned in the Vocabulary and appended to the word stream. It is not a keyword until its position is added. */
+   uint64_t appendWord(string_view word);
+   
+   /**Ends the text being read into the word stream, so no context reaches past its last word.
+   @pre none
+   @post PADDING empty words will have been appended to the word stream. */
+   void endText();
+   
+   /**Adds the keyword at a position of the word stream to the concordance, or updates the keyword's context list with the position if the keyword has already been added.
+   @param position The position of the keyword in the word stream.
+   @return True if the keyword could be added to the concordance or the keyword already exists and the context list was updated. False otherwise
+   @pre The word stream must hold the BEFORE words before the position and the AFTER words after it. Keywords must be added in order of their positions.
+   @post If the addition was successful, the keyword, stripped of punctuation and lowercase, and the position will be added to the concordance. Or if the keyword already exists the context list will be updated with the position. If the context of the keyword contains the longest pre-key context, post-key context, and/or keyword, the maximum lengths for these values will be updated.*/
+   bool add(uint64_t position);
+   
+   /**Moves a list of contexts to the end of a keyword's context list, adding the keyword first if it is not in the concordance yet.
+   @param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+   @param contexts The contexts of the keyword, as positions of another word stream that was appended to this concordance's.
+   @param shift The number added to a position of the other word stream to give its position in this concordance's, as returned by placeWords.
+   @pre The contexts must come after the keyword's existing contexts in the corpus.
+   @post If the keyword is not a stop word, the contexts will be moved to the end of its context list, shifted, and contexts will be empty. If it is a stop word, contexts is left unchanged. */
+   void appendContexts(const string& keyWord, ContextList& contexts, int64_t shift);
+   
+   /** Updates the maximum lengths of the pre-key context length, the key length, and the post-key context length.
+   @param position The position of the keyword in the word stream.
+   @pre The word stream must hold the BEFORE words before the position and the AFTER words after it.
+   @post If any of the lengths in the context of the keyword are greater than the current maximum lengths, the maximum length(s) will be updated with the appropriate length(s) in the context. If no lengths in the context are greater, the maximum lengths will remain the same.
+    */
+   void setMaxLengths(uint64_t position);
+   
+   /**Returns a cursor at the first row of the concordance.
+   @return A cursor over the rows in alphabetical order based on the keyword, and in corpus order within a keyword.
+   @pre The concordance must not be changed while the cursor is used. The cursor only reads the context lists in memory, so a SpillConcordance that has spilled runs to disk must be printed with writeConcordance instead.
+   @post The cursor will be at the first context of the first keyword, or at its end if the concordance is empty. The cursor walks the engine's own ordered structure with walkKeys, so no list is collected and no row is read before it is asked for. */
+   RowCursor<BEFORE, AFTER> rowCursor() const;
+   
+   /**Returns a cursor at the first row of the keywords a query matches.
+   @param query The keywords to visit.
+   @return A cursor over the rows of the matching keywords in alphabetical order, and in corpus order within a keyword.
+   @pre The concordance must not be changed, and the query must not be destroyed, while the cursor is used. The cursor only reads the context lists in memory, so a SpillConcordance that has spilled runs to disk must be printed with writeMatches instead.
+   @post The cursor will be at the first context of the first matching keyword, or at its end if nothing matches. */
+   RowCursor<BEFORE, AFTER> matchingRowCursor(const KeyQuery& query) const;
+   
+protected:
+   /**Finds the context list of a keyword, adding the keyword with an empty context list first if it is not in the concordance yet.
+   @param keyWord A keyword from the corpus, stripped of punctuation and lowercase.
+   @return The keyword's context list.
+   @pre The keyword must not be a stop word.
+   @post The keyword will be in the concordance. New contexts added to the list returned will come after its existing contexts. */
+   virtual ContextList& findOrInsert(const string& keyWord) = 0;
+   
+   /** Collects the context list of each keyword in alphabetical order.
+   @param lists The vector to store the context lists in.
+   @pre none
+   @post lists will hold a pointer to the context list of every keyword, in alphabetical order based on the keyword. The pointers stay valid until the concordance is changed. */
+   virtual void sortedLists(vector<const ContextList*>& lists) const = 0;
+   
+   /** Writes the rows of every keyword in alphabetical order, from the context lists in memory.
+   @param writer The OutputWriter to write the rows to, with its columns set.
+   @param threads The number of threads to format the rows on.
+   @pre threads must be at least 1.
+   @post The rows of every keyword will be written in alphabetical order, and in corpus order within a keyword. With more than one thread, the rows are split into ranges that are formatted in parallel and written to the writer's file descriptor strictly in order. */
+   void writeRows(OutputWriter& writer, int threads) const override;
+   
+   /** Collects the context lists of the keywords a query matches, in alphabetical order.
+   @param query The keywords to collect.
+   @param lists The vector to store the context lists in.
+   @pre none
+   @post lists will hold a pointer to the context list of every matching keyword, in alphabetical order based on the keyword. The pointers stay valid until the concordance is changed. */
+   virtual void matchingLists(const KeyQuery& query, vector<const ContextList*>& lists) const = 0;
+   
+   /** Starts a walk over the keywords a query matches, in alphabetical order.
+   @param query The keywords to visit, or nullptr to visit every keyword.
+   @return A new walk at the first matching keyword, which the caller must delete.
+   @pre The concordance must not be changed, and the query must not be destroyed, while the walk is used.
+   @post The walk will hold only its place in the engine's ordered structure. */
+   virtual KeyWalk* walkKeys(const KeyQuery* query) const = 0;
+   
+   /** Writes the rows of the keywords a query matches in alphabetical order, from the context lists in memory.
+   @param writer The OutputWriter to write the rows to, with its columns set.
+   @param query The keywords to write.
+   @pre none
+   @post The rows of every matching keyword will be written in alphabetical order, and in corpus order within a keyword. */
+   void writeMatchingRows(OutputWriter& writer, const KeyQuery& query) const override;
+   
+   uint64_t keyPosition; //position of the keyword being added, the words more than BEFORE before it are in no context still to be added
+   
+private:
+   static constexpr size_t MIN_RANGE_ROWS = 4096; //rows formatted by a thread at once when printing in parallel, at least
+   static constexpr int RANGES_PER_THREAD = 16; //more ranges than threads, so the threads finish close together
+   
+   //a run of rows printed by one thread, starting at the reader's position in the list at firstList and continuing into the lists after it
+   struct OutputRange
+   {
+      size_t firstList; //index of the list the range starts in
+      ContextList::Reader reader; //reads the list from the first row of the range
+      size_t numRows; //number of rows in the range
+   };
+   
+   /**Splits the rows of the concordance into ranges with about the same number of rows.
+   @param lists The context lists in alphabetical order.
+   @param rowsPerRange The number of rows in each range but the last.
+   @param ranges The vector to store the ranges in.
+   @pre rowsPerRange must be at least 1.
+   @post ranges will cover every row in order. A long context list may be split between ranges. */
+   void static splitRanges(const vector<const ContextList*>& lists, size_t rowsPerRange, vector<OutputRange>& ranges);
+   
+   /**Adds the keyword at a position the same way add does, timing each stage into the attached RunStats.
+   @param position The position of the keyword in the word stream.
+   @pre A RunStats must be attached.
+   @post The keyword and position will be added as by add, and the time of each stage will be recorded. */
+   void addSampled(uint64_t position);
+};
+
+#endif
@@ -0,0 +1,122 @@
+/*
+file name: WordStream.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the WordStream class. A WordStream holds the words a concordance has read, in corpus order, as IDs in the concordance's Vocabulary, so the context of a keyword is just its position in the stream: the words on either side of it. Each text in the stream is set off by empty words, so a context never reaches into the text before or after it. The stream also records where each document starts, so the document of a position can be looked up instead of being stored with every context. Positions count from the first word ever appended, and stay valid when the words before a position are discarded.
+*/
+
+#ifndef WORDSTREAM_H
+#define WORDSTREAM_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Vocabulary.h"
+
+using namespace std;
+
+class WordStream
+{
+public:
+
+   /** The default constructor for the WordStream class.
+   Constructs an empty stream whose first word will be at position 0, in document 0. */
+   WordStream();
+
+   /**Appends a word to the end of the stream.
+   @param word The ID of the word.
+   @return The position of the word.
+   @pre none
+   @post The word will be the last word of the stream. */
+   uint64_t append(Vocabulary::wordId word);
+
+   /**Appends empty words to the end of the stream.
+   @param count The number of empty words.
+   @pre none
+   @post The stream will end with count copies of Vocabulary::EMPTY_WORD. */
+   void appendEmpty(uint64_t count);
+
+   /**Makes room at the end of the stream for a run of words of another stream, to be filled in by remapRun.
+   @param other The stream the words will be copied from.
+   @param first The position in other of the first word copied.
+   @param last The position in other one past the last word copied.
+   @return The number added to a position in other to give the position of the same word in this stream.
+   @pre other must hold every position from first up to last, and must not be this stream.
+   @post The stream will end with last - first empty words, in the documents of the run. */
+   int64_t appendRun(const WordStream& other, uint64_t first, uint64_t last);
+   
+   /**Copies a run of words of another stream into the room made for it by appendRun, replacing each with its ID in another Vocabulary.
+   @param other The stream the words are copied from.
+   @param first The position in other of the first word copied.
+   @param last The position in other one past the last word copied.
+   @param shift The number returned by appendRun for the run.
+   @param newIds The ID of each word in this stream's Vocabulary, indexed by its ID in other's.
+   @pre appendRun must have made room for the run, and no words may have been discarded since. Runs that do not overlap may be copied on different threads at once, as long as nothing is appended meanwhile.
+   @post The room will hold the words of the run. */
+   void remapRun(const WordStream& other, uint64_t first, uint64_t last, int64_t shift, const vector<Vocabulary::wordId>& newIds);
+   
+   /**Sets aside memory for words to be appended, so the stream is not copied as it grows.
+   @param count The number of words the stream will hold beyond those it holds now.
+   @pre none
+   @post Appending up to count words will not move the stream. */
+   void reserve(uint64_t count);
+
+   /**Marks the start of a document.
+   @param document The number of the document, counting from 1.
+   @pre none
+   @post The words appended from now on will be in the document. */
+   void startDocument(uint32_t document);
+
+   /**Returns the number of the document a word was read from.
+   @param position The position of the word.
+   @return The number of the document, 0 for a single corpus.
+   @pre none
+   @post The stream is unchanged. */
+   uint32_t getDocument(uint64_t position) const;
+
+   /**Returns the words from a position on.
+   @param position The position of the first word.
+   @return A pointer to the word, followed in memory by the words after it.
+   @pre The stream must hold the position. The pointer is only valid until words are appended or discarded.
+   @post The stream is unchanged. */
+   const Vocabulary::wordId* getWords(uint64_t position) const;
+
+   /**Returns the position of the first word still held.
+   @return The position of the first word not discarded.
+   @pre none
+   @post The position will be returned as a uint64_t. */
+   uint64_t getFirst() const;
+
+   /**Returns the position after the last word.
+   @return The position the next word appended will have.
+   @pre none
+   @post The position will be returned as a uint64_t. */
+   uint64_t getEnd() const;
+
+   /**Discards the words before a position, to free their memory.
+   @param position The position of the first word to keep.
+   @pre position must be at most getEnd().
+   @post The stream will only hold the positions from position on, which keep their numbers. Document starts are kept. */
+   void discardBefore(uint64_t position);
+
+   /**Returns the memory held by the stream.
+   @return The number of bytes allocated for the words and the document starts.
+   @pre none
+   @post The size will be returned as a size_t. */
+   size_t getBytes() const;
+
+private:
+
+   //the position of the first word of a document
+   struct DocumentStart
+   {
+      uint64_t position; //position of the first word of the document
+      uint32_t document; //number of the document
+   };
+
+   vector<Vocabulary::wordId> words; //the words held, the first at position firstPosition
+   uint64_t firstPosition; //position of words[0]
+   vector<DocumentStart> documents; //the document starts in order of position
+};
+
+#endif
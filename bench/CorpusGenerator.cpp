@@ -0,0 +1,154 @@
+/*
+file name: CorpusGenerator.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The implementation file for the CorpusGenerator class. A CorpusGenerator writes a synthetic corpus for the benchmarks from a fixed seed, so every run measures the same text. The keywords are drawn from a made-up vocabulary, either with Zipfian frequencies like natural text or in alphabetical or reverse alphabetical order, which gives every token a new key in order, the worst case for a search tree. A set share of the tokens are built-in stop words, and some words are capitalized or carry punctuation, so the cleaning and stop word paths see realistic input.
+*/
+
+#include "CorpusGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+#include "StopWordSet.h"
+
+using namespace std;
+
+/** Constructor for the CorpusGenerator class that accepts the shape of the corpus.
+Makes the vocabulary the corpus is drawn from.
+@param options The shape of the corpus.
+@pre options.vocabularySize must be at least 1, the ratios must be from 0 to 1. */
+CorpusGenerator::CorpusGenerator(const Options& options) : options(options), random(options.seed)
+{
+   makeVocabulary();
+}
+
+/**Generates the corpus.
+@param corpus Set to the text of the corpus, words separated by spaces and broken into lines.
+@pre none
+@post The corpus will hold options.numTokens words. The same options always give the same corpus. */
+void CorpusGenerator::generate(string& corpus)
+{
+   const string TRAILING = ",.;:!?";
+   const string LONE = "-&";
+   size_t numStopWords = StopWordSet::getNumBuiltInWords();
+
+   corpus.clear();
+   corpus.reserve((size_t)options.numTokens * 7);
+
+   uint64_t numKeys = 0;
+   int wordsLeftInLine = 0;
+   for (uint64_t t = 0; t < options.numTokens; t++)
+   {
+      //break the text into lines of 8 to 15 words
+      if ( t != 0 )
+      {
+         if ( wordsLeftInLine == 0 )
+         {
+            corpus += '\n';
+            wordsLeftInLine = 8 + (int)(random() % 8);
+         }
+         else
+            corpus += ' ';
+      }
+      wordsLeftInLine--;
+
+      //some of the punctuation is lone symbols, which are not words of the concordance
+      if ( nextUnit() < options.punctRatio / 4 )
+      {
+         corpus += LONE[random() % LONE.size()];
+         continue;
+      }
+
+      size_t wordStart = corpus.size();
+      if ( nextUnit() < options.stopWordRatio )
+         corpus += StopWordSet::getBuiltInWord((size_t)(random() % numStopWords));
+      else
+         corpus += words[nextRank(numKeys++)];
+
+      //capitalize about one word in 10, as at the start of sentences and in names
+      if ( nextUnit() < 0.1 )
+         corpus[wordStart] = (char)(corpus[wordStart] - 'a' + 'A');
+
+      //punctuation before or after the word, which is cleaned off the keyword
+      if ( nextUnit() < options.punctRatio )
+      {
+         if ( random() % 4 == 0 )
+            corpus.insert(wordStart, 1, '"');
+         else
+            corpus += TRAILING[random() % TRAILING.size()];
+      }
+   }
+   corpus += '\n';
+}
+
+/**Returns the vocabulary the keywords are drawn from.
+@return The words, lowercase and without punctuation, in order of their rank.
+@pre none
+@post The vocabulary will be returned as a vector of strings. */
+const vector<string>& CorpusGenerator::getVocabulary() const
+{
+   return words;
+}
+
+/**Makes the vocabulary, random lowercase words of 2 to 14 letters that are not stop words.
+@pre none
+@post words will hold options.vocabularySize distinct words, and cumulativeWeights their Zipfian weights. */
+void CorpusGenerator::makeVocabulary()
+{
+   //the stop words are drawn separately, so no keyword may be one
+   unordered_set<string> used;
+   for (size_t w = 0; w < StopWordSet::getNumBuiltInWords(); w++)
+      used.emplace(StopWordSet::getBuiltInWord(w));
+
+   words.clear();
+   while ( words.size() < options.vocabularySize )
+   {
+      //lengths peak around 6 letters, as in English text
+      int length = 2 + (int)(random() % 5) + (int)(random() % 5) + (int)(random() % 4);
+      string word;
+      for (int i = 0; i < length; i++)
+         word += (char)('a' + random() % 26);
+      if ( used.insert(word).second )
+         words.push_back(word);
+   }
+
+   alphabetical.resize(words.size());
+   for (size_t r = 0; r < words.size(); r++)
+      alphabetical[r] = r;
+   sort(alphabetical.begin(), alphabetical.end(), [&](size_t a, size_t b) { return words[a] < words[b]; });
+
+   cumulativeWeights.resize(words.size());
+   double total = 0;
+   for (size_t r = 0; r < words.size(); r++)
+   {
+      total += 1.0 / pow((double)(r + 1), options.zipfExponent);
+      cumulativeWeights[r] = total;
+   }
+}
+
+/**Draws the rank of the next keyword.
+@param position The position of the keyword among the keywords drawn so far.
+@return The rank of the keyword in the vocabulary.
+@pre none
+@post The rank will be drawn as options.order asks. */
+size_t CorpusGenerator::nextRank(uint64_t position)
+{
+   size_t cycle = (size_t)(position % words.size());
+   if ( options.order == SORTED )
+      return alphabetical[cycle];
+   if ( options.order == REVERSE )
+      return alphabetical[words.size() - 1 - cycle];
+
+   //the first rank whose running weight reaches a uniform draw over the total weight
+   double target = nextUnit() * cumulativeWeights.back();
+   size_t rank = (size_t)(upper_bound(cumulativeWeights.begin(), cumulativeWeights.end(), target) - cumulativeWeights.begin());
+   return min(rank, words.size() - 1);
+}
+
+/**Draws a number between 0 and 1.
+@return The number, 1 excluded. */
+double CorpusGenerator::nextUnit()
+{
+   return (double)(random() >> 11) * (1.0 / 9007199254740992.0);
+}
@@ -0,0 +1,85 @@
+/*
+file name: CorpusGenerator.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The header file for the CorpusGenerator class. A CorpusGenerator writes a synthetic corpus for the benchmarks from a fixed seed, so every run measures the same text. The keywords are drawn from a made-up vocabulary, either with Zipfian frequencies like natural text or in alphabetical or reverse alphabetical order, which gives every token a new key in order, the worst case for a search tree. A set share of the tokens are built-in stop words, and some words are capitalized or carry punctuation, so the cleaning and stop word paths see realistic input.
+*/
+
+#ifndef CORPUSGENERATOR_H
+#define CORPUSGENERATOR_H
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+using namespace std;
+
+class CorpusGenerator
+{
+public:
+
+   //the order the keywords of the corpus are drawn in
+   enum Order
+   {
+      ZIPF, //at random, the word of rank r with weight 1 / r^zipfExponent
+      SORTED, //every word of the vocabulary in alphabetical order, over and over
+      REVERSE //every word of the vocabulary in reverse alphabetical order, over and over
+   };
+
+   //the shape of the corpus
+   struct Options
+   {
+      uint64_t numTokens = 1000000; //number of words in the corpus, stop words and punctuation included
+      size_t vocabularySize = 50000; //number of distinct keywords, before capitals and punctuation
+      double zipfExponent = 1.0; //skew of the ZIPF order, 0 for uniform
+      Order order = ZIPF; //order the keywords are drawn in
+      double stopWordRatio = 0.3; //share of the tokens that are built-in stop words
+      double punctRatio = 0.05; //share of the words given punctuation, some as lone punctuation tokens
+      uint64_t seed = 1; //seed of the random number generator
+   };
+
+   /** Constructor for the CorpusGenerator class that accepts the shape of the corpus.
+   Makes the vocabulary the corpus is drawn from.
+   @param options The shape of the corpus.
+   @pre options.vocabularySize must be at least 1, the ratios must be from 0 to 1. */
+   CorpusGenerator(const Options& options);
+
+   /**Generates the corpus.
+   @param corpus Set to the text of the corpus, words separated by spaces and broken into lines.
+   @pre none
+   @post The corpus will hold options.numTokens words. The same options always give the same corpus. */
+   void generate(string& corpus);
+
+   /**Returns the vocabulary the keywords are drawn from.
+   @return The words, lowercase and without punctuation, in order of their rank.
+   @pre none
+   @post The vocabulary will be returned as a vector of strings. */
+   const vector<string>& getVocabulary() const;
+
+private:
+
+   /**Makes the vocabulary, random lowercase words of 2 to 14 letters that are not stop words.
+   @pre none
+   @post words will hold options.vocabularySize distinct words, and cumulativeWeights their Zipfian weights. */
+   void makeVocabulary();
+
+   /**Draws the rank of the next keyword.
+   @param position The position of the keyword among the keywords drawn so far.
+   @return The rank of the keyword in the vocabulary.
+   @pre none
+   @post The rank will be drawn as options.order asks. */
+   size_t nextRank(uint64_t position);
+
+   /**Draws a number between 0 and 1.
+   @return The number, 1 excluded. */
+   double nextUnit();
+
+   Options options; //the shape of the corpus
+   mt19937_64 random; //the random number generator, seeded from options.seed
+   vector<string> words; //the vocabulary, in order of rank
+   vector<size_t> alphabetical; //the ranks of the words in alphabetical order
+   vector<double> cumulativeWeights; //running sums of the Zipfian weights of the ranks
+};
+
+#endif
@@ -0,0 +1,490 @@
+/*
+file name: concordance_bench.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: Benchmark suite for the concordance. A CorpusGenerator writes a synthetic corpus from a fixed seed, then each stage of building and printing the concordance is timed on its own: splitting the corpus into words, interning them in the Vocabulary, appending them to the WordStream, cleaning keywords with removePunctAndLower, checking them with isStopWord, sorting the distinct keywords with std::sort and with the StringSort, adding the contexts to each engine (the tree's add includes its AVL insert, the trie's the bursting of its buckets), and formatting the rows. Each stage is run 3 times on the same input and the fastest run is reported. Finally the concordance program itself is run end to end on the corpus with each engine, started as a process of its own, and its tokens per second, rows per second and peak resident memory are reported. Nothing is written to standard output but the report, the rows go to /dev/null.
+ Build from the repository root:
+ cmake -S . -B build && cmake --build build --target concordance_bench
+ Options:
+ --tokens=N words in the corpus (default 1000000), --vocab=N distinct keywords (default 50000),
+ --zipf=S skew of the keyword frequencies, 0 for uniform (default 1.0),
+ --order=zipf|sorted|reverse the order keywords are drawn in, sorted and reverse give every token a new key in order (default zipf),
+ --stop-ratio=R share of stop words (default 0.3), --punct-ratio=R share of words with punctuation (default 0.05),
+ --seed=N (default 1), --threads=N threads for the parallel runs, 1 for none (default every hardware thread),
+ --mem-limit-mb=N memory limit of the spilling run, 0 for none (default 16),
+ --only=micro|end-to-end runs only one part of the suite,
+ --write-corpus=FILE writes the corpus to FILE and exits, to time the program itself on it,
+ --program=FILE the concordance program the end to end runs start (default the concordance built next to the benchmark).
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <fcntl.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "CorpusGenerator.h"
+#include "BinarySearchTree.h"
+#include "BurstTrie.h"
+#include "HashConcordance.h"
+#include "SpillConcordance.h"
+#include "CorpusReader.h"
+#include "OutputWriter.h"
+#include "ParallelIngester.h"
+#include "StringSort.h"
+#include "Vocabulary.h"
+#include "WordStream.h"
+
+using namespace std;
+
+//the environment the concordance program is started with
+extern char** environ;
+
+//number of times each stage is run, the fastest is reported
+static const int REPEATS = 3;
+
+//results are added here so the compiler cannot drop the work being timed
+static volatile size_t sink;
+
+//the stages are timed with the default window of context
+static const int WINDOW = DEFAULT_WINDOW_WORDS;
+typedef WindowedConcordance<WINDOW, WINDOW> BenchConcordance;
+typedef BinarySearchTree<WINDOW, WINDOW> BenchTree;
+typedef HashConcordance<WINDOW, WINDOW> BenchHash;
+typedef BurstTrie<WINDOW, WINDOW> BenchTrie;
+typedef SpillConcordance<WINDOW, WINDOW> BenchSpill;
+
+/**Returns the seconds since a point in time.
+@param start The point in time.
+@return The seconds passed. */
+static double secondsSince(chrono::steady_clock::time_point start)
+{
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**Runs a stage several times and returns its fastest time.
+@param run Runs the stage once and returns the seconds its timed part took, so setup can be left out.
+@return The fewest seconds of any run. */
+template <typename Function>
+static double fastest(Function run)
+{
+   double best = 0;
+   for (int r = 0; r < REPEATS; r++)
+   {
+      double seconds = run();
+      if ( r == 0 || seconds < best )
+         best = seconds;
+   }
+   return best;
+}
+
+/**Prints the time of a stage and its throughput.
+@param name The label printed for the stage.
+@param seconds The time the stage took.
+@param items The number of tokens, keywords or rows the stage handled.
+@param unit The name of the items.
+@param bytes The number of bytes of corpus the stage read, or 0 to leave out the byte rate. */
+static void report(const char* name, double seconds, double items, const char* unit, double bytes)
+{
+   printf("  %-38s %9.2f ms %12.0f %s/s", name, seconds * 1e3, items / seconds, unit);
+   if ( bytes > 0 )
+      printf(" %9.1f MB/s", bytes / seconds / 1e6);
+   printf("\n");
+}
+
+/**Times each stage of building and printing the concordance on its own.
+@param corpus The text of the corpus.
+@param threads The number of threads for the parallel formatting stage. */
+static void runMicro(string_view corpus, int threads)
+{
+   printf("stages (fastest of %d runs)\n", REPEATS);
+   double corpusBytes = (double)corpus.size();
+
+   //the words of the corpus, without lone punctuation
+   vector<string_view> tokens;
+   CorpusReader reader;
+   string_view word;
+   double seconds = fastest([&]()
+   {
+      tokens.clear();
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      reader.openText(corpus);
+      while ( reader.nextWord(word) )
+      {
+         if ( !Concordance::isPunct(word) )
+            tokens.push_back(word);
+      }
+      return secondsSince(start);
+   });
+   double numTokens = (double)tokens.size();
+   report("split words (CorpusReader)", seconds, numTokens, "tokens", corpusBytes);
+
+   //the IDs are the same in every fresh Vocabulary, since the words are interned in the same order
+   vector<Vocabulary::wordId> ids(tokens.size());
+   seconds = fastest([&]()
+   {
+      Vocabulary vocab;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (size_t t = 0; t < tokens.size(); t++)
+         ids[t] = vocab.intern(tokens[t]);
+      return secondsSince(start);
+   });
+   report("intern (Vocabulary)", seconds, numTokens, "tokens", corpusBytes);
+
+   seconds = fastest([&]()
+   {
+      WordStream stream;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      stream.appendEmpty(BenchConcordance::PADDING);
+      for (size_t t = 0; t < ids.size(); t++)
+         stream.append(ids[t]);
+      stream.appendEmpty(BenchConcordance::PADDING);
+      sink = sink + stream.getEnd();
+      return secondsSince(start);
+   });
+   report("append words (WordStream)", seconds, numTokens, "tokens", 0);
+
+   vector<string> cleaned(tokens.size());
+   seconds = fastest([&]()
+   {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (size_t t = 0; t < tokens.size(); t++)
+         Concordance::removePunctAndLower(tokens[t], cleaned[t]);
+      return secondsSince(start);
+   });
+   report("removePunctAndLower", seconds, numTokens, "tokens", corpusBytes);
+
+   //the stop words are always the built-in list, the generator draws from it
+   BenchHash stopWords;
+   stopWords.excludeStopWords("", true);
+   size_t numRows = 0;
+   seconds = fastest([&]()
+   {
+      numRows = 0;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (size_t t = 0; t < cleaned.size(); t++)
+         numRows += !stopWords.isStopWord(cleaned[t]);
+      return secondsSince(start);
+   });
+   report("isStopWord (built-in list)", seconds, numTokens, "tokens", 0);
+
+   //the distinct keywords, sorted by pointer as the engines sort their entries
+   unordered_set<string> distinct(cleaned.begin(), cleaned.end());
+   vector<const string*> keyWords;
+   for (unordered_set<string>::const_iterator it = distinct.begin(); it != distinct.end(); ++it)
+      keyWords.push_back(&*it);
+   double numKeys = (double)keyWords.size();
+   seconds = fastest([&]()
+   {
+      vector<const string*> sorted(keyWords);
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      sort(sorted.begin(), sorted.end(), [](const string* a, const string* b) { return *a < *b; });
+      sink = sink + sorted.size();
+      return secondsSince(start);
+   });
+   report("sort keywords (std::sort)", seconds, numKeys, "keys", 0);
+   seconds = fastest([&]()
+   {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      vector<StringSort::Key> keys;
+      keys.reserve(keyWords.size());
+      for (size_t k = 0; k < keyWords.size(); k++)
+         keys.push_back(StringSort::makeKey(*keyWords[k], k));
+      StringSort::sort(keys);
+      sink = sink + keys.size();
+      return secondsSince(start);
+   });
+   report("sort keywords (StringSort)", seconds, numKeys, "keys", 0);
+   cleaned = vector<string>();
+
+   //adds every keyword to a fresh engine, appending the words to its stream first so only the adds are timed
+   auto timeAdd = [&](BenchConcordance& concordance)
+   {
+      concordance.excludeStopWords("", true);
+      uint64_t firstKey = concordance.startText();
+      for (size_t t = 0; t < tokens.size(); t++)
+         concordance.appendWord(tokens[t]);
+      concordance.endText();
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (size_t t = 0; t < tokens.size(); t++)
+         concordance.add(firstKey + t);
+      return secondsSince(start);
+   };
+   seconds = fastest([&]()
+   {
+      BenchTree tree;
+      return timeAdd(tree);
+   });
+   report("add (BinarySearchTree, AVL insert)", seconds, numTokens, "tokens", 0);
+   seconds = fastest([&]()
+   {
+      BenchHash hash;
+      return timeAdd(hash);
+   });
+   report("add (HashConcordance)", seconds, numTokens, "tokens", 0);
+   seconds = fastest([&]()
+   {
+      BenchTrie trie;
+      return timeAdd(trie);
+   });
+   report("add (BurstTrie)", seconds, numTokens, "tokens", 0);
+
+   //the rows are formatted into /dev/null, so only the formatting and the sort are timed
+   int devNull = open("/dev/null", O_WRONLY);
+   auto timeFormat = [&](const Concordance& concordance, int formatThreads)
+   {
+      return fastest([&]()
+      {
+         OutputWriter writer(devNull);
+         chrono::steady_clock::time_point start = chrono::steady_clock::now();
+         concordance.writeConcordance(writer, formatThreads);
+         writer.flush();
+         return secondsSince(start);
+      });
+   };
+   {
+      BenchTree tree;
+      timeAdd(tree);
+      report("format rows (BinarySearchTree)", timeFormat(tree, 1), (double)numRows, "rows", 0);
+   }
+   {
+      BenchHash hash;
+      timeAdd(hash);
+      report("sort + format rows (HashConcordance)", timeFormat(hash, 1), (double)numRows, "rows", 0);
+      if ( threads > 1 )
+      {
+         string label = "sort + format rows (hash, " + to_string(threads) + " thr)";
+         report(label.c_str(), timeFormat(hash, threads), (double)numRows, "rows", 0);
+      }
+   }
+   {
+      BenchTrie trie;
+      timeAdd(trie);
+      report("walk + format rows (BurstTrie)", timeFormat(trie, 1), (double)numRows, "rows", 0);
+   }
+   close(devNull);
+   sink = sink + numRows;
+}
+
+/**Finds the concordance program built next to this benchmark.
+@return The path of the program, or "concordance" if the benchmark's own path cannot be read. */
+static string defaultProgram()
+{
+   char path[4096];
+   ssize_t length = readlink("/proc/self/exe", path, sizeof(path));
+   if ( length <= 0 || length == (ssize_t)sizeof(path) )
+      return "concordance";
+   string program(path, (size_t)length);
+   return program.substr(0, program.rfind('/') + 1) + "concordance";
+}
+
+/**Runs the concordance program on the corpus in a process of its own and prints its throughput and peak memory.
+@param name The label printed for the run.
+@param program The path of the concordance program.
+@param corpusFile The file holding the corpus.
+@param engine "tree", "hash", "trie" or "spill".
+@param threads The number of threads to read the corpus and format the rows on.
+@param memoryLimit The memory limit of the spill engine in bytes.
+@param numTokens The number of words in the corpus.
+@param numRows The number of rows of the concordance. */
+static void runEndToEnd(const char* name, const string& program, const string& corpusFile, const string& engine, int threads,
+                        size_t memoryLimit, double numTokens, double numRows)
+{
+   //the spill engine is the hash engine given a memory limit
+   string engineArg = engine == "spill" ? "--mem-limit=" + to_string(memoryLimit) : "--engine=" + engine;
+   string threadsArg = "--threads=" + to_string(threads);
+   const char* args[] = { program.c_str(), corpusFile.c_str(), engineArg.c_str(), threadsArg.c_str(), "--builtin-stopwords", nullptr };
+
+   //the rows go to /dev/null, the errors are left on this process's standard error
+   posix_spawn_file_actions_t actions;
+   posix_spawn_file_actions_init(&actions);
+   posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+
+   //the program is started afresh instead of forked, so its peak memory is its own and not this process's
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   pid_t pid = 0;
+   bool spawned = posix_spawn(&pid, program.c_str(), &actions, nullptr, (char* const*)args, environ) == 0;
+   posix_spawn_file_actions_destroy(&actions);
+   int status = 0;
+   struct rusage usage;
+   memset(&usage, 0, sizeof(usage));
+   if ( spawned )
+      spawned = wait4(pid, &status, 0, &usage) == pid;
+   double seconds = secondsSince(start);
+   if ( !spawned || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS )
+   {
+      printf("  %-38s failed, could not run %s\n", name, program.c_str());
+      return;
+   }
+   printf("  %-38s %9.2f ms %12.0f tokens/s %12.0f rows/s %8.1f MB peak RSS\n",
+          name, seconds * 1e3, numTokens / seconds, numRows / seconds, usage.ru_maxrss / 1024.0);
+}
+
+/**Reads the value of a numeric option.
+@param arg The command line argument.
+@param prefix The name of the option, with its leading dashes and the equals sign.
+@param value Set to the value if arg is the option.
+@return True if arg is the option, false otherwise. The program exits if the value is not a number. */
+static bool numberOption(const string& arg, const char* prefix, double& value)
+{
+   size_t length = strlen(prefix);
+   if ( arg.compare(0, length, prefix) != 0 )
+      return false;
+   char* last = nullptr;
+   value = strtod(arg.c_str() + length, &last);
+   if ( arg.length() == length || *last != '\0' || value < 0 )
+   {
+      cerr << "Invalid value for " << arg.substr(0, length - 1) << "." << endl;
+      exit( EXIT_FAILURE );
+   }
+   return true;
+}
+
+int main(int argc, char* argv[])
+{
+   CorpusGenerator::Options options;
+   int threads = ParallelIngester::hardwareThreads();
+   double memoryLimitMB = 16;
+   string only;
+   string corpusFile;
+   string program = defaultProgram();
+
+   for (int i = 1; i < argc; i++)
+   {
+      string arg = argv[i];
+      double value = 0;
+      if ( numberOption(arg, "--tokens=", value) )
+         options.numTokens = (uint64_t)value;
+      else if ( numberOption(arg, "--vocab=", value) )
+         options.vocabularySize = max((size_t)1, (size_t)value);
+      else if ( numberOption(arg, "--zipf=", value) )
+         options.zipfExponent = value;
+      else if ( numberOption(arg, "--stop-ratio=", value) )
+         options.stopWordRatio = min(value, 1.0);
+      else if ( numberOption(arg, "--punct-ratio=", value) )
+         options.punctRatio = min(value, 1.0);
+      else if ( numberOption(arg, "--seed=", value) )
+         options.seed = (uint64_t)value;
+      else if ( numberOption(arg, "--threads=", value) )
+         threads = max(1, (int)value);
+      else if ( numberOption(arg, "--mem-limit-mb=", value) )
+         memoryLimitMB = value;
+      else if ( arg == "--order=zipf" )
+         options.order = CorpusGenerator::ZIPF;
+      else if ( arg == "--order=sorted" )
+         options.order = CorpusGenerator::SORTED;
+      else if ( arg == "--order=reverse" )
+         options.order = CorpusGenerator::REVERSE;
+      else if ( arg == "--only=micro" || arg == "--only=end-to-end" )
+         only = arg.substr(7);
+      else if ( arg.compare(0, 15, "--write-corpus=") == 0 && arg.length() > 15 )
+         corpusFile = arg.substr(15);
+      else if ( arg.compare(0, 10, "--program=") == 0 && arg.length() > 10 )
+         program = arg.substr(10);
+      else
+      {
+         cerr << "Unknown option " << arg << "." << endl;
+         exit( EXIT_FAILURE );
+      }
+   }
+
+   string corpus;
+   CorpusGenerator generator(options);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   generator.generate(corpus);
+   double generateSeconds = secondsSince(start);
+
+   //the corpus is only wanted as a file
+   if ( !corpusFile.empty() )
+   {
+      ofstream out(corpusFile, ios::binary);
+      out.write(corpus.data(), (streamsize)corpus.size());
+      out.close();
+      if ( out.fail() )
+      {
+         cerr << "Corpus file could not be written." << endl;
+         exit( EXIT_FAILURE );
+      }
+      return 0;
+   }
+
+   //the counts the end to end runs report their rates with
+   double numTokens = 0;
+   double numRows = 0;
+   {
+      BenchHash stopWords;
+      stopWords.excludeStopWords("", true);
+      CorpusReader reader;
+      string_view word;
+      string cleaned;
+      reader.openText(corpus);
+      while ( reader.nextWord(word) )
+      {
+         if ( Concordance::isPunct(word) )
+            continue;
+         numTokens++;
+         Concordance::removePunctAndLower(word, cleaned);
+         numRows += !stopWords.isStopWord(cleaned);
+      }
+   }
+
+   const char* ORDER_NAMES[] = { "zipf", "sorted", "reverse" };
+   printf("corpus: %.0f tokens, %.1f MB, %zu keywords, order %s, zipf %.2f, stop words %.2f, punctuation %.2f, seed %llu\n",
+          numTokens, corpus.size() / 1e6, options.vocabularySize, ORDER_NAMES[options.order], options.zipfExponent,
+          options.stopWordRatio, options.punctRatio, (unsigned long long)options.seed);
+   printf("generated in %.2f ms, %.0f rows\n", generateSeconds * 1e3, numRows);
+
+   //the runs read the corpus from a file like the program, which is deleted once they are done
+   string path = BenchSpill::defaultSpillDirectory() + "/concordance-bench-XXXXXX";
+   int fd = mkstemp(&path[0]);
+   if ( fd < 0 || write(fd, corpus.data(), corpus.size()) != (ssize_t)corpus.size() )
+   {
+      cerr << "Could not write the corpus to " << path << "." << endl;
+      exit( EXIT_FAILURE );
+   }
+   close(fd);
+
+   //the micro benchmarks read the corpus back from the file
+   string().swap(corpus);
+
+   if ( only != "micro" )
+   {
+      printf("end to end (read, build, sort, format)\n");
+      runEndToEnd("tree engine", program, path, "tree", 1, 0, numTokens, numRows);
+      runEndToEnd("hash engine", program, path, "hash", 1, 0, numTokens, numRows);
+      runEndToEnd("trie engine", program, path, "trie", 1, 0, numTokens, numRows);
+      if ( threads > 1 )
+      {
+         string label = "hash engine, " + to_string(threads) + " threads";
+         runEndToEnd(label.c_str(), program, path, "hash", threads, 0, numTokens, numRows);
+      }
+      if ( memoryLimitMB > 0 )
+      {
+         size_t memoryLimit = max(BenchSpill::MIN_MEMORY_LIMIT, (size_t)(memoryLimitMB * (1 << 20)));
+         string label = "spill engine, " + to_string(memoryLimit >> 20) + "M limit";
+         runEndToEnd(label.c_str(), program, path, "spill", 1, memoryLimit, numTokens, numRows);
+      }
+   }
+
+   if ( only != "end-to-end" )
+   {
+      CorpusReader reader;
+      if ( !reader.open(path) )
+      {
+         cerr << "Could not read the corpus from " << path << "." << endl;
+         exit( EXIT_FAILURE );
+      }
+      runMicro(reader.getContents(), threads);
+   }
+   unlink(path.c_str());
+   return 0;
+}
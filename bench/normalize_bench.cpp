@@ -0,0 +1,196 @@
+/*
+file name: normalize_bench.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: Microbenchmark for word normalization. Times the original erase-based removePunctAndLower against each Normalizer kernel on the same generated words and reports bytes per second. Five word sets are measured: English-like words of 2-12 characters; long tokens of 16-80 characters such as URLs and hyphenated compounds, where the SIMD kernels process whole blocks, with no punctuation, light punctuation, and dense punctuation, which exercises the compaction path; and words of 2-12 characters with accented letters and Unicode quotes and dashes, which leave the ASCII fast path for the UTF-8 kernel (the legacy algorithm does not understand UTF-8, so its checksum differs there). Finally each kernel is run over a single 4 MB buffer to show its raw throughput without the per-word overhead (the legacy algorithm is quadratic, so it is left out there).
+ Build from the repository root:
+ cmake -S . -B build && cmake --build build --target normalize_bench
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "Normalizer.h"
+
+using namespace std;
+
+/**The removePunctAndLower algorithm the Normalizer replaced: erase each punctuation character, then lowercase in a second pass.
+@param word The word to be reformatted. */
+static void legacyRemovePunctAndLower(string& word)
+{
+   for (size_t i = 0; i < word.length(); i++)
+   {
+      if ( ispunct((unsigned char)word[i]) )
+         word.erase(i--, 1);
+   }
+   transform(word.begin(), word.end(), word.begin(), ::tolower);
+}
+
+/**Generates words with a fixed seed so every run measures the same input.
+@param count The number of words.
+@param minLen The shortest word length.
+@param maxLen The longest word length.
+@param punctPer96 How many characters in 96 are punctuation. About one in eight of the rest are uppercase.
+@return The generated words. */
+static vector<string> makeWords(size_t count, int minLen, int maxLen, unsigned punctPer96)
+{
+   mt19937 rng(12345);
+   const string letters = "abcdefghijklmnopqrstuvwxyz";
+   const string punct = ".,;:'\"!?-()/";
+   vector<string> words;
+   words.reserve(count);
+   for (size_t w = 0; w < count; w++)
+   {
+      int len = minLen + (int)(rng() % (unsigned)(maxLen - minLen + 1));
+      string word;
+      for (int i = 0; i < len; i++)
+      {
+         unsigned r = rng() % 96;
+         if ( r < punctPer96 )
+            word.push_back(punct[rng() % punct.size()]);
+         else if ( r < punctPer96 + 12 )
+            word.push_back((char)toupper(letters[rng() % 26]));
+         else
+            word.push_back(letters[rng() % 26]);
+      }
+      words.push_back(word);
+   }
+   return words;
+}
+
+/**Generates words of Latin, Greek and Cyrillic letters with Unicode punctuation, with a fixed seed so every run measures the same input.
+@param count The number of words.
+@param minLen The fewest characters in a word.
+@param maxLen The most characters in a word.
+@return The generated words. About one character in eight takes two or three bytes in UTF-8, and one word in four is quoted or followed by a dash. */
+static vector<string> makeUTF8Words(size_t count, int minLen, int maxLen)
+{
+   mt19937 rng(12345);
+   const string letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+   const char* wide[] = { "é", "É", "ü", "Ü", "ß", "ç", "ω", "Ω", "д", "Д", "ж", "Ж" };
+   const char* marks[] = { "«", "»", "“", "”", "—", "’" };
+   vector<string> words;
+   words.reserve(count);
+   for (size_t w = 0; w < count; w++)
+   {
+      int len = minLen + (int)(rng() % (unsigned)(maxLen - minLen + 1));
+      string word;
+      for (int i = 0; i < len; i++)
+      {
+         if ( rng() % 8 == 0 )
+            word += wide[rng() % (sizeof(wide) / sizeof(wide[0]))];
+         else
+            word.push_back(letters[rng() % letters.size()]);
+      }
+      if ( rng() % 4 == 0 )
+         word = marks[rng() % 4] + word + marks[rng() % 6];
+      words.push_back(word);
+   }
+   return words;
+}
+
+/**Runs a normalization function over every word several times and prints its throughput.
+@param name The label printed for the function.
+@param words The words to normalize.
+@param run Normalizes one word into the scratch string. */
+template <typename Function>
+static void measure(const char* name, const vector<string>& words, Function run)
+{
+   const int REPEATS = 20;
+   size_t bytes = 0;
+   size_t checksum = 0;
+   string scratch;
+   
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int r = 0; r < REPEATS; r++)
+   {
+      for (size_t w = 0; w < words.size(); w++)
+      {
+         run(words[w], scratch);
+         bytes += words[w].length();
+         checksum += scratch.length();
+      }
+   }
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   printf("  %-28s %9.1f MB/s   (checksum %zu)\n", name, bytes / seconds / 1e6, checksum);
+}
+
+/**Measures every kernel on one set of words.
+@param title The label printed for the word set.
+@param words The words to normalize. */
+static void measureAll(const char* title, const vector<string>& words)
+{
+   printf("%s\n", title);
+   measure("legacy erase + tolower", words, [](const string& word, string& out)
+   {
+      out = word;
+      legacyRemovePunctAndLower(out);
+   });
+   measure("scalar tables", words, [](const string& word, string& out)
+   {
+      out.resize(word.length());
+      out.resize(Normalizer::normalizeScalar(word.data(), word.length(), &out[0]));
+   });
+   measure("SSE2", words, [](const string& word, string& out)
+   {
+      out.resize(word.length());
+      out.resize(Normalizer::normalizeSSE2(word.data(), word.length(), &out[0]));
+   });
+   if ( Normalizer::hasAVX2() )
+   {
+      measure("AVX2", words, [](const string& word, string& out)
+      {
+         out.resize(word.length());
+         out.resize(Normalizer::normalizeAVX2(word.data(), word.length(), &out[0]));
+      });
+   }
+   measure("Normalizer::normalize", words, [](const string& word, string& out)
+   {
+      Normalizer::normalize(string_view(word), out);
+   });
+}
+
+/**Runs each kernel over one large buffer and prints its throughput.
+@param size The size of the buffer in bytes. */
+static void measureKernels(size_t size)
+{
+   //one long word with the same mix of characters as the long tokens
+   string buffer = makeWords(1, (int)size, (int)size, 2)[0];
+   vector<char> out(size);
+   
+   struct { const char* name; Normalizer::kernel run; } kernels[] =
+   {
+      { "scalar tables", Normalizer::normalizeScalar },
+      { "SSE2", Normalizer::normalizeSSE2 },
+      { "AVX2", Normalizer::normalizeAVX2 },
+   };
+   
+   printf("single %zu byte buffer\n", size);
+   for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+   {
+      if ( kernels[k].run == Normalizer::normalizeAVX2 && !Normalizer::hasAVX2() )
+         continue;
+      const int REPEATS = 50;
+      size_t checksum = 0;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int r = 0; r < REPEATS; r++)
+         checksum += kernels[k].run(buffer.data(), buffer.size(), out.data());
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      printf("  %-28s %9.1f MB/s   (checksum %zu)\n", kernels[k].name, REPEATS * (double)size / seconds / 1e6, checksum);
+   }
+}
+
+int main()
+{
+   measureAll("short words (2-12 bytes, 1 in 12 punctuation)", makeWords(1000000, 2, 12, 8));
+   measureAll("long tokens (16-80 bytes, no punctuation)", makeWords(200000, 16, 80, 0));
+   measureAll("long tokens (16-80 bytes, 1 in 48 punctuation)", makeWords(200000, 16, 80, 2));
+   measureAll("long tokens (16-80 bytes, 1 in 12 punctuation)", makeWords(200000, 16, 80, 8));
+   measureAll("UTF-8 words (2-12 characters, accented letters and Unicode punctuation)", makeUTF8Words(1000000, 2, 12));
+   measureKernels(4 << 20);
+   return 0;
+}
@@ -6,123 +6,471 @@ Problem Statement:
  Description:
  A Keyword-in-Context (KWIC) concordance is a list of keywords in body of text surrounded by its context, the series of words in which each keyword is embedded. In KWIC the concordance is displayed in a tabular form consisting of three columns. The first, second, and third columns show the context preceding the keyword, the keyword, and the context succeeding the keyword, respectively. Rows in the concordance display each instance of the keyword in context and are sorted first by alphabetizing the keywords then by the order of each keyword’s appearance in the corpus. The set of keywords of a corpus may contain all the words in the text or it may exclude certain predetermined stop words such as “a”, “the”, etc.
  Purpose:
- The program will generate a concordance from a corpus by reading from the command line a text file containing the corpus. From the file, the program will create a binary search tree of key, value pairs to collect the concordance information. Each word in the corpus, with the exclusion of stop words, will serve as a key. The context of each key will serve as the value. For this program, the context will have a length no greater than ten words (the series of 0-5 words that immediately precede the key and the series of 0-5 words that immediately succeed the key). The binary search tree will be indexed by each word (excluding stop words) in the corpus, and each tree node will contain a singly linked list holding the context information for each instance of its key’s appearance in the corpus. If available, a list of stop words will be read from a text file in the same directory in which the program is located. If no stop text file exists, the program will exclude no words from the concordance. The program will output the concordance in the KWIC format described above to cout.
+ The program will generate a concordance from a corpus by reading from the command line a text file containing the corpus. From the file, the program will create a binary search tree of key, value pairs to collect the concordance information. Each word in the corpus, with the exclusion of stop words, will serve as a key. The context of each key will serve as the value. For this program, the context will have a length no greater than ten words (the series of 0-5 words that immediately precede the key and the series of 0-5 words that immediately succeed the key). The binary search tree will be indexed by each word (excluding stop words) in the corpus, and each tree node will contain a list holding the context information for each instance of its key’s appearance in the corpus. If available, a list of stop words will be read from a text file in the same directory in which the program is located. If no stop text file exists, the program will exclude no words from the concordance. The program will output the concordance in the KWIC format described above to cout.
  Input Data:
  The program will read a text file containing the corpus as its sole command line argument. It is assumed the program will read the corpus file from the current directory.
- Stop words may be read from a file titled “stopwords.txt” located in the same directory as the program. This file will contain one stop word per line. If no stop word file exists, the concordance generated by the program will include all words from the corpus. No stop word file will be included in the program.
+ The option --engine=tree (the default), --engine=hash or --engine=trie may be given before or after the corpus file to choose how the concordance is built. All the engines produce the same output.
+ The option --threads=N reads the corpus and formats the output on N threads, or on every hardware thread if N is 0. The output is the same as with one thread, the default.
+ The option --save-index=FILE saves an index of the corpus to FILE instead of printing the concordance. The option --index=FILE, given instead of a corpus file, prints the concordance saved in FILE without reading the corpus again. The stop words are those in effect when the index was saved. The option --append=FILE, given with --index, adds the words of FILE to the end of the index's corpus instead of printing it, as if FILE had been joined to the corpus after a space, and only FILE is read. The text leaves out the stop words saved in the index, so stopwords.txt and --builtin-stopwords are not looked at.
+ The options --lookup=WORD, --prefix=TEXT and --range=FIRST..LAST print only the rows of one keyword, of the keywords starting with TEXT, or of the keywords from FIRST to LAST in alphabetical order, both included. The words given are stripped of punctuation and made lowercase like the keywords, and the rows are laid out the same as in the whole concordance. They may be used with a corpus file or with --index.
+ The option --mem-limit=SIZE keeps the concordance within about SIZE bytes of memory, given as a number with an optional K, M or G suffix and at least 1M, by spilling sorted parts of it to temporary files that are merged when it is printed. The files are written to the directory given by --spill-dir=DIR, or else to TMPDIR or /tmp, and are deleted when the program ends. The words of the corpus are still kept in memory once each, and the corpus is read on one thread. The output is the same as without a limit. The concordance is then built by the hash engine, so --engine may only be hash when --mem-limit is given.
+ The option --window=N gives each keyword a context of N words on either side instead of 5, and --window=BEFORE,AFTER gives it BEFORE words before and AFTER words after. The program is compiled for windows of 3, 5 and 10 words on either side, any other window is an error. An index keeps the window it was saved with, so with --index the window given must be the index's.
+ The option --batch reads every argument that is not an option as a document of its own: a corpus file, or a directory whose regular files, and those of the directories below it, are read in alphabetical order of their names. The documents are numbered from 1 in the order they are listed and read on the threads given by --threads, and one concordance is printed for all of them. Each row starts with the number of its document, right justified, and a space, the rows of a keyword are in document order and then in the order they appear in the document, and no context reaches across the end of a document. An index cannot be saved with --batch.
+ The option --stats writes a JSON report of the run to standard error, and --stats=FILE writes it to FILE. It gives the wall and CPU time of each phase (loading the stop words, opening the corpus, reading and adding the words, and writing the output), an estimate of the time spent cleaning keywords, checking stop words and inserting keywords, and counters such as the number of words read, distinct keywords, stop words skipped, bytes written, and the height of the tree. The standard output is the same with or without the report.
+ Stop words may be read from a file titled “stopwords.txt” located in the same directory as the program. This file will contain one stop word per line. If no stop word file exists, the concordance generated by the program will include all words from the corpus. No stop word file will be included in the program. If the option --builtin-stopwords is given and no stop words could be read from “stopwords.txt”, a list of common English stop words compiled into the program will be excluded instead.
  Words in the input stream will be defined using the following definitions:
  words are bounded by white space, if not the first or last word in the file
  the first word will start at the beginning of the input and end at the first white space
- the last word will start after white space and end when eof() is true
+ the last word will start after white space and end at the end of the file
  punctuation characters will not be considered words
  words are not case-sensitive (e.g., “key” and “Key” will be considered the same word)
  In addition, words will be cleaned of leading and trailing punctuation.
+ The corpus is read as UTF-8. Punctuation is any character in the Unicode punctuation categories, such as “ ” « » and —, as well as the ASCII symbols, and words are made lowercase with the simple case folding of Unicode (e.g., “Über” and “über” will be considered the same word). Bytes that are not valid UTF-8 are kept as they are. The columns of the output are still measured in bytes.
  Output Data:
  The concordance will be output in a KWIC format to cout. Each row in the concordance will display an instance of each keyword surrounded by its context. Rows will be sorted first by alphabetizing the keywords then by the order of each keyword’s appearance in the corpus. Keywords in each row will be formatted such that they will be aligned vertically in a column.
  Error Handling:
- The program will report an error message if no corpus file is supplied as a command line argument, the corpus file does not exist, or the corpus file could not be opened.
+ The program will report an error message if no corpus file is supplied as a command line argument, more than one corpus file is supplied without --batch, an unknown option is supplied, the corpus file or a document does not exist or could not be opened, a directory of documents could not be read, --save-index is given with --batch, an index file could not be written or opened, the window is not one the program is compiled for, the stats file could not be written, or a spill file could not be created, written or read.
  Implementation Plan:
- The program consists of the BinarySearchTree class representing a binary search tree composed of nodes from the BSTNode class. The context for each key word in the corpus will be represented by a singly linked list, the ContextList class, which is composed of ListNodes. Each ListNode contains an array, 11 elements in length, of strings (indices 0-4 will contain the 5 context words before the key, index 5 will contain the key, indices 6-10 will contain the 5 context words after the key) and a pointer to the next ListNode. Each BSTNode object holds a string, representing a key word in the corpus, a ContextList object, representing all the contexts in which the key word is found, and pointers to the left and right children in the tree. As the corpus is traversed, new key words and their context will be added as a BSTNode in the binary search tree. When a duplicate key is found, the context list will be updated by adding a new ListNode object to the ContextList in the BSTNode that contains the matching key. The concordance will be displayed using an in order traversal that prints each string array in the ContextList for each BSTNode. 
+ The program reads the corpus into one of the Concordance engines, chosen with --engine: the BinarySearchTree, a height-balanced tree of TreeNodes, the HashConcordance, or the BurstTrie, or into a SpillConcordance when a memory limit is given. Each word is interned once in the concordance's Vocabulary and appended to its WordStream, and the ContextList of each keyword holds the positions of the keyword in that stream, from which the context of each row is read back when the concordance is printed. With more than one thread, or with --batch, parts of the corpus are read into concordances of their own that are merged in corpus order. The rows are formatted by an OutputWriter. With --save-index and --index the concordance is saved to and read from a ConcordanceIndex file. The design of each class is described in its own header.
 
 */
 #include <iostream>
 #include <fstream>
 #include "BinarySearchTree.h"
+#include "BurstTrie.h"
+#include "HashConcordance.h"
+#include "CorpusReader.h"
+#include "ParallelIngester.h"
+#include "BatchIngester.h"
+#include "SpillConcordance.h"
+#include "ConcordanceIndex.h"
+#include "RunStats.h"
+#include <sys/resource.h>
 
 using namespace std;
 
-//abbreviate class name
-typedef BinarySearchTree bst;
+//the default window, whose engines hold the few members that do not depend on the window
+typedef SpillConcordance<DEFAULT_WINDOW_WORDS, DEFAULT_WINDOW_WORDS> DefaultSpillConcordance;
+typedef HashConcordance<DEFAULT_WINDOW_WORDS, DEFAULT_WINDOW_WORDS> DefaultHashConcordance;
+
+/**Creates an empty concordance engine for a window.
+@param engine The engine asked for, "tree", "hash" or "trie".
+@param memoryLimit The bytes the concordance may hold in memory before spilling to disk, 0 for no limit.
+@param spillDirectory The directory the spilled runs are written to.
+@return The new concordance, to be deleted by the caller.
+@pre engine must be "tree", "hash" or "trie".
+@post A SpillConcordance will be returned if there is a memory limit, otherwise the engine asked for. */
+template <int BEFORE, int AFTER>
+Concordance* newConcordance(const string& engine, size_t memoryLimit, const string& spillDirectory)
+{
+   if ( memoryLimit != 0 )
+      return new SpillConcordance<BEFORE, AFTER>(memoryLimit, spillDirectory);
+   else if ( engine == "hash" )
+      return new HashConcordance<BEFORE, AFTER>();
+   else if ( engine == "trie" )
+      return new BurstTrie<BEFORE, AFTER>();
+   else
+      return new BinarySearchTree<BEFORE, AFTER>();
+}
 
 int main(int argc, const char * argv[])
 {
-   //2 args needed: program name and filename
-   if ( argc != 2 )
+   //the arguments that are not options: the corpus file, or with --batch the documents and directories of documents
+   vector<string> corpusPaths;
+   
+   //true to read every corpus path as a document of its own, numbered in the rows
+   bool batchMode = false;
+   
+   //the concordance engine to build: "tree", "hash" or "trie", and whether --engine gave it
+   string engine = "tree";
+   bool engineGiven = false;
+   
+   //true to use the built-in stop word list when stopwords.txt gives no stop words
+   bool builtInStopWords = false;
+   
+   //number of threads to read the corpus on, 1 reads it in order on this thread
+   int numThreads = 1;
+   
+   //bytes the concordance may hold in memory before spilling to disk, 0 for no limit
+   size_t memoryLimit = 0;
+   
+   //directory the spilled runs are written to
+   string spillDirectory = DefaultSpillConcordance::defaultSpillDirectory();
+   
+   //number of context words before and after each keyword, and whether --window gave them
+   int wordsBefore = DEFAULT_WINDOW_WORDS;
+   int wordsAfter = DEFAULT_WINDOW_WORDS;
+   bool windowGiven = false;
+   
+   //index file to save the concordance to instead of printing it, empty for none
+   string saveIndexFile;
+   
+   //index file to print the concordance from instead of reading a corpus, empty for none
+   string indexFile;
+   
+   //text file whose words are added to the end of the index's corpus, empty for none
+   string appendFile;
+   
+   //true to write a report of the run, to statsFile or to standard error if it is empty
+   bool statsWanted = false;
+   string statsFile;
+   
+   //the kind of query, "lookup", "prefix" or "range", and its words, empty to print every keyword
+   string queryKind;
+   string queryFirst;
+   string queryLast;
+   
+   //sort the command line arguments into options and the corpus file
+   for (int i = 1; i < argc; i++)
    {
-      cerr << "Missing command line argument for corpus file." << endl;
-      exit ( EXIT_FAILURE );
+      string arg = argv[i];
+      if ( arg.compare(0, 9, "--engine=") == 0 )
+      {
+         engine = arg.substr(9);
+         engineGiven = true;
+      }
+      else if ( arg == "--builtin-stopwords" )
+         builtInStopWords = true;
+      else if ( arg == "--batch" )
+         batchMode = true;
+      else if ( arg.compare(0, 10, "--threads=") == 0 )
+      {
+         //"--threads=0" uses every hardware thread
+         char* last = nullptr;
+         long threads = strtol(arg.c_str() + 10, &last, 10);
+         if ( arg.length() == 10 || *last != '\0' || threads < 0 || threads > 1024 )
+         {
+            cerr << "Invalid thread count " << arg.substr(10) << "." << endl;
+            exit( EXIT_FAILURE );
+         }
+         numThreads = threads == 0 ? ParallelIngester::hardwareThreads() : (int)threads;
+      }
+      else if ( arg.compare(0, 12, "--mem-limit=") == 0 )
+      {
+         //a number of bytes, or of kilobytes, megabytes or gigabytes with a K, M or G suffix
+         char* last = nullptr;
+         unsigned long long limit = strtoull(arg.c_str() + 12, &last, 10);
+         int shift = 0;
+         if ( *last == 'K' || *last == 'k' )
+            shift = 10;
+         else if ( *last == 'M' || *last == 'm' )
+            shift = 20;
+         else if ( *last == 'G' || *last == 'g' )
+            shift = 30;
+         if ( shift != 0 )
+            last++;
+         if ( arg.length() == 12 || arg[12] == '-' || *last != '\0' || limit > (1ULL << 40) >> shift
+             || (limit << shift) < DefaultSpillConcordance::MIN_MEMORY_LIMIT )
+         {
+            cerr << "Invalid memory limit " << arg.substr(12) << ", expected at least 1M." << endl;
+            exit( EXIT_FAILURE );
+         }
+         memoryLimit = (size_t)(limit << shift);
+      }
+      else if ( arg.compare(0, 9, "--window=") == 0 )
+      {
+         //"--window=N" is N words on either side, "--window=BEFORE,AFTER" may differ
+         char* last = nullptr;
+         long before = strtol(arg.c_str() + 9, &last, 10);
+         long after = before;
+         if ( *last == ',' )
+            after = strtol(last + 1, &last, 10);
+         if ( arg.length() == 9 || *last != '\0' || !isCompiledWindow((int)before, (int)after) || before != (int)before || after != (int)after )
+         {
+            cerr << "Unsupported window " << arg.substr(9) << ", expected one of";
+#define LIST_WINDOW(BEFORE, AFTER) cerr << " " << BEFORE << "," << AFTER;
+            FOR_EACH_WINDOW(LIST_WINDOW)
+#undef LIST_WINDOW
+            cerr << "." << endl;
+            exit( EXIT_FAILURE );
+         }
+         wordsBefore = (int)before;
+         wordsAfter = (int)after;
+         windowGiven = true;
+      }
+      else if ( arg.compare(0, 12, "--spill-dir=") == 0 && arg.length() > 12 )
+         spillDirectory = arg.substr(12);
+      else if ( arg.compare(0, 13, "--save-index=") == 0 && arg.length() > 13 )
+         saveIndexFile = arg.substr(13);
+      else if ( arg.compare(0, 8, "--index=") == 0 && arg.length() > 8 )
+         indexFile = arg.substr(8);
+      else if ( arg.compare(0, 9, "--append=") == 0 && arg.length() > 9 )
+         appendFile = arg.substr(9);
+      else if ( arg == "--stats" || (arg.compare(0, 8, "--stats=") == 0 && arg.length() > 8) )
+      {
+         statsWanted = true;
+         statsFile = arg.length() > 8 ? arg.substr(8) : "";
+      }
+      else if ( arg.compare(0, 9, "--lookup=") == 0 || arg.compare(0, 9, "--prefix=") == 0 )
+      {
+         queryKind = arg.substr(2, 6);
+         queryFirst = arg.substr(9);
+      }
+      else if ( arg.compare(0, 8, "--range=") == 0 )
+      {
+         //the range is split at the first "..", the words on either side are its first and last keywords
+         size_t dots = arg.find("..", 8);
+         if ( dots == string::npos )
+         {
+            cerr << "Invalid range " << arg.substr(8) << ", expected FIRST..LAST." << endl;
+            exit( EXIT_FAILURE );
+         }
+         queryKind = "range";
+         queryFirst = arg.substr(8, dots - 8);
+         queryLast = arg.substr(dots + 2);
+      }
+      else if ( arg.compare(0, 2, "--") == 0 )
+      {
+         cerr << "Unknown option " << arg << "." << endl;
+         exit( EXIT_FAILURE );
+      }
+      else
+         corpusPaths.push_back(arg);
    }
-   else
+   
+   //many corpus files are only read as separate documents
+   if ( corpusPaths.size() > 1 && !batchMode )
    {
-      //number of words that have been read from the corpus text
-      int wordCount = 0;
-      
-      //name of the stopword file
-      const string STOP_WORD_FILE = "stopwords.txt";
-      
-      //the concordance to add words and their contexts to
-      bst concordance;
-      
-      //array of context words, including keyword at index 5
-      ListNode::contextArr theContext;
+      cerr << "Only one corpus file may be given." << endl;
+      exit( EXIT_FAILURE );
+   }
+   
+   //the words of a query are cleaned the same way as the keywords
+   Concordance::removePunctAndLower(queryFirst);
+   Concordance::removePunctAndLower(queryLast);
+   KeyQuery query = queryKind == "prefix" ? KeyQuery::prefix(queryFirst)
+      : queryKind == "range" ? KeyQuery::range(queryFirst, queryLast) : KeyQuery::exact(queryFirst);
+   
+   //name of the stopword file
+   const string STOP_WORD_FILE = "stopwords.txt";
+   
+   //the phases and counters of the run, reported at the end if --stats was given
+   RunStats stats;
+   auto reportStats = [&]()
+   {
+      if ( !statsWanted )
+         return;
+      struct rusage usage;
+      if ( getrusage(RUSAGE_SELF, &usage) == 0 )
+         stats.setCounter("peak_rss_bytes", (double)usage.ru_maxrss * 1024);
+      if ( !stats.write(statsFile) )
+      {
+         cerr << "Stats file could not be written." << endl;
+         exit( EXIT_FAILURE );
+      }
+   };
+   
+   if ( !appendFile.empty() && indexFile.empty() )
+   {
+      cerr << "An index file must be given with --append." << endl;
+      exit( EXIT_FAILURE );
+   }
+   
+   //a saved index is printed as it is, without a corpus
+   if ( !indexFile.empty() )
+   {
+      if ( !corpusPaths.empty() || !saveIndexFile.empty() || batchMode )
+      {
+         cerr << "A corpus file cannot be given with --index." << endl;
+         exit( EXIT_FAILURE );
+      }
       
-      //the word to read from the corpus file
-      string word;
-         
-      //if stopwords.txt is found, exclude stop words from concordance
-      concordance.excludeStopWords(STOP_WORD_FILE);
+      ConcordanceIndex index;
+      stats.startPhase("open_index");
+      if ( !index.open( indexFile ) )
+      {
+         cerr << "Index file could not be opened." << endl;
+         exit( EXIT_FAILURE );
+      }
+      stats.endPhase();
       
-      //open the corpus file entered as second command line argument
-      ifstream fileReader( argv[1] );
-
-      //if fileReader has not successfully opened the file
-      if ( !fileReader.is_open() )
+      //the rows of an index are rebuilt with the window it was saved with
+      if ( windowGiven && (wordsBefore != index.getWordsBefore() || wordsAfter != index.getWordsAfter()) )
       {
-         cerr << "Corpus file could not be opened." << endl;
+         cerr << "The index was saved with a window of " << index.getWordsBefore() << "," << index.getWordsAfter() << "." << endl;
          exit( EXIT_FAILURE );
       }
       
-      while ( !fileReader.eof() )
+      //add the words of the text to the index instead of printing it, only the new text is read
+      if ( !appendFile.empty() )
       {
-         //read each string in the file
-         if  ( fileReader >> word)
+         CorpusReader appendReader;
+         if ( !appendReader.open( appendFile ) )
          {
-            //checks if word is a lone punctuation symbol
-            if ( bst::isPunct(word) )
-               continue;
-            else
-            {
-               //fill the context array at index = (wordCount + 5) with the current word
-               bst::fillContextArray( word, theContext, wordCount );
-               
-               //increment wordCount until 6 words have been added to context array
-               if ( wordCount < 6 )
-               {
-                  wordCount++;
-               }
-            }
+            cerr << "Corpus file could not be opened." << endl;
+            exit( EXIT_FAILURE );
          }
          
-         //once context array has been filled with 6 words
-         if ( wordCount >= 6 )
+         //the text leaves out the stop words the index was saved with, whatever stopwords.txt holds now
+         vector<string> indexStopWords;
+         index.getStopWords(indexStopWords);
+         DefaultHashConcordance stopWords;
+         stopWords.setStopWords(indexStopWords);
+         stats.startPhase("append");
+         if ( !index.append(appendReader.getContents(), stopWords) )
          {
-            //word at index 5 will be the key
-            string key = (theContext.at(5));
-            
-            //add key and current context array to binary search tree
-            concordance.add( key, theContext );
-            
-            //shift words 1 to left so new word can be added at last array index
-            bst::shiftArray(theContext);
+            cerr << "Index file could not be written." << endl;
+            exit( EXIT_FAILURE );
          }
+         stats.endPhase();
+         stats.setCounter("appended_bytes", (double)appendReader.getContents().length());
+         stats.setCounter("tokens", (double)index.getNumTokens());
+         stats.setCounter("index_segments", (double)index.getNumSegments());
+         reportStats();
+         return 0;
       }
       
-      fileReader.close();
-         
-      //get last 5 words or first 1-5 words in corpus if words in text file <= 5
-      for (string key = (theContext.at(5)); key != ""; bst::shiftArray(theContext), key = (theContext.at(5)))
+      uint64_t bytesWritten = 0;
+      stats.startPhase("output");
+      if ( index.isEmpty() )
+         cout << "No words found in corpus file!" << endl;
+      else if ( !queryKind.empty() )
+         bytesWritten = index.printMatches(query);
+      else
+         bytesWritten = index.printConcordance();
+      stats.endPhase();
+      stats.setCounter("tokens", (double)index.getNumTokens());
+      stats.setCounter("index_segments", (double)index.getNumSegments());
+      stats.setCounter("bytes_written", (double)bytesWritten);
+      reportStats();
+      return 0;
+   }
+   
+   //a corpus file is needed
+   if ( corpusPaths.empty() )
+   {
+      cerr << "Missing command line argument for corpus file." << endl;
+      exit ( EXIT_FAILURE );
+   }
+   
+   if ( engine != "tree" && engine != "hash" && engine != "trie" )
+   {
+      cerr << "Unknown engine " << engine << ", expected tree, hash or trie." << endl;
+      exit( EXIT_FAILURE );
+   }
+   
+   //the spilling engine keeps its keywords in a hash table, so no other engine can be asked for with a limit
+   if ( memoryLimit != 0 && engineGiven && engine != "hash" )
+   {
+      cerr << "The " << engine << " engine cannot be used with --mem-limit, only the hash engine spills." << endl;
+      exit( EXIT_FAILURE );
+   }
+   
+   //an index holds the positions of a single corpus
+   if ( batchMode && !saveIndexFile.empty() )
+   {
+      cerr << "An index cannot be saved with --batch." << endl;
+      exit( EXIT_FAILURE );
+   }
+   
+   //the concordance to add words and their contexts to, the only place the window is looked at
+   //everything the concordance does per word is compiled for its window
+   Concordance* concordance = nullptr;
+#define NEW_CONCORDANCE(BEFORE, AFTER) \
+   if ( wordsBefore == BEFORE && wordsAfter == AFTER ) \
+      concordance = newConcordance<BEFORE, AFTER>(engine, memoryLimit, spillDirectory);
+   FOR_EACH_WINDOW(NEW_CONCORDANCE)
+#undef NEW_CONCORDANCE
+   
+   //if stopwords.txt is found, exclude stop words from concordance
+   //otherwise exclude the built-in stop words if they were asked for
+   stats.startPhase("load_stop_words");
+   concordance->excludeStopWords(STOP_WORD_FILE, builtInStopWords);
+   stats.endPhase();
+   
+   stats.setLabel("engine", memoryLimit != 0 ? "spill" : engine);
+   stats.setCounter("threads", numThreads);
+   stats.setCounter("words_before", wordsBefore);
+   stats.setCounter("words_after", wordsAfter);
+   
+   //read every document into the one concordance, numbering them in the order they are listed
+   if ( batchMode )
+   {
+      vector<string> documents;
+      string unreadable;
+      stats.startPhase("list_documents");
+      if ( !BatchIngester::listDocuments(corpusPaths, documents, unreadable) )
       {
-         concordance.add( key, theContext );
+         cerr << "Directory " << unreadable << " could not be read." << endl;
+         exit( EXIT_FAILURE );
       }
+      stats.endPhase();
+      stats.setCounter("documents", (double)documents.size());
       
+      if ( statsWanted )
+         concordance->setStats(&stats);
+      stats.startPhase("ingest");
       
-      if ( concordance.isEmpty() )
-         cout << "No words found in corpus file!" << endl;
-      else
-         concordance.printConcordance();
-         
+      //each thread reads whole documents into a partial concordance, merged in document order
+      //a memory limit reads the documents on this thread, since the partial concordances would not be bounded
+      if ( !concordance->addDocuments(documents, memoryLimit == 0 ? numThreads : 1, unreadable) )
+      {
+         cerr << "Corpus file " << unreadable << " could not be opened." << endl;
+         exit( EXIT_FAILURE );
+      }
+      stats.endPhase();
+      concordance->setStats(nullptr);
+   }
+   else
+   {
+      //map the corpus file entered on the command line into memory
+      CorpusReader reader;
+
+      //if the reader could not open the file
+      stats.startPhase("open_corpus");
+      if ( !reader.open( corpusPaths[0] ) )
+      {
+         cerr << "Corpus file could not be opened." << endl;
+         exit( EXIT_FAILURE );
+      }
+      stats.endPhase();
+      stats.setCounter("corpus_bytes", (double)reader.getContents().length());
+      
+      //save the index of the corpus instead of printing its concordance
+      if ( !saveIndexFile.empty() )
+      {
+         stats.startPhase("build_index");
+         if ( !ConcordanceIndex::build(reader.getContents(), *concordance, saveIndexFile) )
+         {
+            cerr << "Index file could not be written." << endl;
+            exit( EXIT_FAILURE );
+         }
+         stats.endPhase();
+         delete concordance;
+         reportStats();
+         return 0;
+      }
+      
+      //the stages of adding the keywords are sampled on this thread, the partial concordances of the threads are not
+      if ( statsWanted )
+         concordance->setStats(&stats);
+      stats.startPhase("ingest");
+      
+      //split the corpus between the threads, each builds a partial concordance that is merged in corpus order
+      //a memory limit reads the corpus on this thread, since the partial concordances would not be bounded
+      concordance->addCorpus(reader, memoryLimit == 0 ? numThreads : 1);
+      
+      reader.close();
+      stats.endPhase();
+      concordance->setStats(nullptr);
    }
    
+   uint64_t bytesWritten = 0;
+   stats.startPhase("output");
+   if ( concordance->isEmpty() )
+      cout << "No words found in corpus file!" << endl;
+   else if ( !queryKind.empty() )
+      bytesWritten = concordance->printMatches(query);
+   else
+      bytesWritten = concordance->printConcordance(numThreads);
+   stats.endPhase();
+   
+   concordance->collectStats(stats);
+   stats.setCounter("bytes_written", (double)bytesWritten);
+   reportStats();
+   
+   delete concordance;
+   
    return 0;
 
 }
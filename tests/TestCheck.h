@@ -0,0 +1,63 @@
+/*
+file name: TestCheck.h
+author: Hall, Ashley
+date: 2026-Oct-16
+description: The checks shared by the tests. Each test is an executable of its own, registered with ctest, that runs its checks and returns nonzero if any of them failed. A failed CHECK prints the condition with its file and line, and the test carries on, so one run reports every failure.
+*/
+
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+#include <cstdio>
+
+//checks a condition, recording a failure if it does not hold
+#define CHECK(condition) TestCheck::check((condition), #condition, __FILE__, __LINE__)
+
+namespace TestCheck
+{
+   /**Returns the number of checks that failed so far.
+   @return The number of failures.
+   @pre none
+   @post The number of failures will be returned as a reference, so check can count them. */
+   inline int& failures()
+   {
+      static int numFailures = 0;
+      return numFailures;
+   }
+   
+   /**Records a failure if a condition does not hold.
+   @param holds The result of the condition.
+   @param condition The text of the condition.
+   @param file The file the check is in.
+   @param line The line the check is on.
+   @return True if the condition holds, false otherwise.
+   @pre none
+   @post A failed condition will be printed to standard error and counted. */
+   inline bool check(bool holds, const char* condition, const char* file, int line)
+   {
+      if ( !holds )
+      {
+         fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+         failures()++;
+      }
+      return holds;
+   }
+   
+   /**Reports the result of a test.
+   @param name The name of the test.
+   @return The exit status of the test, 0 if every check held and 1 otherwise.
+   @pre none
+   @post The number of failures will be printed if there were any. */
+   inline int finish(const char* name)
+   {
+      if ( failures() != 0 )
+      {
+         fprintf(stderr, "%s: %d checks failed\n", name, failures());
+         return 1;
+      }
+      printf("%s: all checks passed\n", name);
+      return 0;
+   }
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*
+file name: alloc_count_test.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: Tests that adding a keyword the concordance already holds allocates nothing but NodeArena blocks. The global operator new and operator new[] are replaced with counting versions. The words of the corpus are appended to the word stream and each keyword added once before counting starts, so only the adds of existing keys are counted. The NodeArena is the only code that allocates with new[], so a scalar allocation is allowed only where a new block may have grown the arena's list of blocks. This is checked for the tree, hash and trie engines.
+*/
+
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "BinarySearchTree.h"
+#include "BurstTrie.h"
+#include "HashConcordance.h"
+#include "TestCheck.h"
+
+using namespace std;
+
+static bool counting = false; //true while allocations are counted
+static size_t numAllocations = 0; //allocations with operator new while counting
+static size_t numBlockAllocations = 0; //allocations with operator new[] while counting, the NodeArena's blocks
+
+/**Allocates memory, counting the allocation if counting is on.
+@param bytes The number of bytes needed.
+@param count The counter to add the allocation to.
+@return The memory allocated. */
+static void* countedAllocate(size_t bytes, size_t& count)
+{
+   if ( counting )
+      count++;
+   void* memory = malloc(bytes == 0 ? 1 : bytes);
+   if ( memory == nullptr )
+      throw bad_alloc();
+   return memory;
+}
+
+void* operator new(size_t bytes)
+{
+   return countedAllocate(bytes, numAllocations);
+}
+
+void* operator new[](size_t bytes)
+{
+   return countedAllocate(bytes, numBlockAllocations);
+}
+
+void operator delete(void* memory) noexcept
+{
+   free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+   free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+   free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+   free(memory);
+}
+
+/**Checks that adding existing keys to a concordance allocates nothing but arena blocks.
+@param concordance The empty concordance.
+@param name The name of the engine, printed with the counts. */
+template <int BEFORE, int AFTER>
+static void checkEngine(WindowedConcordance<BEFORE, AFTER>& concordance, const char* name)
+{
+   //distinct words of 1 to 20 letters, the longest first so the cleaned key never has to grow
+   mt19937_64 random(3);
+   vector<string> words;
+   for (size_t w = 0; w < 500; w++)
+   {
+      string word(20 - w % 20, 'a');
+      for (size_t i = 0; i < word.length(); i++)
+         word[i] = (char)('a' + random() % 26);
+      word += to_string(w);
+      words.push_back(word);
+   }
+   
+   //each word once, then 200,000 words drawn from them, all in the word stream before any is added
+   vector<uint64_t> positions;
+   concordance.startText();
+   for (size_t w = 0; w < words.size(); w++)
+      positions.push_back(concordance.appendWord(words[w]));
+   for (size_t t = 0; t < 200000; t++)
+      positions.push_back(concordance.appendWord(words[random() % words.size()]));
+   concordance.endText();
+   
+   for (size_t p = 0; p < words.size(); p++)
+      concordance.add(positions[p]);
+   
+   counting = true;
+   numAllocations = 0;
+   numBlockAllocations = 0;
+   for (size_t p = words.size(); p < positions.size(); p++)
+      concordance.add(positions[p]);
+   counting = false;
+   
+   printf("%s: %zu allocations, %zu arena blocks\n", name, numAllocations, numBlockAllocations);
+   CHECK(numAllocations <= numBlockAllocations);
+}
+
+int main()
+{
+   BinarySearchTree<5, 5> tree;
+   checkEngine(tree, "tree");
+   HashConcordance<5, 5> hash;
+   checkEngine(hash, "hash");
+   BurstTrie<5, 5> trie;
+   checkEngine(trie, "trie");
+   
+   return TestCheck::finish("alloc_count_test");
+}
@@ -0,0 +1,159 @@
+/*
+file name: context_list_test.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: Tests for the ContextList. The positions are stored as varint gaps in blocks that double in size, so the lists are filled with gaps of every varint length, from a byte to the full 10 bytes of a 64 bit gap, and long enough to span many blocks. Each list must read back through a Reader exactly as it was added, after a copy, after skipping, and after being spliced onto another list with a shift, with its blocks created with new or in a NodeArena.
+*/
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "ContextList.h"
+#include "NodeArena.h"
+#include "TestCheck.h"
+
+using namespace std;
+
+/**Makes increasing positions with gaps of every varint length.
+@param count The number of positions.
+@param seed The seed of the random number generator.
+@return The positions, in increasing order. */
+static vector<uint64_t> makePositions(size_t count, uint64_t seed)
+{
+   mt19937_64 random(seed);
+   vector<uint64_t> positions;
+   uint64_t position = random() % 16;
+   for (size_t p = 0; p < count; p++)
+   {
+      positions.push_back(position);
+      
+      //mostly short gaps, as in text, with now and then one of up to 56 bits
+      int bits = random() % 8 == 0 ? 1 + (int)(random() % 56) : 1 + (int)(random() % 10);
+      position += 1 + (random() & ((uint64_t(1) << bits) - 1));
+   }
+   return positions;
+}
+
+/**Reads every position of a list.
+@param list The list to read.
+@return The positions, in the order read. */
+static vector<uint64_t> readAll(const ContextList& list)
+{
+   vector<uint64_t> positions;
+   ContextList::Reader reader(list);
+   uint64_t position;
+   while ( reader.next(position) )
+      positions.push_back(position);
+   return positions;
+}
+
+/**Fills a list with positions.
+@param list The list to fill.
+@param positions The positions, in increasing order. */
+static void addAll(ContextList& list, const vector<uint64_t>& positions)
+{
+   for (size_t p = 0; p < positions.size(); p++)
+      list.add(positions[p]);
+}
+
+int main()
+{
+   //an empty list reads nothing
+   ContextList empty;
+   CHECK(empty.size() == 0);
+   CHECK(readAll(empty).empty());
+   uint64_t position;
+   ContextList::Reader pastEnd;
+   CHECK(!pastEnd.next(position));
+   
+   //the largest gap takes the full 10 bytes of a varint
+   ContextList extremes;
+   vector<uint64_t> extremePositions = { 0, 1, UINT64_MAX - 1, UINT64_MAX };
+   addAll(extremes, extremePositions);
+   CHECK(readAll(extremes) == extremePositions);
+   
+   for (int useArena = 0; useArena <= 1; useArena++)
+   {
+      NodeArena arena;
+      NodeArena* nodeArena = useArena ? &arena : nullptr;
+      
+      //lists from a single position to many blocks read back as they were added
+      size_t counts[] = { 1, 2, 7, 100, 5000 };
+      for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+      {
+         vector<uint64_t> positions = makePositions(counts[c], counts[c]);
+         ContextList list(nodeArena);
+         addAll(list, positions);
+         CHECK(list.size() == positions.size());
+         CHECK(readAll(list) == positions);
+         
+         //a copy holds its own blocks
+         ContextList copy(list);
+         list.clear();
+         CHECK(list.size() == 0);
+         CHECK(readAll(copy) == positions);
+         
+         //skipping lands on the same position as reading, within a block and across whole blocks
+         size_t skips[] = { 0, 1, counts[c] / 3, counts[c] - 1 };
+         for (size_t s = 0; s < sizeof(skips) / sizeof(skips[0]); s++)
+         {
+            if ( skips[s] >= counts[c] )
+               continue;
+            ContextList::Reader reader(copy);
+            reader.skip(skips[s]);
+            CHECK(reader.next(position) && position == positions[skips[s]]);
+         }
+         ContextList::Reader reader(copy);
+         reader.skip(counts[c]);
+         CHECK(!reader.next(position));
+      }
+      
+      //a spliced list follows the other's positions, moved by the shift, and leaves the other empty
+      vector<uint64_t> front = makePositions(3000, 1);
+      vector<uint64_t> back = makePositions(3000, 2);
+      int64_t shift = (int64_t)(front.back() + 1) - (int64_t)back.front() + 5;
+      ContextList frontList(nodeArena);
+      ContextList backList(nodeArena);
+      addAll(frontList, front);
+      addAll(backList, back);
+      frontList.splice(backList, shift);
+      vector<uint64_t> expected = front;
+      for (size_t p = 0; p < back.size(); p++)
+         expected.push_back(back[p] + shift);
+      CHECK(frontList.size() == expected.size());
+      CHECK(readAll(frontList) == expected);
+      CHECK(backList.size() == 0);
+      CHECK(readAll(backList).empty());
+      
+      //a list can still grow after a splice, from the last position spliced
+      frontList.add(expected.back() + 1);
+      expected.push_back(expected.back() + 1);
+      CHECK(readAll(frontList) == expected);
+      
+      //splicing onto an empty list, or an empty list onto another, moves only what is there
+      ContextList target(nodeArena);
+      ContextList source(nodeArena);
+      addAll(source, back);
+      target.splice(source, 0);
+      CHECK(readAll(target) == back);
+      ContextList none(nodeArena);
+      target.splice(none, 100);
+      CHECK(readAll(target) == back);
+      
+      //addAll copies the positions and leaves the other list as it was
+      ContextList joined(nodeArena);
+      ContextList tail(nodeArena);
+      vector<uint64_t> shifted;
+      for (size_t p = 0; p < back.size(); p++)
+         shifted.push_back(back[p] + front.back() + 1);
+      addAll(joined, front);
+      addAll(tail, shifted);
+      joined.addAll(tail);
+      vector<uint64_t> both = front;
+      both.insert(both.end(), shifted.begin(), shifted.end());
+      CHECK(readAll(joined) == both);
+      CHECK(readAll(tail) == shifted);
+   }
+   
+   return TestCheck::finish("context_list_test");
+}
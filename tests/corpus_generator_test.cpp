@@ -0,0 +1,80 @@
+/*
+file name: corpus_generator_test.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: Tests for the CorpusGenerator the benchmarks are run on. The same options must always give the same corpus, so runs of the benchmarks can be compared, and the corpus must hold the number of words asked for, drawn in the order asked for.
+*/
+
+#include <cctype>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CorpusGenerator.h"
+#include "TestCheck.h"
+
+using namespace std;
+
+/**Splits a corpus into its words.
+@param corpus The text of the corpus.
+@return The words, in order. */
+static vector<string> splitWords(const string& corpus)
+{
+   vector<string> words;
+   istringstream stream(corpus);
+   string word;
+   while ( stream >> word )
+      words.push_back(word);
+   return words;
+}
+
+int main()
+{
+   CorpusGenerator::Options options;
+   options.numTokens = 20000;
+   options.vocabularySize = 500;
+   
+   //the same options give the same corpus, another seed a different one
+   string first;
+   string second;
+   CorpusGenerator(options).generate(first);
+   CorpusGenerator(options).generate(second);
+   CHECK(first == second);
+   options.seed = 2;
+   CorpusGenerator(options).generate(second);
+   CHECK(first != second);
+   
+   //every token is a word, lone punctuation symbols included
+   CHECK(splitWords(first).size() == options.numTokens);
+   
+   //the vocabulary holds distinct lowercase words
+   CorpusGenerator generator(options);
+   const vector<string>& vocabulary = generator.getVocabulary();
+   CHECK(vocabulary.size() == options.vocabularySize);
+   bool lowercase = true;
+   for (size_t w = 0; w < vocabulary.size(); w++)
+      lowercase = lowercase && vocabulary[w].find_first_not_of("abcdefghijklmnopqrstuvwxyz") == string::npos;
+   CHECK(lowercase);
+   
+   //with no stop words or punctuation, the sorted order draws the vocabulary in alphabetical order
+   options.order = CorpusGenerator::SORTED;
+   options.stopWordRatio = 0;
+   options.punctRatio = 0;
+   options.numTokens = 1000;
+   string sorted;
+   CorpusGenerator(options).generate(sorted);
+   vector<string> words = splitWords(sorted);
+   CHECK(words.size() == options.numTokens);
+   bool ascending = true;
+   for (size_t w = 1; w < options.vocabularySize && w < words.size(); w++)
+   {
+      //about one word in 10 is capitalized, which does not change its place in the order
+      string previous = words[w - 1];
+      string current = words[w];
+      previous[0] = (char)tolower((unsigned char)previous[0]);
+      current[0] = (char)tolower((unsigned char)current[0]);
+      ascending = ascending && previous < current;
+   }
+   CHECK(ascending);
+   
+   return TestCheck::finish("corpus_generator_test");
+}
@@ -0,0 +1,192 @@
+/*
+file name: engine_test.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: Tests that every concordance engine writes the same rows as the BinarySearchTree. Each engine is built from the same generated corpus, with a few UTF-8 words added so keywords with bytes of 0x80 and above are sorted too, and its whole concordance and the rows of exact, prefix and range queries are written to a temporary file and compared byte for byte with the tree's. The hash and trie engines are also built on several threads, which splits the corpus into chunks that are merged afterwards, and the concordances are built for more than one window. The RowCursor of every engine must give the rows, keywords included, that the TreeIterator of the tree gives.
+*/
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BinarySearchTree.h"
+#include "BurstTrie.h"
+#include "CorpusGenerator.h"
+#include "CorpusReader.h"
+#include "HashConcordance.h"
+#include "KeyQuery.h"
+#include "OutputWriter.h"
+#include "TestCheck.h"
+#include "TreeIterator.h"
+
+using namespace std;
+
+/**Writes rows to a temporary file and reads them back.
+@param concordance The concordance whose rows are written.
+@param query The keywords whose rows are written, or nullptr for the whole concordance.
+@return The bytes written. */
+static string writeToString(const Concordance& concordance, const KeyQuery* query)
+{
+   FILE* file = tmpfile();
+   if ( file == nullptr )
+      return "no temporary file";
+   {
+      OutputWriter writer(fileno(file));
+      if ( query == nullptr )
+         concordance.writeConcordance(writer);
+      else
+         concordance.writeMatches(writer, *query);
+      writer.flush();
+   }
+   
+   string text;
+   char buffer[1 << 16];
+   rewind(file);
+   size_t bytes;
+   while ( (bytes = fread(buffer, 1, sizeof(buffer), file)) > 0 )
+      text.append(buffer, bytes);
+   fclose(file);
+   return text;
+}
+
+/**Builds a concordance of a corpus.
+@param concordance The empty concordance to build.
+@param corpus The text of the corpus.
+@param threads The number of threads to read the corpus on.
+@return The concordance, built with the built-in stop words excluded. */
+static Concordance& build(Concordance& concordance, const string& corpus, int threads)
+{
+   //no file of stop words, so the built-in list is used
+   concordance.excludeStopWords("", true);
+   CorpusReader reader;
+   reader.openText(corpus);
+   concordance.addCorpus(reader, threads);
+   return concordance;
+}
+
+//a row read from a cursor, with a copy of its keyword, which the cursor may only hold until it moves
+template <int BEFORE, int AFTER>
+struct ReadRow
+{
+   string keyWord; //the keyword of the row
+   typename ListNode<BEFORE, AFTER>::contextArr context; //the context of the row
+   uint32_t document; //the document of the row
+};
+
+/**Reads every row of a cursor.
+@param cursor The cursor, at its first row.
+@return The keyword, context and document of each row, in order. */
+template <int BEFORE, int AFTER>
+static vector<ReadRow<BEFORE, AFTER>> readRows(RowCursor<BEFORE, AFTER> cursor)
+{
+   vector<ReadRow<BEFORE, AFTER>> rows;
+   for ( ; !cursor.atEnd(); ++cursor)
+      rows.push_back(ReadRow<BEFORE, AFTER>{string(cursor->keyWord), cursor->context, cursor->document});
+   return rows;
+}
+
+/**Tests whether the rows of a cursor are the rows of a TreeIterator.
+@param rows The rows read from the cursor.
+@param tree The tree the TreeIterator walks.
+@param query The keywords the iterator visits, or nullptr for every keyword.
+@return True if the keywords, contexts and documents of the rows are the same, false otherwise. */
+template <int BEFORE, int AFTER>
+static bool sameRows(const vector<ReadRow<BEFORE, AFTER>>& rows, const BinarySearchTree<BEFORE, AFTER>& tree, const KeyQuery* query)
+{
+   size_t r = 0;
+   for (TreeIterator<BEFORE, AFTER> it = query == nullptr ? tree.begin() : tree.beginMatches(*query); it != tree.end(); ++it, r++)
+   {
+      if ( r == rows.size() || rows[r].keyWord != it->keyWord || rows[r].context != it->context || rows[r].document != it->document )
+         return false;
+   }
+   return r == rows.size();
+}
+
+/**Checks that every engine for a window writes the same rows as the BinarySearchTree.
+@param corpus The text of the corpus.
+@param queries The queries whose rows are compared. */
+template <int BEFORE, int AFTER>
+static void checkWindow(const string& corpus, const vector<KeyQuery>& queries)
+{
+   BinarySearchTree<BEFORE, AFTER> tree;
+   build(tree, corpus, 1);
+   string expected = writeToString(tree, nullptr);
+   CHECK(!expected.empty());
+   
+   vector<unique_ptr<Concordance>> engines;
+   int threads[] = { 1, 3 };
+   for (int t = 0; t < 2; t++)
+   {
+      engines.push_back(unique_ptr<Concordance>(new HashConcordance<BEFORE, AFTER>()));
+      build(*engines.back(), corpus, threads[t]);
+      engines.push_back(unique_ptr<Concordance>(new BurstTrie<BEFORE, AFTER>()));
+      build(*engines.back(), corpus, threads[t]);
+   }
+   
+   for (size_t e = 0; e < engines.size(); e++)
+   {
+      CHECK(writeToString(*engines[e], nullptr) == expected);
+      for (size_t q = 0; q < queries.size(); q++)
+         CHECK(writeToString(*engines[e], &queries[q]) == writeToString(tree, &queries[q]));
+   }
+   
+   //the row cursor of every engine, the tree's included, gives the rows of the tree's own iterator
+   engines.push_back(unique_ptr<Concordance>(new BinarySearchTree<BEFORE, AFTER>()));
+   build(*engines.back(), corpus, 1);
+   for (size_t e = 0; e < engines.size(); e++)
+   {
+      const WindowedConcordance<BEFORE, AFTER>& engine = dynamic_cast<const WindowedConcordance<BEFORE, AFTER>&>(*engines[e]);
+      CHECK(sameRows(readRows(engine.rowCursor()), tree, nullptr));
+      for (size_t q = 0; q < queries.size(); q++)
+         CHECK(sameRows(readRows(engine.matchingRowCursor(queries[q])), tree, &queries[q]));
+   }
+   
+   //a cursor copied part of the way along carries on from the same row, with a keyword of its own
+   typedef RowCursor<BEFORE, AFTER> Cursor;
+   for (size_t e = 0; e < engines.size(); e++)
+   {
+      const WindowedConcordance<BEFORE, AFTER>& engine = dynamic_cast<const WindowedConcordance<BEFORE, AFTER>&>(*engines[e]);
+      Cursor cursor = engine.rowCursor();
+      for (int r = 0; r < 1000; r++)
+         ++cursor;
+      Cursor copy = cursor;
+      CHECK(copy == cursor);
+      CHECK(copy++ == cursor && copy != cursor && copy == ++cursor);
+      string keyWord(copy->keyWord);
+      cursor.nextKey();
+      CHECK(cursor != copy && cursor->keyWord > keyWord && copy->keyWord == keyWord);
+   }
+   CHECK(Cursor() == Cursor());
+}
+
+int main()
+{
+   //large enough that three threads split it into several chunks
+   CorpusGenerator::Options options;
+   options.numTokens = 400000;
+   options.vocabularySize = 5000;
+   string corpus;
+   CorpusGenerator generator(options);
+   generator.generate(corpus);
+   corpus += "Élan élan über Über straße café CAFÉ naïve «quoted» ωmega dash—word zz\n";
+   
+   const vector<string>& vocabulary = generator.getVocabulary();
+   vector<KeyQuery> queries = {
+      KeyQuery::exact(vocabulary[0]),
+      KeyQuery::exact(vocabulary[vocabulary.size() - 1]),
+      KeyQuery::exact("notaword"),
+      KeyQuery::exact("élan"),
+      KeyQuery::prefix("b"),
+      KeyQuery::prefix(vocabulary[1].substr(0, 2)),
+      KeyQuery::prefix("zz"),
+      KeyQuery::prefix("é"),
+      KeyQuery::range("c", "e"),
+      KeyQuery::range("y", "\xff"),
+      KeyQuery::range("q", "a"),
+   };
+   
+   checkWindow<5, 5>(corpus, queries);
+   checkWindow<3, 3>(corpus, queries);
+   
+   return TestCheck::finish("engine_test");
+}
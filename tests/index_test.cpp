@@ -0,0 +1,102 @@
+/*
+file name: index_test.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: Tests that a damaged index file is refused or read safely, never read out of bounds. An index of two segments is saved from a generated corpus, then every byte of it in turn is flipped and the file opened again. A file that still opens must print its whole concordance and the rows of a query without crashing, and a file damaged where the header, an offset or a word ID is checked must be refused. The test fails by crashing, or under a sanitizer, if a check is missing.
+*/
+
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include "BinarySearchTree.h"
+#include "ConcordanceIndex.h"
+#include "CorpusGenerator.h"
+#include "KeyQuery.h"
+#include "OutputWriter.h"
+#include "TestCheck.h"
+
+using namespace std;
+
+/**Reads a whole file.
+@param fileName The name of the file.
+@return The bytes of the file. */
+static string readFile(const string& fileName)
+{
+   ifstream in(fileName, ios::binary);
+   return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+/**Replaces a file with the given bytes.
+@param fileName The name of the file.
+@param bytes The bytes to write. */
+static void writeFile(const string& fileName, const string& bytes)
+{
+   ofstream out(fileName, ios::binary | ios::trunc);
+   out.write(bytes.data(), (streamsize)bytes.size());
+}
+
+int main()
+{
+   CorpusGenerator::Options options;
+   options.numTokens = 600;
+   options.vocabularySize = 150;
+   string corpus;
+   CorpusGenerator generator(options);
+   generator.generate(corpus);
+   string appended = corpus.substr(0, corpus.size() / 3);
+
+   //an index of two segments, so the checks of an appended segment run too
+   BinarySearchTree<5, 5> concordance;
+   concordance.excludeStopWords("", true);
+   string fileName = "index_test_" + to_string(getpid()) + ".idx";
+   CHECK(ConcordanceIndex::build(corpus, concordance, fileName));
+   ConcordanceIndex index;
+   CHECK(index.open(fileName));
+   CHECK(index.append(appended, concordance));
+   CHECK(index.getNumSegments() == 2);
+   index.close();
+   string original = readFile(fileName);
+   CHECK(original.size() > 0);
+
+   //the rows are only read, not compared, so they are thrown away
+   int devNull = open("/dev/null", O_WRONLY);
+   OutputWriter writer(devNull);
+   KeyQuery query = KeyQuery::prefix("b");
+   size_t numRefused = 0;
+   for (size_t b = 0; b < original.size(); b++)
+   {
+      string damaged(original);
+      damaged[b] = (char)(damaged[b] ^ 0xff);
+      writeFile(fileName, damaged);
+
+      //what opens must print without reading outside the file
+      if ( index.open(fileName) )
+      {
+         index.writeConcordance(writer);
+         index.writeMatches(writer, query);
+         index.close();
+      }
+      else
+         numRefused++;
+   }
+
+   //the header fields, offsets and word IDs alone make up a good share of the file
+   CHECK(numRefused > original.size() / 4);
+
+   //a file cut short is refused
+   writeFile(fileName, original.substr(0, original.size() - 8));
+   CHECK(!index.open(fileName));
+
+   //the undamaged file still opens
+   writeFile(fileName, original);
+   CHECK(index.open(fileName));
+   index.close();
+
+   writer.flush();
+   close(devNull);
+   remove(fileName.c_str());
+   return TestCheck::finish("index_test");
+}
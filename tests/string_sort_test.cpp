@@ -0,0 +1,106 @@
+/*
+file name: string_sort_test.cpp
+author: Hall, Ashley
+date: 2026-Oct-16
+description: Tests for the StringSort. The multikey quicksort must give the order of operator< on strings that std::sort gives, so each set of keys is sorted both ways and the strings compared. The sets cover the cases a byte-at-a-time sort can get wrong: bytes of 0x80 and above, which must compare as unsigned, keys that are prefixes of others and the empty key, long shared prefixes, duplicates, and runs both shorter and longer than INSERTION_KEYS. The index of each key must still lead back to its string.
+*/
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "StringSort.h"
+#include "TestCheck.h"
+
+using namespace std;
+
+/**Sorts strings with the StringSort and checks the order against std::sort.
+@param strings The strings to sort.
+@return True if the orders match and every index leads back to its string, false otherwise. */
+static bool sortsLikeStd(const vector<string>& strings)
+{
+   vector<StringSort::Key> keys;
+   for (size_t s = 0; s < strings.size(); s++)
+      keys.push_back(StringSort::makeKey(strings[s], s));
+   StringSort::sort(keys);
+   
+   vector<string> expected = strings;
+   sort(expected.begin(), expected.end());
+   
+   if ( keys.size() != expected.size() )
+      return false;
+   for (size_t k = 0; k < keys.size(); k++)
+   {
+      if ( string(keys[k].data, keys[k].length) != expected[k] || strings[keys[k].index] != expected[k] )
+         return false;
+   }
+   return true;
+}
+
+/**Makes random strings over an alphabet.
+@param count The number of strings.
+@param maxLength The length of the longest string, 0 included.
+@param alphabet The bytes the strings are made of.
+@param random The random number generator.
+@return The strings. */
+static vector<string> makeStrings(size_t count, size_t maxLength, const string& alphabet, mt19937_64& random)
+{
+   vector<string> strings;
+   for (size_t s = 0; s < count; s++)
+   {
+      size_t length = (size_t)(random() % (maxLength + 1));
+      string str;
+      for (size_t i = 0; i < length; i++)
+         str.push_back(alphabet[random() % alphabet.size()]);
+      strings.push_back(str);
+   }
+   return strings;
+}
+
+int main()
+{
+   mt19937_64 random(7);
+   
+   //nothing, a single key, and the empty key
+   CHECK(sortsLikeStd({}));
+   CHECK(sortsLikeStd({ "word" }));
+   CHECK(sortsLikeStd({ "", "b", "", "a" }));
+   
+   //a key comes before every longer key it is a prefix of
+   CHECK(sortsLikeStd({ "abc", "ab", "abcd", "a", "", "abd", "ab", "b" }));
+   
+   //bytes of 0x80 and above compare as unsigned, after every ASCII byte
+   CHECK(sortsLikeStd({ "\xc3\xa9t\xc3\xa9", "ete", "\xff", "\x80", "z", "\x7f", "\xc3", "e\xcc\x81" }));
+   
+   //every byte value, in keys short and long, with runs above and below INSERTION_KEYS
+   string allBytes;
+   for (int b = 0; b < 256; b++)
+      allBytes.push_back((char)b);
+   size_t counts[] = { 5, StringSort::INSERTION_KEYS, StringSort::INSERTION_KEYS + 1, 1000, 20000 };
+   for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+   {
+      CHECK(sortsLikeStd(makeStrings(counts[c], 12, allBytes, random)));
+      
+      //a small alphabet gives many duplicates and shared prefixes
+      CHECK(sortsLikeStd(makeStrings(counts[c], 6, "ab\x80", random)));
+   }
+   
+   //keys that share a long prefix and differ only near the end
+   vector<string> prefixed = makeStrings(5000, 4, "xyz\xe2", random);
+   string prefix(300, 'p');
+   for (size_t s = 0; s < prefixed.size(); s++)
+      prefixed[s] = prefix + prefixed[s];
+   prefixed.push_back(prefix);
+   prefixed.push_back(prefix.substr(0, 299));
+   CHECK(sortsLikeStd(prefixed));
+   
+   //keys already in order, in reverse order, and all the same
+   vector<string> ordered = makeStrings(3000, 10, "abcdefghijklmnopqrstuvwxyz", random);
+   sort(ordered.begin(), ordered.end());
+   CHECK(sortsLikeStd(ordered));
+   reverse(ordered.begin(), ordered.end());
+   CHECK(sortsLikeStd(ordered));
+   CHECK(sortsLikeStd(vector<string>(500, "same")));
+   
+   return TestCheck::finish("string_sort_test");
+}
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+file name: gen_unicode_tables.py
+author: Hall, Ashley
+date: 2026-Oct-16
+description: Generates the PUNCT_RANGES and FOLD_RANGES tables of Unicode.cpp from the Unicode Character Database 14.0, as shipped in the unicodedata module of Python 3.11 (unicodedata.unidata_version 14.0.0). The script refuses to run with any other version, so the tables never change by accident.
+ PUNCT_RANGES holds the runs of code points from U+0080 on whose general category is Pc, Pd, Ps, Pe, Pi, Pf or Po.
+ FOLD_RANGES holds the simple case folding, status C and S of CaseFolding.txt, from U+0080 on. The module has no simple folding of its own, so it is taken as the folding of a code point when that is a single code point, and otherwise as its lowercase form when that is a single code point, which gives the C and S mappings and leaves out the code points with only F and T ones. A code point whose folding takes more bytes in UTF-8 than it does (U+023A and U+023E) is left out, so a cleaned word is never longer than the word. The foldings are packed into runs with the same delta, either of consecutive code points or of every other one.
+ The tables in Unicode.cpp were made with, from the repository root:
+ python3 tools/gen_unicode_tables.py Unicode.cpp
+ which replaces the two tables in place and leaves the rest of the file as it is.
+"""
+
+import sys
+import unicodedata
+
+UNIDATA_VERSION = "14.0.0"
+FIRST_CODE_POINT = 0x80 #ASCII keeps the rules of the C locale, set in Unicode.cpp itself
+LAST_CODE_POINT = 0x10FFFF
+PUNCT_CATEGORIES = {"Pc", "Pd", "Ps", "Pe", "Pi", "Pf", "Po"}
+
+#the generated part of Unicode.cpp starts at the comment of the first table and ends before this line
+TABLES_START = "//the punctuation categories of the Unicode Character Database"
+TABLES_END = "static constexpr size_t NUM_PUNCT_RANGES"
+
+
+def utf8_length(code_point):
+    """Returns the number of bytes of a code point in UTF-8."""
+    if code_point < 0x80:
+        return 1
+    if code_point < 0x800:
+        return 2
+    if code_point < 0x10000:
+        return 3
+    return 4
+
+
+def code_points():
+    """Yields every code point from FIRST_CODE_POINT on, surrogates excluded."""
+    for code_point in range(FIRST_CODE_POINT, LAST_CODE_POINT + 1):
+        if not 0xD800 <= code_point <= 0xDFFF:
+            yield code_point
+
+
+def punct_ranges():
+    """Returns the runs of punctuation code points as (first, last) pairs, sorted by first."""
+    ranges = []
+    for code_point in code_points():
+        if unicodedata.category(chr(code_point)) not in PUNCT_CATEGORIES:
+            continue
+        if ranges and ranges[-1][1] == code_point - 1:
+            ranges[-1][1] = code_point
+        else:
+            ranges.append([code_point, code_point])
+    return [tuple(r) for r in ranges]
+
+
+def simple_folding():
+    """Returns the simple case folding as a dictionary from code point to folded code point, for the code points that change."""
+    folding = {}
+    for code_point in code_points():
+        character = chr(code_point)
+        folded = character.casefold()
+        if len(folded) != 1:
+            folded = character.lower()
+            if len(folded) != 1:
+                continue
+        target = ord(folded)
+        if target == code_point or utf8_length(target) > utf8_length(code_point):
+            continue
+        folding[code_point] = target
+    return folding
+
+
+def fold_ranges(folding):
+    """Packs a folding into runs as (first, last, delta, stride) tuples, sorted by first.
+
+    A run takes every other code point when that covers more code points than taking consecutive ones, and the code points in between are not folded."""
+    ranges = []
+    covered = set()
+    for code_point in sorted(folding):
+        if code_point in covered:
+            continue
+        delta = folding[code_point] - code_point
+
+        def same(c):
+            return c in folding and folding[c] - c == delta and c not in covered
+
+        consecutive = 1
+        while same(code_point + consecutive):
+            consecutive += 1
+        alternate = 1
+        while same(code_point + 2 * alternate) and code_point + 2 * alternate - 1 not in folding:
+            alternate += 1
+
+        if alternate > consecutive and alternate >= 2:
+            last = code_point + 2 * (alternate - 1)
+            ranges.append((code_point, last, delta, 2))
+            covered.update(range(code_point, last + 1, 2))
+        else:
+            last = code_point + consecutive - 1
+            ranges.append((code_point, last, delta, 1))
+            covered.update(range(code_point, last + 1))
+
+    #the lookup in Unicode.cpp binary searches the runs, so they must not overlap
+    ranges.sort()
+    for before, after in zip(ranges, ranges[1:]):
+        assert before[1] < after[0], (before, after)
+    return ranges
+
+
+def tables_source():
+    """Returns the source of the two tables, as it appears in Unicode.cpp."""
+    version = UNIDATA_VERSION.rsplit(".", 1)[0]
+    punct = ",\n".join("   {0x%04X, 0x%04X}" % r for r in punct_ranges())
+    fold = ",\n".join("   {0x%04X, 0x%04X, %d, %d}" % r for r in fold_ranges(simple_folding()))
+    return (
+        "//the punctuation categories of the Unicode Character Database %s, from U+0080 on\n"
+        "static constexpr PunctRange PUNCT_RANGES[] =\n{\n%s\n};\n\n"
+        "//the simple case folding of the Unicode Character Database %s, status C and S of CaseFolding.txt, from U+0080 on\n"
+        "//U+023A and U+023E are left out, their lowercase forms take three bytes instead of two\n"
+        "static constexpr FoldRange FOLD_RANGES[] =\n{\n%s\n};\n\n"
+    ) % (version, punct, version, fold)
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write("usage: %s Unicode.cpp\n" % argv[0])
+        return 2
+    if unicodedata.unidata_version != UNIDATA_VERSION:
+        sys.stderr.write("the tables are made from Unicode %s, but this Python has Unicode %s\n" % (UNIDATA_VERSION, unicodedata.unidata_version))
+        return 1
+
+    with open(argv[1], encoding="utf-8") as source_file:
+        source = source_file.read()
+    start = source.find(TABLES_START)
+    end = source.find(TABLES_END, start)
+    if start < 0 or end < 0:
+        sys.stderr.write("%s has no tables to replace\n" % argv[1])
+        return 1
+
+    with open(argv[1], "w", encoding="utf-8") as source_file:
+        source_file.write(source[:start] + tables_source() + source[end:])
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))